@@ -0,0 +1,203 @@
+#include <stdlib.h>
+#include <string.h>
+#include "arena.h"
+
+// Regular blocks form a list that allocations fill in order; a reset starts
+// filling them again from the first. A large allocation has a block of its
+// own on a second list, which a reset frees, so one huge file does not pin
+// its memory for every file after it.
+typedef struct ArenaBlock {
+    struct ArenaBlock* next;
+    size_t size; // Bytes of data
+    size_t used;
+    _Alignas(ARENA_ALIGN) unsigned char data[];
+} ArenaBlock;
+
+struct Arena {
+    ArenaBlock* first;   // Regular blocks, in the order they are filled
+    ArenaBlock* current; // The one being filled
+    ArenaBlock* large;   // Blocks of one allocation each
+    size_t blockSize;
+};
+
+#define roundUp(n) (((n) + ARENA_ALIGN - 1) & ~(size_t)(ARENA_ALIGN - 1))
+
+static ArenaBlock* newBlock(size_t size)
+{
+    ArenaBlock* b = malloc(sizeof(ArenaBlock) + size);
+    if (b != NULL)
+    {
+        b->next = NULL;
+        b->size = size;
+        b->used = 0;
+    }
+    return b;
+}
+
+Arena* createArena(size_t blockSize)
+{
+    Arena* a = calloc(1, sizeof(Arena));
+    if (a == NULL)
+    {
+        return NULL;
+    }
+    a->blockSize = (blockSize > 0) ? roundUp(blockSize) : ARENA_BLOCK_SIZE;
+    return a;
+}
+
+static void freeBlocks(ArenaBlock* b)
+{
+    while (b != NULL)
+    {
+        ArenaBlock* next = b->next;
+        free(b);
+        b = next;
+    }
+}
+
+void destroyArena(Arena* a)
+{
+    if (a == NULL)
+    {
+        return;
+    }
+    freeBlocks(a->first);
+    freeBlocks(a->large);
+    free(a);
+}
+
+static void* largeAlloc(Arena* a, size_t size)
+{
+    ArenaBlock* b = newBlock(size);
+    if (b == NULL)
+    {
+        return NULL;
+    }
+    b->used = size;
+    b->next = a->large;
+    a->large = b;
+    return b->data;
+}
+
+// 'size' bytes (at most a quarter block) from the current block, moving on
+// to the next one, or a new one, when it is full
+static unsigned char* carve(Arena* a, size_t size, int aligned)
+{
+    ArenaBlock* b = a->current;
+    for (;;)
+    {
+        if (b != NULL)
+        {
+            size_t at = aligned ? roundUp(b->used) : b->used;
+            if (at <= b->size && b->size - at >= size)
+            {
+                b->used = at + size;
+                return b->data + at;
+            }
+        }
+        ArenaBlock* next = (b != NULL) ? b->next : a->first;
+        if (next == NULL)
+        {
+            next = newBlock(a->blockSize);
+            if (next == NULL)
+            {
+                return NULL;
+            }
+            if (b != NULL)
+            {
+                b->next = next;
+            }
+            else
+            {
+                a->first = next;
+            }
+        }
+        b = a->current = next;
+    }
+}
+
+void* arenaAlloc(Arena* a, size_t size)
+{
+    size = roundUp(size);
+    if (size > a->blockSize / 4)
+    {
+        return largeAlloc(a, size);
+    }
+    return carve(a, size, 1);
+}
+
+void* arenaGrow(Arena* a, void* p, size_t oldSize, size_t newSize)
+{
+    if (p == NULL)
+    {
+        return arenaAlloc(a, newSize);
+    }
+    if (newSize <= oldSize)
+    {
+        return p;
+    }
+    for (ArenaBlock** link = &a->large; *link != NULL; link = &(*link)->next)
+    {
+        if ((*link)->data == p)
+        {
+            ArenaBlock* b = realloc(*link, sizeof(ArenaBlock) + newSize);
+            if (b == NULL)
+            {
+                return NULL;
+            }
+            b->size = b->used = newSize;
+            *link = b;
+            return b->data;
+        }
+    }
+    // The latest allocation of the current block, and it still fits there
+    ArenaBlock* b = a->current;
+    size_t from = roundUp(oldSize), to = roundUp(newSize);
+    if (b != NULL && (unsigned char*)p + from == b->data + b->used && to <= a->blockSize / 4 && b->size - b->used >= to - from)
+    {
+        b->used += to - from;
+        return p;
+    }
+    void* q = arenaAlloc(a, newSize);
+    if (q != NULL)
+    {
+        memcpy(q, p, oldSize);
+    }
+    return q;
+}
+
+char* arenaCopyString(Arena* a, const char* str, size_t len)
+{
+    char* out = (len + 1 > a->blockSize / 4) ? largeAlloc(a, len + 1) : (char*)carve(a, len + 1, 0);
+    if (out != NULL)
+    {
+        memcpy(out, str, len);
+        out[len] = '\0';
+    }
+    return out;
+}
+
+void resetArena(Arena* a)
+{
+    freeBlocks(a->large);
+    a->large = NULL;
+    for (ArenaBlock* b = a->first; b != NULL; b = b->next)
+    {
+        b->used = 0;
+    }
+    a->current = a->first;
+}
+
+size_t arenaFootprint(const Arena* a)
+{
+    size_t bytes = 0;
+    for (const ArenaBlock* b = a->first; b != NULL; b = b->next)
+    {
+        bytes += b->size;
+    }
+    for (const ArenaBlock* b = a->large; b != NULL; b = b->next)
+    {
+        bytes += b->size;
+    }
+    return bytes;
+}
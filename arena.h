@@ -0,0 +1,37 @@
+#ifndef ARENA_H
+#define ARENA_H
+
+#include <stddef.h>
+
+// Bump allocator for storage that lives as long as one piece of work, such
+// as the lexing of one file. Allocations are carved out of large blocks and
+// never freed one by one: resetArena() drops them all at once and keeps the
+// blocks for the next file, so a worker lexing many files stops calling
+// malloc after the first few. Not thread-safe: one arena per thread.
+typedef struct Arena Arena;
+
+#define ARENA_BLOCK_SIZE (1024 * 1024) // Default block size
+#define ARENA_ALIGN 16                 // Alignment of arenaAlloc() results
+
+// NULL when out of memory. blockSize 0 means ARENA_BLOCK_SIZE.
+Arena* createArena(size_t blockSize);
+void destroyArena(Arena* arena);
+
+// 'size' bytes aligned to ARENA_ALIGN; NULL when out of memory. Requests of
+// more than a quarter block get a block of their own.
+void* arenaAlloc(Arena* arena, size_t size);
+// realloc() for an arena allocation p of oldSize bytes (NULL: none yet). It
+// grows in place when p is the latest allocation or has a block of its own,
+// else the bytes are copied and the old ones wait for the reset. NULL when
+// out of memory, p being left as it was.
+void* arenaGrow(Arena* arena, void* p, size_t oldSize, size_t newSize);
+// NUL-terminated copy of str[0..len), packed without alignment (for names)
+char* arenaCopyString(Arena* arena, const char* str, size_t len);
+
+// Drop every allocation. Regular blocks are kept for reuse, blocks of single
+// large allocations are freed.
+void resetArena(Arena* arena);
+// Bytes held in blocks, used or not
+size_t arenaFootprint(const Arena* arena);
+
+#endif
@@ -0,0 +1,768 @@
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include "headers.h"
+#include "interner.h"
+#include "lexer_internal.h"
+
+#define HEADER_BATCH_SIZE 4096 // Tokens taken from a header's lexer per call
+#define UNIT_BATCH_SIZE 4096   // Tokens of the main file fetched ahead
+
+enum { HEADER_NEW, HEADER_LOADING, HEADER_READY, HEADER_FAILED };
+
+typedef struct Header Header;
+
+// An #include directive of a header and the header it names (only those
+// that were found are kept)
+typedef struct {
+    size_t token;   // Index of the DIRECTIVE token
+    Header* header;
+} IncludeRef;
+
+struct Header {
+    uint32_t id;         // Of its real path in HeaderCache.names
+    int state;           // HEADER_*, under HeaderCache.lock
+    char* path;          // As it was found, for the output
+    LexerState* lx;      // Lexed to the end; keeps the text mapped
+    TokenBatch tokens;   // Every field filled
+    size_t count;
+    IncludeRef* includes;
+    size_t includeCount;
+    int once;            // Include guard or #pragma once: a repeat adds nothing
+    const char* problem; // Why it could not be loaded (see destroyHeaderCache)
+};
+
+struct HeaderCache {
+    pthread_mutex_t lock;
+    pthread_cond_t loaded;  // Some header stopped loading
+    Interner* names;        // Real paths; a header's id is its path's
+    Header** headers;       // Indexed by id
+    size_t capacity;
+    char** searchPaths;
+    size_t searchCount;
+    Interner* symbols;
+    long diagnosticLimit;
+    int dialect;            // -1: by extension
+    HeaderCacheStats stats; // Updated atomically
+};
+
+// A header being replayed into a translation unit
+typedef struct {
+    const Header* header;
+    size_t next;     // Next token
+    size_t include;  // Next of its includes
+} IncludeFrame;
+
+struct TranslationUnit {
+    HeaderCache* cache;
+    LexerState* lx;
+    const char* filename;
+    FILE* err;
+    DiagLog diags;          // Problems with the includes, printed at the end
+    TokenBatch buffer;      // Tokens of the main file, fetched ahead
+    size_t count, next;
+    IncludeFrame stack[INCLUDE_DEPTH_MAX];
+    int depth;
+    size_t origin;          // Offset of the main file's #include that the stack comes from
+    unsigned char* seen;    // Per header id: included into this unit already
+    size_t seenCount;
+};
+
+// --- Reading directives ---
+// A DIRECTIVE token is a whole line: '#', blanks, the directive's name and
+// whatever follows it.
+
+static int isWordChar(char c)
+{
+    return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c == '_';
+}
+
+static const char* skipBlanks(const char* p, const char* end)
+{
+    while (p < end && (*p == ' ' || *p == '\t'))
+    {
+        p++;
+    }
+    return p;
+}
+
+// Length of the word (identifier characters) at p
+static size_t wordLength(const char* p, const char* end)
+{
+    const char* q = p;
+    while (q < end && isWordChar(*q))
+    {
+        q++;
+    }
+    return (size_t)(q - p);
+}
+
+static int isWord(const char* p, size_t len, const char* word)
+{
+    return len == strlen(word) && memcmp(p, word, len) == 0;
+}
+
+// The name of a directive text[0..len): its length, and where what follows
+// it starts in *rest
+static size_t directiveName(const char* text, size_t len, const char** name, const char** rest)
+{
+    const char* end = text + len;
+    *name = skipBlanks(text + 1, end);
+    size_t n = wordLength(*name, end);
+    *rest = skipBlanks(*name + n, end);
+    return n;
+}
+
+// The header an #include directive names: its length, 0 if the directive
+// is not an #include of a "name" or a <name>
+static size_t includedName(const char* text, size_t len, const char** name, int* angled)
+{
+    const char* end = text + len;
+    const char* word;
+    const char* rest;
+    size_t n = directiveName(text, len, &word, &rest);
+    if (!isWord(word, n, "include") || rest == end || (*rest != '"' && *rest != '<'))
+    {
+        return 0;
+    }
+    char close = (*rest == '<') ? '>' : '"';
+    const char* stop = memchr(rest + 1, close, (size_t)(end - rest - 1));
+    if (stop == NULL || stop == rest + 1)
+    {
+        return 0;
+    }
+    *angled = (close == '>');
+    *name = rest + 1;
+    return (size_t)(stop - *name);
+}
+
+// The macro an #ifndef X or #if !defined X / !defined(X) tests, if 'text'
+// is one of those
+static size_t guardTested(const char* text, size_t len, const char** macro)
+{
+    const char* end = text + len;
+    const char* word;
+    const char* p;
+    size_t n = directiveName(text, len, &word, &p);
+    if (isWord(word, n, "if") && p < end && *p == '!')
+    {
+        p = skipBlanks(p + 1, end);
+        n = wordLength(p, end);
+        if (!isWord(p, n, "defined"))
+        {
+            return 0;
+        }
+        p = skipBlanks(p + n, end);
+        if (p < end && *p == '(')
+        {
+            p = skipBlanks(p + 1, end);
+        }
+    }
+    else if (!isWord(word, n, "ifndef"))
+    {
+        return 0;
+    }
+    *macro = p;
+    return wordLength(p, end);
+}
+
+// Whether every token of h is inside an include guard: it starts with
+// #ifndef X (or #if !defined X) and #define X, and the #endif closing the
+// first is its last token
+static int hasIncludeGuard(const Header* h)
+{
+    const TokenBatch* t = &h->tokens;
+    if (h->count < 3 || t->type[0] != DIRECTIVE || t->type[1] != DIRECTIVE)
+    {
+        return 0;
+    }
+    const char* macro;
+    size_t macroLen = guardTested(lexerTextAt(h->lx, t->start[0]), t->length[0], &macro);
+    const char* define = lexerTextAt(h->lx, t->start[1]);
+    const char* word;
+    const char* rest;
+    size_t n = directiveName(define, t->length[1], &word, &rest);
+    if (macroLen == 0 || !isWord(word, n, "define") ||
+        wordLength(rest, define + t->length[1]) != macroLen || memcmp(rest, macro, macroLen) != 0)
+    {
+        return 0;
+    }
+    int depth = 0;
+    for (size_t i = 0; i < h->count; i++)
+    {
+        if (t->type[i] != DIRECTIVE)
+        {
+            continue;
+        }
+        n = directiveName(lexerTextAt(h->lx, t->start[i]), t->length[i], &word, &rest);
+        if (isWord(word, n, "if") || isWord(word, n, "ifdef") || isWord(word, n, "ifndef"))
+        {
+            depth++;
+        }
+        else if (isWord(word, n, "endif") && --depth == 0)
+        {
+            return i == h->count - 1;
+        }
+    }
+    return 0;
+}
+
+static int hasPragmaOnce(const Header* h)
+{
+    const TokenBatch* t = &h->tokens;
+    for (size_t i = 0; i < h->count; i++)
+    {
+        if (t->type[i] != DIRECTIVE)
+        {
+            continue;
+        }
+        const char* text = lexerTextAt(h->lx, t->start[i]);
+        const char* word;
+        const char* rest;
+        size_t n = directiveName(text, t->length[i], &word, &rest);
+        if (isWord(word, n, "pragma") && isWord(rest, wordLength(rest, text + t->length[i]), "once"))
+        {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+// --- Finding headers ---
+
+// dir[0..dirLen) joined with name[0..len) if that is a regular file, else NULL
+static char* tryPath(const char* dir, size_t dirLen, const char* name, size_t len)
+{
+    int slash = (dirLen > 0 && dir[dirLen - 1] != '/');
+    char* path = malloc(dirLen + (size_t)slash + len + 1);
+    if (path == NULL)
+    {
+        return NULL;
+    }
+    memcpy(path, dir, dirLen);
+    if (slash)
+    {
+        path[dirLen] = '/';
+    }
+    memcpy(path + dirLen + slash, name, len);
+    path[dirLen + (size_t)slash + len] = '\0';
+    struct stat st;
+    if (stat(path, &st) == 0 && S_ISREG(st.st_mode))
+    {
+        return path;
+    }
+    free(path);
+    return NULL;
+}
+
+// The header of the file at 'path' (taken over), created on first sight. The
+// file's real path names it, so that every way of reaching it finds one header.
+static Header* headerAt(HeaderCache* cache, char* path)
+{
+    char* real = realpath(path, NULL);
+    const char* key = (real != NULL) ? real : path;
+    Header* h = NULL;
+    pthread_mutex_lock(&cache->lock);
+    uint32_t before = internerCount(cache->names);
+    uint32_t id = internString(cache->names, key, strlen(key));
+    if (id != NO_SYMBOL && id <= before)
+    {
+        // Not in 'headers' if growing it failed when the path was new
+        h = (id < cache->capacity) ? cache->headers[id] : NULL;
+    }
+    else if (id != NO_SYMBOL)
+    {
+        if (id >= cache->capacity)
+        {
+            size_t n = (cache->capacity > 0) ? cache->capacity * 2 : 64;
+            Header** grown = realloc(cache->headers, n * sizeof(Header*));
+            if (grown != NULL)
+            {
+                memset(grown + cache->capacity, 0, (n - cache->capacity) * sizeof(Header*));
+                cache->headers = grown;
+                cache->capacity = n;
+            }
+        }
+        if (id < cache->capacity && (h = calloc(1, sizeof(Header))) != NULL)
+        {
+            h->id = id;
+            h->path = path;
+            path = NULL;
+            cache->headers[id] = h;
+        }
+    }
+    pthread_mutex_unlock(&cache->lock);
+    free(real);
+    free(path);
+    return h;
+}
+
+// The header name[0..len) stands for in an #include of the file 'from':
+// an absolute path as it is, "name" next to 'from' and then on the search
+// paths, <name> on the search paths only. NULL if it is not found.
+static Header* findHeader(HeaderCache* cache, const char* from, const char* name, size_t len, int angled)
+{
+    char* path = NULL;
+    if (name[0] == '/')
+    {
+        path = tryPath("", 0, name, len);
+    }
+    else if (!angled)
+    {
+        const char* slash = strrchr(from, '/');
+        path = tryPath(from, (slash != NULL) ? (size_t)(slash - from) + 1 : 0, name, len);
+    }
+    for (size_t i = 0; path == NULL && name[0] != '/' && i < cache->searchCount; i++)
+    {
+        path = tryPath(cache->searchPaths[i], strlen(cache->searchPaths[i]), name, len);
+    }
+    return (path != NULL) ? headerAt(cache, path) : NULL;
+}
+
+// --- Lexing headers ---
+
+// Make room for 'need' tokens in every field of t; 0 when out of memory
+static int reserveTokens(TokenBatch* t, size_t need)
+{
+    if (need <= t->capacity)
+    {
+        return 1;
+    }
+    size_t n = (t->capacity > 0) ? t->capacity * 2 : HEADER_BATCH_SIZE;
+    while (n < need)
+    {
+        n *= 2;
+    }
+    void* p;
+    if ((p = realloc(t->type, n * sizeof(TokenType))) == NULL) return 0;
+    t->type = p;
+    if ((p = realloc(t->start, n * sizeof(size_t))) == NULL) return 0;
+    t->start = p;
+    if ((p = realloc(t->length, n * sizeof(size_t))) == NULL) return 0;
+    t->length = p;
+    if ((p = realloc(t->line, n * sizeof(int))) == NULL) return 0;
+    t->line = p;
+    if ((p = realloc(t->column, n * sizeof(int))) == NULL) return 0;
+    t->column = p;
+    if ((p = realloc(t->keyword, n * sizeof(KeywordId))) == NULL) return 0;
+    t->keyword = p;
+    if ((p = realloc(t->symbol, n * sizeof(uint32_t))) == NULL) return 0;
+    t->symbol = p;
+    t->capacity = n;
+    return 1;
+}
+
+static void freeTokens(TokenBatch* t)
+{
+    free(t->type);
+    free(t->start);
+    free(t->length);
+    free(t->line);
+    free(t->column);
+    free(t->keyword);
+    free(t->symbol);
+    memset(t, 0, sizeof(*t));
+}
+
+// Find the headers h includes. Those of a "name" that is not found are
+// reported in the diagnostics of h's lexer.
+static int findIncludes(HeaderCache* cache, Header* h)
+{
+    const TokenBatch* t = &h->tokens;
+    size_t capacity = 0;
+    for (size_t i = 0; i < h->count; i++)
+    {
+        const char* name;
+        int angled;
+        size_t len = (t->type[i] == DIRECTIVE) ? includedName(lexerTextAt(h->lx, t->start[i]), t->length[i], &name, &angled) : 0;
+        if (len == 0)
+        {
+            continue;
+        }
+        Header* found = findHeader(cache, h->path, name, len, angled);
+        if (found == NULL)
+        {
+            __atomic_fetch_add(&cache->stats.missing, 1, __ATOMIC_RELAXED);
+            if (!angled)
+            {
+                DiagEntry at = { .code = DIAG_INCLUDE, .line = t->line[i], .column = t->column[i], .offset = t->start[i], .length = t->length[i] };
+                addDiagnostic(&h->lx->diags, &at, "Warning at line %d: Header '%.*s' not found\n", t->line[i], (int)len, name);
+            }
+            continue;
+        }
+        if (h->includeCount == capacity)
+        {
+            capacity = (capacity > 0) ? capacity * 2 : 16;
+            IncludeRef* grown = realloc(h->includes, capacity * sizeof(IncludeRef));
+            if (grown == NULL)
+            {
+                return 0;
+            }
+            h->includes = grown;
+        }
+        h->includes[h->includeCount].token = i;
+        h->includes[h->includeCount].header = found;
+        h->includeCount++;
+    }
+    return 1;
+}
+
+// Lex h to the end into its token arrays. Its diagnostics, and the includes
+// it has that are not found, stay in its lexer: whichever thread gets here
+// first, they are printed at the end (see destroyHeaderCache). Returns 0 if
+// it cannot be read or mapped.
+static int loadHeader(HeaderCache* cache, Header* h)
+{
+    LexerState* lx = createLexer(h->path);
+    if (lx == NULL || lx->streaming)
+    {
+        // Only a mapped file keeps the text of its tokens
+        h->problem = "Warning: Could not read header";
+        destroyLexer(lx);
+        return 0;
+    }
+    setLexerInterner(lx, cache->symbols);
+    setLexerDirectives(lx, 1);
+    setLexerDialect(lx, (cache->dialect >= 0) ? (LexerDialect)cache->dialect : lexerDialectForFile(h->path));
+    if (cache->diagnosticLimit >= 0)
+    {
+        setLexerDiagnosticLimit(lx, (size_t)cache->diagnosticLimit);
+    }
+    h->lx = lx;
+
+    int ok = 1;
+    while ((ok = reserveTokens(&h->tokens, h->count + HEADER_BATCH_SIZE)))
+    {
+        TokenBatch* t = &h->tokens;
+        TokenBatch part = { t->type + h->count, t->start + h->count, t->length + h->count, t->line + h->count,
+                            t->column + h->count, t->keyword + h->count, t->symbol + h->count, HEADER_BATCH_SIZE };
+        size_t n = nextTokens(lx, &part);
+        if (n == 0)
+        {
+            break;
+        }
+        h->count += n;
+    }
+    finishLexerInput(lx);
+    ok = ok && findIncludes(cache, h);
+    if (!ok)
+    {
+        h->problem = "Error: Out of memory lexing header";
+    }
+    h->once = hasIncludeGuard(h) || hasPragmaOnce(h);
+    return ok;
+}
+
+// h, lexed by this thread if it is the first to need it; NULL if it cannot be
+// read. Loading a header never waits for another, so threads cannot deadlock.
+static const Header* useHeader(HeaderCache* cache, Header* h)
+{
+    pthread_mutex_lock(&cache->lock);
+    while (h->state == HEADER_LOADING)
+    {
+        pthread_cond_wait(&cache->loaded, &cache->lock);
+    }
+    if (h->state == HEADER_NEW)
+    {
+        h->state = HEADER_LOADING;
+        pthread_mutex_unlock(&cache->lock);
+        int ok = loadHeader(cache, h);
+        pthread_mutex_lock(&cache->lock);
+        h->state = ok ? HEADER_READY : HEADER_FAILED;
+        __atomic_fetch_add(&cache->stats.headers, (uint64_t)ok, __ATOMIC_RELAXED);
+        pthread_cond_broadcast(&cache->loaded);
+    }
+    int ready = (h->state == HEADER_READY);
+    pthread_mutex_unlock(&cache->lock);
+    return ready ? h : NULL;
+}
+
+// --- The cache ---
+
+HeaderCache* createHeaderCache(Interner* symbols, long diagnosticLimit, int dialect)
+{
+    HeaderCache* cache = calloc(1, sizeof(HeaderCache));
+    if (cache == NULL)
+    {
+        return NULL;
+    }
+    cache->names = createInterner(0); // Used under 'lock'
+    if (cache->names == NULL)
+    {
+        free(cache);
+        return NULL;
+    }
+    pthread_mutex_init(&cache->lock, NULL);
+    pthread_cond_init(&cache->loaded, NULL);
+    cache->symbols = symbols;
+    cache->diagnosticLimit = diagnosticLimit;
+    cache->dialect = dialect;
+    return cache;
+}
+
+static int byPath(const void* a, const void* b)
+{
+    const Header* x = *(const Header* const*)a;
+    const Header* y = *(const Header* const*)b;
+    return (x == NULL || y == NULL) ? (x == NULL) - (y == NULL) : strcmp(x->path, y->path);
+}
+
+void destroyHeaderCache(HeaderCache* cache)
+{
+    if (cache == NULL)
+    {
+        return;
+    }
+    // Headers by path, so their diagnostics come out in the same order
+    // however the translation units were spread over threads
+    qsort(cache->headers, cache->capacity, sizeof(Header*), byPath);
+    for (size_t i = 0; i < cache->capacity; i++)
+    {
+        Header* h = cache->headers[i];
+        if (h != NULL)
+        {
+            if (h->problem != NULL)
+            {
+                fprintf(stderr, "%s '%s'\n", h->problem, h->path);
+            }
+            if (h->lx != NULL && (h->lx->diags.count > 0 || h->lx->diags.repeated > 0 || h->lx->diags.dropped > 0))
+            {
+                fprintf(stderr, "In header %s:\n", h->path);
+            }
+            destroyLexer(h->lx); // Prints its diagnostics
+            freeTokens(&h->tokens);
+            free(h->includes);
+            free(h->path);
+            free(h);
+        }
+    }
+    for (size_t i = 0; i < cache->searchCount; i++)
+    {
+        free(cache->searchPaths[i]);
+    }
+    free(cache->searchPaths);
+    free(cache->headers);
+    destroyInterner(cache->names);
+    pthread_cond_destroy(&cache->loaded);
+    pthread_mutex_destroy(&cache->lock);
+    free(cache);
+}
+
+int addIncludePath(HeaderCache* cache, const char* dir)
+{
+    char** grown = realloc(cache->searchPaths, (cache->searchCount + 1) * sizeof(char*));
+    if (grown == NULL)
+    {
+        return 0;
+    }
+    cache->searchPaths = grown;
+    if ((grown[cache->searchCount] = strdup(dir)) == NULL)
+    {
+        return 0;
+    }
+    cache->searchCount++;
+    return 1;
+}
+
+void getHeaderCacheStats(const HeaderCache* cache, HeaderCacheStats* stats)
+{
+    stats->headers = __atomic_load_n(&cache->stats.headers, __ATOMIC_RELAXED);
+    stats->inclusions = __atomic_load_n(&cache->stats.inclusions, __ATOMIC_RELAXED);
+    stats->skipped = __atomic_load_n(&cache->stats.skipped, __ATOMIC_RELAXED);
+    stats->missing = __atomic_load_n(&cache->stats.missing, __ATOMIC_RELAXED);
+}
+
+// --- Translation units ---
+
+TranslationUnit* openTranslationUnit(HeaderCache* cache, LexerState* lx, const char* filename, FILE* err)
+{
+    TranslationUnit* tu = calloc(1, sizeof(TranslationUnit));
+    if (tu == NULL)
+    {
+        return NULL;
+    }
+    if (!reserveTokens(&tu->buffer, UNIT_BATCH_SIZE))
+    {
+        freeTokens(&tu->buffer);
+        free(tu);
+        return NULL;
+    }
+    tu->cache = cache;
+    tu->lx = lx;
+    tu->filename = filename;
+    tu->err = err;
+    tu->diags.limit = lx->diags.limit;
+    tu->diags.dedupe = 1;
+    setLexerDirectives(lx, 1);
+    return tu;
+}
+
+void closeTranslationUnit(TranslationUnit* tu)
+{
+    if (tu == NULL)
+    {
+        return;
+    }
+    flushDiagLog(&tu->diags, tu->err);
+    freeDiagLog(&tu->diags);
+    freeTokens(&tu->buffer);
+    free(tu->seen);
+    free(tu);
+}
+
+// Follow an #include of h: push it unless it is a repeat that adds nothing
+static void includeHeader(TranslationUnit* tu, Header* found)
+{
+    HeaderCache* cache = tu->cache;
+    const Header* h = useHeader(cache, found);
+    if (h == NULL)
+    {
+        return;
+    }
+    __atomic_fetch_add(&cache->stats.inclusions, 1, __ATOMIC_RELAXED);
+    if (h->id < tu->seenCount && tu->seen[h->id] && h->once)
+    {
+        __atomic_fetch_add(&cache->stats.skipped, 1, __ATOMIC_RELAXED);
+        return;
+    }
+    if (tu->depth == INCLUDE_DEPTH_MAX)
+    {
+        DiagEntry at = { .code = DIAG_INCLUDE, .offset = tu->origin };
+        lexerLineColumn(tu->lx, tu->origin, &at.line, &at.column);
+        addDiagnostic(&tu->diags, &at, "Warning at line %d: Includes nested more than %d deep, '%s' not followed\n",
+                      at.line, INCLUDE_DEPTH_MAX, h->path);
+        return;
+    }
+    if (h->id >= tu->seenCount)
+    {
+        size_t n = (size_t)h->id * 2 + 64;
+        unsigned char* grown = realloc(tu->seen, n);
+        if (grown != NULL)
+        {
+            memset(grown + tu->seenCount, 0, n - tu->seenCount);
+            tu->seen = grown;
+            tu->seenCount = n;
+        }
+    }
+    if (h->id < tu->seenCount)
+    {
+        tu->seen[h->id] = 1;
+    }
+    IncludeFrame* f = &tu->stack[tu->depth++];
+    f->header = h;
+    f->next = 0;
+    f->include = 0;
+}
+
+// Follow the #include directive that is token i of the main file's buffer, if it is one
+static void includeFromMain(TranslationUnit* tu, size_t i)
+{
+    const char* name;
+    int angled;
+    size_t start = tu->buffer.start[i];
+    size_t len = includedName(lexerTextAt(tu->lx, start), tu->buffer.length[i], &name, &angled);
+    if (len == 0)
+    {
+        return;
+    }
+    Header* h = findHeader(tu->cache, tu->filename, name, len, angled);
+    if (h != NULL)
+    {
+        tu->origin = start;
+        includeHeader(tu, h);
+        return;
+    }
+    __atomic_fetch_add(&tu->cache->stats.missing, 1, __ATOMIC_RELAXED);
+    if (!angled)
+    {
+        DiagEntry at = { .code = DIAG_INCLUDE, .offset = start, .length = tu->buffer.length[i] };
+        lexerLineColumn(tu->lx, start, &at.line, &at.column);
+        addDiagnostic(&tu->diags, &at, "Warning at line %d: Header '%.*s' not found\n", at.line, (int)len, name);
+    }
+}
+
+// Copy tokens [first, first + n) of 'from' to the start of 'into', in the
+// fields 'into' has
+static void copyTokens(TokenBatch* into, const TokenBatch* from, size_t first, size_t n)
+{
+    memcpy(into->type, from->type + first, n * sizeof(TokenType));
+    memcpy(into->start, from->start + first, n * sizeof(size_t));
+    memcpy(into->length, from->length + first, n * sizeof(size_t));
+    if (into->line != NULL)
+    {
+        memcpy(into->line, from->line + first, n * sizeof(int));
+    }
+    if (into->column != NULL)
+    {
+        memcpy(into->column, from->column + first, n * sizeof(int));
+    }
+    if (into->keyword != NULL)
+    {
+        memcpy(into->keyword, from->keyword + first, n * sizeof(KeywordId));
+    }
+    if (into->symbol != NULL)
+    {
+        memcpy(into->symbol, from->symbol + first, n * sizeof(uint32_t));
+    }
+}
+
+size_t nextUnitTokens(TranslationUnit* tu, TokenBatch* batch, const char** file, LexerState** source)
+{
+    while (tu->depth > 0)
+    {
+        IncludeFrame* f = &tu->stack[tu->depth - 1];
+        const Header* h = f->header;
+        if (f->next == h->count)
+        {
+            tu->depth--;
+            continue;
+        }
+        // Up to the next #include, which is followed right after it
+        size_t end = (f->include < h->includeCount) ? h->includes[f->include].token + 1 : h->count;
+        size_t n = (end - f->next < batch->capacity) ? end - f->next : batch->capacity;
+        copyTokens(batch, &h->tokens, f->next, n);
+        f->next += n;
+        *file = h->path;
+        *source = h->lx;
+        if (f->include < h->includeCount && f->next == end)
+        {
+            includeHeader(tu, h->includes[f->include++].header);
+        }
+        return n;
+    }
+
+    if (tu->next == tu->count)
+    {
+        // Fetch only the fields the caller wants from the lexer
+        TokenBatch want = tu->buffer;
+        want.line = (batch->line != NULL) ? want.line : NULL;
+        want.column = (batch->column != NULL) ? want.column : NULL;
+        want.keyword = (batch->keyword != NULL) ? want.keyword : NULL;
+        want.symbol = (batch->symbol != NULL) ? want.symbol : NULL;
+        tu->count = nextTokens(tu->lx, &want);
+        tu->next = 0;
+        if (tu->count == 0)
+        {
+            return 0;
+        }
+    }
+    size_t first = tu->next;
+    size_t stop = (tu->count - first < batch->capacity) ? tu->count : first + batch->capacity;
+    while (tu->next < stop)
+    {
+        size_t i = tu->next++;
+        if (tu->buffer.type[i] == DIRECTIVE)
+        {
+            includeFromMain(tu, i);
+            if (tu->depth > 0)
+            {
+                break;
+            }
+        }
+    }
+    copyTokens(batch, &tu->buffer, first, tu->next - first);
+    *file = tu->filename;
+    *source = tu->lx;
+    return tu->next - first;
+}
@@ -0,0 +1,62 @@
+#ifndef HEADERS_H
+#define HEADERS_H
+
+#include <stdint.h>
+#include <stdio.h>
+#include "lexer.h"
+
+// Include-following mode: a translation unit is the token stream of a file
+// with, after each #include directive that names a header found on the
+// search paths, the tokens of that header (and of what it includes, in
+// turn). Conditionals and macros are not evaluated: every #include is
+// followed, whatever #if it is under, and an #include of a macro is not.
+//
+// Headers are lexed once per process into a HeaderCache shared by every
+// translation unit, on any thread; later inclusions replay the cached tokens.
+// A header whose tokens are all inside an include guard (#ifndef X /
+// #define X ... #endif) or that has #pragma once adds nothing when it is
+// included again, so a translation unit takes its tokens only the first time.
+typedef struct HeaderCache HeaderCache;
+typedef struct TranslationUnit TranslationUnit;
+
+#define INCLUDE_DEPTH_MAX 200 // Nested inclusions followed at most
+
+// Header lexers intern identifiers into 'symbols' (may be NULL), keep
+// 'diagnosticLimit' diagnostics (-1: the lexer's default) and lex in
+// 'dialect', a LexerDialect (-1: the one of each header's extension, see
+// lexerDialectForFile). A header is lexed once, so every translation unit
+// gets the same tokens from it. NULL when out of memory.
+HeaderCache* createHeaderCache(Interner* symbols, long diagnosticLimit, int dialect);
+// Prints the diagnostics of every header on stderr, header by header in path
+// order under "In header <path>:", so they do not depend on which translation
+// unit lexed a header first. Also unmaps the headers: the text of their
+// tokens is gone after this.
+void destroyHeaderCache(HeaderCache* cache);
+// Search 'dir' for headers, after the directories added before. "name"
+// is looked for next to the file that includes it first, <name> only here.
+// Returns 0 when out of memory.
+int addIncludePath(HeaderCache* cache, const char* dir);
+
+typedef struct {
+    uint64_t headers;    // Headers lexed
+    uint64_t inclusions; // #include directives followed
+    uint64_t skipped;    // Of them, repeats of a guarded header that added nothing
+    uint64_t missing;    // #include directives whose header was not found
+} HeaderCacheStats;
+
+void getHeaderCacheStats(const HeaderCache* cache, HeaderCacheStats* stats);
+
+// The translation unit of 'filename', lexed by lx ("-" for the standard
+// input, whose quoted includes are looked for in the current directory).
+// It turns the directives of lx on: open it before taking any token.
+// Problems with its includes are reported to 'err' when it is closed; those
+// of a header by destroyHeaderCache(). NULL when out of memory.
+TranslationUnit* openTranslationUnit(HeaderCache* cache, LexerState* lx, const char* filename, FILE* err);
+// Fill 'batch' (pass the same one each time) with the next tokens of the
+// unit, all from one file: *file is its path and lexerTextAt(*source, ...)
+// gives their text. Returns 0 at the end.
+size_t nextUnitTokens(TranslationUnit* tu, TokenBatch* batch, const char** file, LexerState** source);
+// Does not close lx
+void closeTranslationUnit(TranslationUnit* tu);
+
+#endif
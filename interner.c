@@ -0,0 +1,198 @@
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+#include "arena.h"
+#include "interner.h"
+
+#define STRING_BLOCK_SIZE (64 * 1024)
+
+typedef struct {
+    const char* text;
+    uint32_t length;
+    uint32_t hash;
+} Symbol;
+
+struct Interner {
+    Arena* strings;       // Symbol text, bump-allocated
+    Symbol* symbols;      // Indexed by id; symbols[0] is unused
+    uint32_t count;       // Ids in use are 1..count
+    uint32_t capacity;    // Allocated entries in symbols
+    uint32_t* slots;      // Open-addressing table of ids, 0 = empty
+    uint32_t slotMask;    // Table size - 1 (a power of two)
+    int threadSafe;
+    pthread_mutex_t lock;
+};
+
+// --- Hashing: 8 bytes at a time, then a final mix ---
+static uint32_t hashBytes(const char* str, size_t len)
+{
+    uint64_t h = 0x9e3779b97f4a7c15ULL ^ len;
+    while (len >= 8)
+    {
+        uint64_t w;
+        memcpy(&w, str, 8);
+        h = (h ^ w) * 0xff51afd7ed558ccdULL;
+        h ^= h >> 32;
+        str += 8;
+        len -= 8;
+    }
+    uint64_t w = 0;
+    memcpy(&w, str, len);
+    h = (h ^ w) * 0xc4ceb9fe1a85ec53ULL;
+    h ^= h >> 29;
+    return (uint32_t)h;
+}
+
+// --- Table ---
+static int growSlots(Interner* in)
+{
+    uint32_t size = (in->slots == NULL) ? 1024 : (in->slotMask + 1) * 2;
+    uint32_t* slots = calloc(size, sizeof(uint32_t));
+    if (slots == NULL)
+    {
+        return 0;
+    }
+    for (uint32_t id = 1; id <= in->count; id++)
+    {
+        uint32_t i = in->symbols[id].hash & (size - 1);
+        while (slots[i] != 0)
+        {
+            i = (i + 1) & (size - 1);
+        }
+        slots[i] = id;
+    }
+    free(in->slots);
+    in->slots = slots;
+    in->slotMask = size - 1;
+    return 1;
+}
+
+Interner* createInterner(int threadSafe)
+{
+    Interner* in = calloc(1, sizeof(Interner));
+    if (in == NULL)
+    {
+        return NULL;
+    }
+    in->threadSafe = threadSafe;
+    if (threadSafe)
+    {
+        pthread_mutex_init(&in->lock, NULL);
+    }
+    in->strings = createArena(STRING_BLOCK_SIZE);
+    if (in->strings == NULL || !growSlots(in))
+    {
+        destroyArena(in->strings);
+        free(in);
+        return NULL;
+    }
+    return in;
+}
+
+void destroyInterner(Interner* in)
+{
+    if (in == NULL)
+    {
+        return;
+    }
+    destroyArena(in->strings);
+    if (in->threadSafe)
+    {
+        pthread_mutex_destroy(&in->lock);
+    }
+    free(in->symbols);
+    free(in->slots);
+    free(in);
+}
+
+static uint32_t internLocked(Interner* in, const char* str, size_t len, uint32_t hash)
+{
+    uint32_t i = hash & in->slotMask;
+    for (uint32_t id; (id = in->slots[i]) != 0; i = (i + 1) & in->slotMask)
+    {
+        const Symbol* s = &in->symbols[id];
+        if (s->hash == hash && s->length == len && memcmp(s->text, str, len) == 0)
+        {
+            return id;
+        }
+    }
+
+    // New string: keep the table at most half full
+    if ((in->count + 1) * 2 > in->slotMask + 1)
+    {
+        if (!growSlots(in))
+        {
+            return NO_SYMBOL;
+        }
+        return internLocked(in, str, len, hash);
+    }
+    if (in->count + 1 >= in->capacity)
+    {
+        uint32_t capacity = (in->capacity == 0) ? 1024 : in->capacity * 2;
+        Symbol* symbols = realloc(in->symbols, capacity * sizeof(Symbol));
+        if (symbols == NULL)
+        {
+            return NO_SYMBOL;
+        }
+        in->symbols = symbols;
+        in->capacity = capacity;
+    }
+    const char* text = arenaCopyString(in->strings, str, len);
+    if (text == NULL)
+    {
+        return NO_SYMBOL;
+    }
+    uint32_t id = ++in->count;
+    in->symbols[id].text = text;
+    in->symbols[id].length = (uint32_t)len;
+    in->symbols[id].hash = hash;
+    in->slots[i] = id;
+    return id;
+}
+
+uint32_t internString(Interner* in, const char* str, size_t len)
+{
+    uint32_t hash = hashBytes(str, len);
+    if (!in->threadSafe)
+    {
+        return internLocked(in, str, len, hash);
+    }
+    pthread_mutex_lock(&in->lock);
+    uint32_t id = internLocked(in, str, len, hash);
+    pthread_mutex_unlock(&in->lock);
+    return id;
+}
+
+const char* internedString(Interner* in, uint32_t id, size_t* len)
+{
+    const char* text = NULL;
+    if (in->threadSafe)
+    {
+        pthread_mutex_lock(&in->lock);
+    }
+    if (id != NO_SYMBOL && id <= in->count)
+    {
+        text = in->symbols[id].text;
+        if (len != NULL)
+        {
+            *len = in->symbols[id].length;
+        }
+    }
+    if (in->threadSafe)
+    {
+        pthread_mutex_unlock(&in->lock);
+    }
+    return text;
+}
+
+uint32_t internerCount(Interner* in)
+{
+    if (!in->threadSafe)
+    {
+        return in->count;
+    }
+    pthread_mutex_lock(&in->lock);
+    uint32_t count = in->count;
+    pthread_mutex_unlock(&in->lock);
+    return count;
+}
@@ -0,0 +1,31 @@
+#ifndef INTERNER_H
+#define INTERNER_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// String interner: maps each distinct string to a dense 32-bit symbol id
+// (1, 2, 3, ... in first-seen order) and stores its text once, in arena
+// blocks that never move. One interner can be shared by any number of
+// lexers, so names common to many files are stored only once.
+typedef struct Interner Interner;
+
+#define NO_SYMBOL 0 // Id of "no symbol" (tokens that are not identifiers)
+
+// 'threadSafe' guards the interner with a mutex so lexers running on
+// several threads can share it; leave it 0 for single-threaded use.
+Interner* createInterner(int threadSafe);
+void destroyInterner(Interner* in);
+
+// Id of str[0..len), adding it if it is new. Returns NO_SYMBOL only when
+// out of memory.
+uint32_t internString(Interner* in, const char* str, size_t len);
+
+// NUL-terminated text of 'id' (its length in *len if len is not NULL), or
+// NULL for an unknown id. The pointer stays valid until destroyInterner().
+const char* internedString(Interner* in, uint32_t id, size_t* len);
+
+// Number of distinct strings interned so far
+uint32_t internerCount(Interner* in);
+
+#endif
@@ -0,0 +1,457 @@
+// Generated by tools/gen_keywords.c -- do not edit.
+#include <stdint.h>
+#include <string.h>
+#include "keywords.h"
+
+static const char* const keywordNames[KW_COUNT] = {
+    "",
+    "auto",
+    "break",
+    "case",
+    "char",
+    "const",
+    "continue",
+    "default",
+    "do",
+    "double",
+    "else",
+    "enum",
+    "extern",
+    "float",
+    "for",
+    "goto",
+    "if",
+    "int",
+    "long",
+    "register",
+    "return",
+    "short",
+    "signed",
+    "sizeof",
+    "static",
+    "struct",
+    "switch",
+    "typedef",
+    "union",
+    "unsigned",
+    "void",
+    "volatile",
+    "while",
+    "inline",
+    "restrict",
+    "_Bool",
+    "_Complex",
+    "_Imaginary",
+    "_Alignas",
+    "_Alignof",
+    "_Atomic",
+    "_Generic",
+    "_Noreturn",
+    "_Static_assert",
+    "_Thread_local",
+    "alignas",
+    "alignof",
+    "bool",
+    "constexpr",
+    "false",
+    "nullptr",
+    "static_assert",
+    "thread_local",
+    "true",
+    "typeof",
+    "typeof_unqual",
+    "_BitInt",
+    "_Decimal32",
+    "_Decimal64",
+    "_Decimal128",
+    "and",
+    "and_eq",
+    "asm",
+    "bitand",
+    "bitor",
+    "catch",
+    "char8_t",
+    "char16_t",
+    "char32_t",
+    "class",
+    "compl",
+    "concept",
+    "consteval",
+    "constinit",
+    "const_cast",
+    "co_await",
+    "co_return",
+    "co_yield",
+    "decltype",
+    "delete",
+    "dynamic_cast",
+    "explicit",
+    "export",
+    "friend",
+    "mutable",
+    "namespace",
+    "new",
+    "noexcept",
+    "not",
+    "not_eq",
+    "operator",
+    "or",
+    "or_eq",
+    "private",
+    "protected",
+    "public",
+    "reinterpret_cast",
+    "requires",
+    "static_cast",
+    "template",
+    "this",
+    "throw",
+    "try",
+    "typeid",
+    "typename",
+    "using",
+    "virtual",
+    "wchar_t",
+    "xor",
+    "xor_eq",
+};
+
+// Slot -> keyword: signature for the cheap check, then the id
+typedef struct {
+    uint32_t sig;
+    uint8_t id;
+} KeywordSlot;
+
+static uint32_t keywordMix(uint32_t x)
+{
+    x ^= x >> 15;
+    x *= 0x2c1b3c6dU;
+    x ^= x >> 12;
+    x *= 0x297a2d39U;
+    x ^= x >> 15;
+    return x;
+}
+
+// Look str[0..len) up in one dialect's tables: a displacement per bucket,
+// then 'slotCount' slots
+static inline KeywordId findKeyword(const uint16_t* disp, uint32_t bucketMask, const KeywordSlot* slots,
+                                    uint32_t slotCount, size_t maxLen, const char* str, size_t len)
+{
+    if (len < 2 || len > maxLen)
+    {
+        return KW_NONE;
+    }
+    uint32_t sig = (uint32_t)len | ((uint32_t)(unsigned char)str[0] << 8) | ((uint32_t)(unsigned char)str[len - 1] << 16) |
+                   ((uint32_t)(unsigned char)str[len / 2] << 24);
+    uint32_t d = disp[keywordMix(sig) & bucketMask];
+    uint32_t slot = keywordMix(sig ^ (d * 0x9e3779b9U)) % slotCount;
+    if (slots[slot].sig != sig)
+    {
+        return KW_NONE;
+    }
+    KeywordId id = (KeywordId)slots[slot].id;
+    return memcmp(str, keywordNames[id], len) == 0 ? id : KW_NONE;
+}
+
+// C89: 32 keywords
+static const uint16_t keywordDispC89[16] = {
+    3, 1, 3, 4, 0, 24, 92, 5,
+    10, 3, 21, 19, 5, 13, 62, 0
+};
+
+static const KeywordSlot keywordSlotsC89[32] = {
+    { 0x6e647306u, KW_SIGNED },
+    { 0x6e676c04u, KW_LONG },
+    { 0x73656504u, KW_ELSE },
+    { 0x62656406u, KW_DOUBLE },
+    { 0x6e746305u, KW_CONST },
+    { 0x74637306u, KW_STATIC },
+    { 0x746f6104u, KW_AUTO },
+    { 0x656e6506u, KW_EXTERN },
+    { 0x6f746605u, KW_FLOAT },
+    { 0x69647604u, KW_VOID },
+    { 0x73656304u, KW_CASE },
+    { 0x696e7505u, KW_UNION },
+    { 0x746f6704u, KW_GOTO },
+    { 0x6f747305u, KW_SHORT },
+    { 0x65667306u, KW_SIZEOF },
+    { 0x69656308u, KW_CONTINUE },
+    { 0x61726304u, KW_CHAR },
+    { 0x6f6f6402u, KW_DO },
+    { 0x74657608u, KW_VOLATILE },
+    { 0x67647508u, KW_UNSIGNED },
+    { 0x65667407u, KW_TYPEDEF },
+    { 0x61746407u, KW_DEFAULT },
+    { 0x656b6205u, KW_BREAK },
+    { 0x74687306u, KW_SWITCH },
+    { 0x75747306u, KW_STRUCT },
+    { 0x73727208u, KW_REGISTER },
+    { 0x6e746903u, KW_INT },
+    { 0x756e7206u, KW_RETURN },
+    { 0x66666902u, KW_IF },
+    { 0x6f726603u, KW_FOR },
+    { 0x756d6504u, KW_ENUM },
+    { 0x69657705u, KW_WHILE },
+};
+
+KeywordId lookupKeywordC89(const char* str, size_t len)
+{
+    return findKeyword(keywordDispC89, 15, keywordSlotsC89, 32, 8, str, len);
+}
+
+// C11: 44 keywords
+static const uint16_t keywordDispC11[32] = {
+    1, 5, 0, 0, 0, 0, 12, 2,
+    1, 15, 5, 1, 1, 1, 0, 14,
+    2, 5, 2, 2, 0, 3, 6, 15,
+    4, 19, 1, 6, 5, 10, 8, 18
+};
+
+static const KeywordSlot keywordSlotsC11[44] = {
+    { 0x61726304u, KW_CHAR },
+    { 0x656e5f09u, KW__NORETURN },
+    { 0x69647604u, KW_VOID },
+    { 0x74657608u, KW_VOLATILE },
+    { 0x67665f08u, KW__ALIGNOF },
+    { 0x6f6c5f05u, KW__BOOL },
+    { 0x656e6506u, KW_EXTERN },
+    { 0x6f635f07u, KW__ATOMIC },
+    { 0x5f745f0eu, KW__STATIC_ASSERT },
+    { 0x646c5f0du, KW__THREAD_LOCAL },
+    { 0x67647508u, KW_UNSIGNED },
+    { 0x756e7206u, KW_RETURN },
+    { 0x69656906u, KW_INLINE },
+    { 0x72747208u, KW_RESTRICT },
+    { 0x75747306u, KW_STRUCT },
+    { 0x65667407u, KW_TYPEDEF },
+    { 0x73727208u, KW_REGISTER },
+    { 0x6e746305u, KW_CONST },
+    { 0x69657705u, KW_WHILE },
+    { 0x61746407u, KW_DEFAULT },
+    { 0x65667306u, KW_SIZEOF },
+    { 0x66666902u, KW_IF },
+    { 0x74687306u, KW_SWITCH },
+    { 0x746f6704u, KW_GOTO },
+    { 0x6f726603u, KW_FOR },
+    { 0x746f6104u, KW_AUTO },
+    { 0x73656504u, KW_ELSE },
+    { 0x756d6504u, KW_ENUM },
+    { 0x6e647306u, KW_SIGNED },
+    { 0x6f746605u, KW_FLOAT },
+    { 0x6f6f6402u, KW_DO },
+    { 0x65635f08u, KW__GENERIC },
+    { 0x73656304u, KW_CASE },
+    { 0x70785f08u, KW__COMPLEX },
+    { 0x656b6205u, KW_BREAK },
+    { 0x69656308u, KW_CONTINUE },
+    { 0x6e746903u, KW_INT },
+    { 0x69795f0au, KW__IMAGINARY },
+    { 0x6f747305u, KW_SHORT },
+    { 0x67735f08u, KW__ALIGNAS },
+    { 0x74637306u, KW_STATIC },
+    { 0x696e7505u, KW_UNION },
+    { 0x6e676c04u, KW_LONG },
+    { 0x62656406u, KW_DOUBLE },
+};
+
+KeywordId lookupKeywordC11(const char* str, size_t len)
+{
+    return findKeyword(keywordDispC11, 31, keywordSlotsC11, 44, 14, str, len);
+}
+
+// C23: 59 keywords
+static const uint16_t keywordDispC23[32] = {
+    3, 12, 0, 5, 0, 0, 14, 21,
+    3, 6, 4, 12, 2, 8, 0, 15,
+    1, 1, 11, 1, 27, 5, 13, 10,
+    6, 5, 1, 21, 4, 3, 128, 83
+};
+
+static const KeywordSlot keywordSlotsC23[59] = {
+    { 0x5f74730du, KW_STATIC_ASSERT },
+    { 0x6d385f0bu, KW__DECIMAL128 },
+    { 0x646c5f0du, KW__THREAD_LOCAL },
+    { 0x67665f08u, KW__ALIGNOF },
+    { 0x656b6205u, KW_BREAK },
+    { 0x6c726e07u, KW_NULLPTR },
+    { 0x696e7505u, KW_UNION },
+    { 0x6f6c6204u, KW_BOOL },
+    { 0x6f726603u, KW_FOR },
+    { 0x73656304u, KW_CASE },
+    { 0x65667406u, KW_TYPEOF },
+    { 0x6e746305u, KW_CONST },
+    { 0x6f747305u, KW_SHORT },
+    { 0x74637306u, KW_STATIC },
+    { 0x756d6504u, KW_ENUM },
+    { 0x656e6506u, KW_EXTERN },
+    { 0x6d345f0au, KW__DECIMAL64 },
+    { 0x746f6704u, KW_GOTO },
+    { 0x6e676c04u, KW_LONG },
+    { 0x66666902u, KW_IF },
+    { 0x6e647306u, KW_SIGNED },
+    { 0x5f745f0eu, KW__STATIC_ASSERT },
+    { 0x65667407u, KW_TYPEDEF },
+    { 0x62656406u, KW_DOUBLE },
+    { 0x74657608u, KW_VOLATILE },
+    { 0x69795f0au, KW__IMAGINARY },
+    { 0x67736107u, KW_ALIGNAS },
+    { 0x746f6104u, KW_AUTO },
+    { 0x61726304u, KW_CHAR },
+    { 0x6c656605u, KW_FALSE },
+    { 0x67647508u, KW_UNSIGNED },
+    { 0x74726309u, KW_CONSTEXPR },
+    { 0x67666107u, KW_ALIGNOF },
+    { 0x67735f08u, KW__ALIGNAS },
+    { 0x656e5f09u, KW__NORETURN },
+    { 0x6f635f07u, KW__ATOMIC },
+    { 0x6f6f6402u, KW_DO },
+    { 0x73656504u, KW_ELSE },
+    { 0x69647604u, KW_VOID },
+    { 0x69657705u, KW_WHILE },
+    { 0x75657404u, KW_TRUE },
+    { 0x756e7206u, KW_RETURN },
+    { 0x61746407u, KW_DEFAULT },
+    { 0x6f6c5f05u, KW__BOOL },
+    { 0x65667306u, KW_SIZEOF },
+    { 0x74687306u, KW_SWITCH },
+    { 0x6e746903u, KW_INT },
+    { 0x70785f08u, KW__COMPLEX },
+    { 0x5f6c740cu, KW_THREAD_LOCAL },
+    { 0x6f746605u, KW_FLOAT },
+    { 0x65635f08u, KW__GENERIC },
+    { 0x69656906u, KW_INLINE },
+    { 0x74745f07u, KW__BITINT },
+    { 0x72747208u, KW_RESTRICT },
+    { 0x6d325f0au, KW__DECIMAL32 },
+    { 0x75747306u, KW_STRUCT },
+    { 0x73727208u, KW_REGISTER },
+    { 0x5f6c740du, KW_TYPEOF_UNQUAL },
+    { 0x69656308u, KW_CONTINUE },
+};
+
+KeywordId lookupKeywordC23(const char* str, size_t len)
+{
+    return findKeyword(keywordDispC23, 31, keywordSlotsC23, 59, 14, str, len);
+}
+
+// Cpp: 92 keywords
+static const uint16_t keywordDispCpp[64] = {
+    39, 13, 0, 2, 1, 0, 3, 3,
+    13, 10, 5, 2, 1, 0, 7, 8,
+    6, 5, 0, 2, 1, 0, 49, 1,
+    8, 2, 1, 1, 1, 0, 20, 0,
+    2, 5, 0, 0, 2, 0, 7, 5,
+    1, 3, 1, 5, 1, 1, 13, 0,
+    1, 7, 7, 1, 3, 1, 6, 3,
+    0, 10, 0, 2, 4, 1, 0, 7
+};
+
+static const KeywordSlot keywordSlotsCpp[92] = {
+    { 0x6f726603u, KW_FOR },
+    { 0x6f746605u, KW_FLOAT },
+    { 0x74687306u, KW_SWITCH },
+    { 0x6e646103u, KW_AND },
+    { 0x5f716106u, KW_AND_EQ },
+    { 0x65656406u, KW_DELETE },
+    { 0x33746308u, KW_CHAR32_T },
+    { 0x5f6c740cu, KW_THREAD_LOCAL },
+    { 0x74637306u, KW_STATIC },
+    { 0x65776e03u, KW_NEW },
+    { 0x75747306u, KW_STRUCT },
+    { 0x746f6704u, KW_GOTO },
+    { 0x67736107u, KW_ALIGNAS },
+    { 0x65647406u, KW_TYPEID },
+    { 0x6f747305u, KW_SHORT },
+    { 0x69737404u, KW_THIS },
+    { 0x69746508u, KW_EXPLICIT },
+    { 0x5f716f05u, KW_OR_EQ },
+    { 0x656b6205u, KW_BREAK },
+    { 0x69656906u, KW_INLINE },
+    { 0x65667306u, KW_SIZEOF },
+    { 0x746c7607u, KW_VIRTUAL },
+    { 0x69656308u, KW_CONTINUE },
+    { 0x6d6c6305u, KW_COMPL },
+    { 0x73656304u, KW_CASE },
+    { 0x6c657408u, KW_TEMPLATE },
+    { 0x6c656605u, KW_FALSE },
+    { 0x6e647306u, KW_SIGNED },
+    { 0x31746308u, KW_CHAR16_T },
+    { 0x73656e09u, KW_NAMESPACE },
+    { 0x5f74630au, KW_CONST_CAST },
+    { 0x65647009u, KW_PROTECTED },
+    { 0x656e6506u, KW_EXTERN },
+    { 0x76657007u, KW_PRIVATE },
+    { 0x5f717806u, KW_XOR_EQ },
+    { 0x65646606u, KW_FRIEND },
+    { 0x62656406u, KW_DOUBLE },
+    { 0x5f716e06u, KW_NOT_EQ },
+    { 0x746c6309u, KW_CONSTEVAL },
+    { 0x74746309u, KW_CONSTINIT },
+    { 0x72797403u, KW_TRY },
+    { 0x61656d07u, KW_MUTABLE },
+    { 0x6e676c04u, KW_LONG },
+    { 0x66666902u, KW_IF },
+    { 0x6c637006u, KW_PUBLIC },
+    { 0x6e657408u, KW_TYPENAME },
+    { 0x6f727803u, KW_XOR },
+    { 0x6374640cu, KW_DYNAMIC_CAST },
+    { 0x6e746903u, KW_INT },
+    { 0x5f74730du, KW_STATIC_ASSERT },
+    { 0x74686305u, KW_CATCH },
+    { 0x72777405u, KW_THROW },
+    { 0x736d6103u, KW_ASM },
+    { 0x74726205u, KW_BITOR },
+    { 0x656e6309u, KW_CO_RETURN },
+    { 0x6f746506u, KW_EXPORT },
+    { 0x696e7505u, KW_UNION },
+    { 0x61726f08u, KW_OPERATOR },
+    { 0x63746e08u, KW_NOEXCEPT },
+    { 0x6c726e07u, KW_NULLPTR },
+    { 0x77746308u, KW_CO_AWAIT },
+    { 0x61736305u, KW_CLASS },
+    { 0x6f6f6402u, KW_DO },
+    { 0x67666107u, KW_ALIGNOF },
+    { 0x69737208u, KW_REQUIRES },
+    { 0x6f746e03u, KW_NOT },
+    { 0x61746407u, KW_DEFAULT },
+    { 0x73727208u, KW_REGISTER },
+    { 0x69657705u, KW_WHILE },
+    { 0x75657404u, KW_TRUE },
+    { 0x69647604u, KW_VOID },
+    { 0x746f6104u, KW_AUTO },
+    { 0x6374730bu, KW_STATIC_CAST },
+    { 0x72726f02u, KW_OR },
+    { 0x69646308u, KW_CO_YIELD },
+    { 0x756d6504u, KW_ENUM },
+    { 0x67647508u, KW_UNSIGNED },
+    { 0x61646206u, KW_BITAND },
+    { 0x72746307u, KW_CHAR8_T },
+    { 0x72747210u, KW_REINTERPRET_CAST },
+    { 0x6e746305u, KW_CONST },
+    { 0x74656408u, KW_DECLTYPE },
+    { 0x63746307u, KW_CONCEPT },
+    { 0x74657608u, KW_VOLATILE },
+    { 0x73656504u, KW_ELSE },
+    { 0x69677505u, KW_USING },
+    { 0x61726304u, KW_CHAR },
+    { 0x6f6c6204u, KW_BOOL },
+    { 0x756e7206u, KW_RETURN },
+    { 0x65667407u, KW_TYPEDEF },
+    { 0x74726309u, KW_CONSTEXPR },
+    { 0x61747707u, KW_WCHAR_T },
+};
+
+KeywordId lookupKeywordCpp(const char* str, size_t len)
+{
+    return findKeyword(keywordDispCpp, 63, keywordSlotsCpp, 92, 16, str, len);
+}
+
+KeywordId lookupKeyword(const char* str, size_t len)
+{
+    return lookupKeywordC23(str, len);
+}
+
+const char* getKeywordString(KeywordId id)
+{
+    return ((unsigned)id < KW_COUNT) ? keywordNames[id] : "";
+}
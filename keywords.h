@@ -0,0 +1,135 @@
+// Generated by tools/gen_keywords.c -- do not edit.
+#ifndef KEYWORDS_H
+#define KEYWORDS_H
+
+#include <stddef.h>
+
+// The keywords of every dialect
+typedef enum {
+    KW_NONE = 0,
+    KW_AUTO,
+    KW_BREAK,
+    KW_CASE,
+    KW_CHAR,
+    KW_CONST,
+    KW_CONTINUE,
+    KW_DEFAULT,
+    KW_DO,
+    KW_DOUBLE,
+    KW_ELSE,
+    KW_ENUM,
+    KW_EXTERN,
+    KW_FLOAT,
+    KW_FOR,
+    KW_GOTO,
+    KW_IF,
+    KW_INT,
+    KW_LONG,
+    KW_REGISTER,
+    KW_RETURN,
+    KW_SHORT,
+    KW_SIGNED,
+    KW_SIZEOF,
+    KW_STATIC,
+    KW_STRUCT,
+    KW_SWITCH,
+    KW_TYPEDEF,
+    KW_UNION,
+    KW_UNSIGNED,
+    KW_VOID,
+    KW_VOLATILE,
+    KW_WHILE,
+    KW_INLINE,
+    KW_RESTRICT,
+    KW__BOOL,
+    KW__COMPLEX,
+    KW__IMAGINARY,
+    KW__ALIGNAS,
+    KW__ALIGNOF,
+    KW__ATOMIC,
+    KW__GENERIC,
+    KW__NORETURN,
+    KW__STATIC_ASSERT,
+    KW__THREAD_LOCAL,
+    KW_ALIGNAS,
+    KW_ALIGNOF,
+    KW_BOOL,
+    KW_CONSTEXPR,
+    KW_FALSE,
+    KW_NULLPTR,
+    KW_STATIC_ASSERT,
+    KW_THREAD_LOCAL,
+    KW_TRUE,
+    KW_TYPEOF,
+    KW_TYPEOF_UNQUAL,
+    KW__BITINT,
+    KW__DECIMAL32,
+    KW__DECIMAL64,
+    KW__DECIMAL128,
+    KW_AND,
+    KW_AND_EQ,
+    KW_ASM,
+    KW_BITAND,
+    KW_BITOR,
+    KW_CATCH,
+    KW_CHAR8_T,
+    KW_CHAR16_T,
+    KW_CHAR32_T,
+    KW_CLASS,
+    KW_COMPL,
+    KW_CONCEPT,
+    KW_CONSTEVAL,
+    KW_CONSTINIT,
+    KW_CONST_CAST,
+    KW_CO_AWAIT,
+    KW_CO_RETURN,
+    KW_CO_YIELD,
+    KW_DECLTYPE,
+    KW_DELETE,
+    KW_DYNAMIC_CAST,
+    KW_EXPLICIT,
+    KW_EXPORT,
+    KW_FRIEND,
+    KW_MUTABLE,
+    KW_NAMESPACE,
+    KW_NEW,
+    KW_NOEXCEPT,
+    KW_NOT,
+    KW_NOT_EQ,
+    KW_OPERATOR,
+    KW_OR,
+    KW_OR_EQ,
+    KW_PRIVATE,
+    KW_PROTECTED,
+    KW_PUBLIC,
+    KW_REINTERPRET_CAST,
+    KW_REQUIRES,
+    KW_STATIC_CAST,
+    KW_TEMPLATE,
+    KW_THIS,
+    KW_THROW,
+    KW_TRY,
+    KW_TYPEID,
+    KW_TYPENAME,
+    KW_USING,
+    KW_VIRTUAL,
+    KW_WCHAR_T,
+    KW_XOR,
+    KW_XOR_EQ,
+    KW_COUNT
+} KeywordId;
+
+#define KEYWORD_COUNT 109
+
+// Keyword id of str[0..len) in one dialect (see LexerDialect in lexer.h), or
+// KW_NONE if it is not one of that dialect's keywords
+KeywordId lookupKeywordC89(const char* str, size_t len);
+KeywordId lookupKeywordC11(const char* str, size_t len);
+KeywordId lookupKeywordC23(const char* str, size_t len);
+KeywordId lookupKeywordCpp(const char* str, size_t len);
+// The same in the default dialect, C23
+KeywordId lookupKeyword(const char* str, size_t len);
+// Spelling of a keyword id ("" for KW_NONE)
+const char* getKeywordString(KeywordId id);
+
+#endif
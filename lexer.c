@@ -1,276 +1,1474 @@
 #include <stdio.h>
 #include <string.h>
-#include <ctype.h>
 #include <stdlib.h> // For exit and EXIT_FAILURE
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <stdarg.h>
+#include <errno.h>
 #include "lexer.h"
+#include "lexer_internal.h"
+#include "interner.h"
+#include "lexer_dfa.h"
 
-// Static global variables for lexer state
-static FILE* inputFile;
-static char currentChar;
-static int eofFlag = 0; // To indicate if EOF has been reached
-static int lineNum = 1; // Track current line number for better error messages
-
-// Counters for unmatched delimiters
-static int paren_count = 0;   // ()
-static int brace_count = 0;   // {}
-static int bracket_count = 0; // []
-
-// Predefined lists
-static const char* keywords[MAX_KEYWORDS] = {
-    "int", "float", "return", "if", "else", "while", "for", "do", "break", "continue",
-    "char", "double", "void", "switch", "case", "default", "const", "static", "sizeof", "struct"
+#define STREAM_CHUNK_SIZE (64 * 1024) // Bytes read at a time from streamed inputs
+
+static LexerState defaultLexer;
+static int legacyBanners = 1; // initializeLexer() prints "Open : ... Success"
+
+// --- Character classification ---
+// One table entry per byte value: the low 4 bits are the class that picks the
+// branch of nextToken(), the high bits are flags for the scanning loops. This
+// replaces the <ctype.h> calls (which are locale-aware and undefined for
+// negative chars) and the linear scans over the operator/symbol strings.
+enum {
+    CC_OTHER,    // Not part of any token (reported as UNKNOWN)
+    CC_SPACE,
+    CC_HASH,     // '#' starts a preprocessor line
+    CC_SLASH,    // '/' starts a comment or is an operator
+    CC_DQUOTE,
+    CC_SQUOTE,
+    CC_ALPHA,    // Letters and '_'
+    CC_DIGIT,
+    CC_OPERATOR, // Other operator characters, including '.' ? :
+    CC_SYMBOL,   // ( ) , ; { } [ ]
+    CC_UTF8      // Bytes >= 0x80: UTF-8, decoded where met
 };
 
-static const char* operators = "+-*/%=!<>|&^~";
-static const char* symbols = "(),;{}[]";
+#define CC_MASK   0x0F
+#define CF_SPACE  0x10 // ' ', '\t', '\n', '\v', '\f', '\r'
+#define CF_ALNUM  0x20 // Letter or digit
+#define CF_IDENT  0x40 // Letter, digit or '_'
+#define CF_DIGIT  0x80 // 0-9
+#define CF_XDIGIT 0x100 // 0-9, a-f, A-F
+
+#define __ CC_OTHER
+#define SP (CC_SPACE | CF_SPACE)
+#define HS CC_HASH
+#define SL CC_SLASH
+#define DQ CC_DQUOTE
+#define SQ CC_SQUOTE
+#define LT (CC_ALPHA | CF_ALNUM | CF_IDENT)
+#define HX (CC_ALPHA | CF_ALNUM | CF_IDENT | CF_XDIGIT)
+#define US (CC_ALPHA | CF_IDENT)
+#define DG (CC_DIGIT | CF_ALNUM | CF_IDENT | CF_DIGIT | CF_XDIGIT)
+#define OP CC_OPERATOR
+#define SY CC_SYMBOL
+#define U8 CC_UTF8
+
+static const unsigned short charTable[256] = {
+    __, __, __, __, __, __, __, __, __, SP, SP, SP, SP, SP, __, __, // 00
+    __, __, __, __, __, __, __, __, __, __, __, __, __, __, __, __, // 10
+    SP, OP, DQ, HS, __, OP, OP, SQ, SY, SY, OP, OP, SY, OP, OP, SL, // 20   !"#$%&'()*+,-./
+    DG, DG, DG, DG, DG, DG, DG, DG, DG, DG, OP, SY, OP, OP, OP, OP, // 30  0123456789:;<=>?
+    __, HX, HX, HX, HX, HX, HX, LT, LT, LT, LT, LT, LT, LT, LT, LT, // 40  @ABCDEFGHIJKLMNO
+    LT, LT, LT, LT, LT, LT, LT, LT, LT, LT, LT, SY, __, SY, OP, US, // 50  PQRSTUVWXYZ[\]^_
+    __, HX, HX, HX, HX, HX, HX, LT, LT, LT, LT, LT, LT, LT, LT, LT, // 60  `abcdefghijklmno
+    LT, LT, LT, LT, LT, LT, LT, LT, LT, LT, LT, SY, OP, SY, OP, __, // 70  pqrstuvwxyz{|}~
+    U8, U8, U8, U8, U8, U8, U8, U8, U8, U8, U8, U8, U8, U8, U8, U8, // 80
+    U8, U8, U8, U8, U8, U8, U8, U8, U8, U8, U8, U8, U8, U8, U8, U8, // 90
+    U8, U8, U8, U8, U8, U8, U8, U8, U8, U8, U8, U8, U8, U8, U8, U8, // A0
+    U8, U8, U8, U8, U8, U8, U8, U8, U8, U8, U8, U8, U8, U8, U8, U8, // B0
+    U8, U8, U8, U8, U8, U8, U8, U8, U8, U8, U8, U8, U8, U8, U8, U8, // C0
+    U8, U8, U8, U8, U8, U8, U8, U8, U8, U8, U8, U8, U8, U8, U8, U8, // D0
+    U8, U8, U8, U8, U8, U8, U8, U8, U8, U8, U8, U8, U8, U8, U8, U8, // E0
+    U8, U8, U8, U8, U8, U8, U8, U8, U8, U8, U8, U8, U8, U8, U8, U8, // F0
+};
+
+#undef __
+#undef SP
+#undef HS
+#undef SL
+#undef DQ
+#undef SQ
+#undef LT
+#undef HX
+#undef US
+#undef DG
+#undef OP
+#undef SY
+#undef U8
+
+#define charClass(c)      (charTable[(unsigned char)(c)] & CC_MASK)
+#define charHas(c, flags) (charTable[(unsigned char)(c)] & (flags))
+
+// --- Report a lexical error or warning ---
+// It is buffered (see lexer_diag.c) with its code and the span of input
+// [offset, offset + length) it is about, whose line and column are looked up
+// here. Chunk lexers of a split input log it against the token being scanned
+// instead.
+static void __attribute__((format(printf, 5, 6))) lexError(LexerState* lx, DiagCode code, size_t offset, size_t length, const char* fmt, ...)
+{
+    DiagLog* log = lx->diagLog;
+    if (log == NULL)
+    {
+        STAT_DIAG(lx, code);
+        log = &lx->diags;
+    }
+    if (log->limit > 0 && log->count >= log->limit)
+    {
+        log->dropped++; // Not even formatted
+        return;
+    }
+    DiagEntry at = { .code = code, .offset = offset, .length = length };
+    lexerLineColumn(lx, offset, &at.line, &at.column);
+    va_list ap;
+    va_start(ap, fmt);
+    logDiagnostic(log, &at, fmt, ap);
+    va_end(ap);
+}
+
+// --- Input window ---
+// Positions (readPos, tokStart, token offsets) are offsets into the whole
+// input. srcBuf holds the bytes [srcBase, srcLen) of it: all of a mapped
+// file, or the part of a streamed input read so far that is still needed.
+#define bufChar(lx, pos) ((lx)->srcBuf[(pos) - (lx)->srcBase])
+#define bufPtr(lx, pos)  ((lx)->srcBuf + ((pos) - (lx)->srcBase))
+
+// Map the stretch of a windowed file after the current one: from the page of
+// keepPos on, at least half a window past what is mapped now, and unmap the
+// current one. As with a refill, the text before keepPos goes.
+static int slideWindow(LexerState* lx)
+{
+    if (lx->srcLen >= lx->fileSize)
+    {
+        lx->inputEnd = 1;
+        return 0;
+    }
+    LineIndex* idx = &lx->lineIndex;
+    scanLineStarts(idx, lx->scan, bufPtr(lx, idx->indexedTo), lx->srcLen);
+    dropLinesBefore(idx, lx->keepPos, &lx->lineHint);
+    size_t from = lx->keepPos & ~((size_t)sysconf(_SC_PAGESIZE) - 1);
+    size_t len = lx->windowCap;
+    while (from + len < lx->srcLen + lx->windowCap / 2)
+    {
+        len *= 2; // One batch spans more than the window
+    }
+    if (len > lx->fileSize - from)
+    {
+        len = lx->fileSize - from;
+    }
+    void* map = mmap(NULL, len, PROT_READ, MAP_PRIVATE, lx->inputFd, (off_t)from);
+    if (map == MAP_FAILED)
+    {
+        lexError(lx, DIAG_INPUT, lx->srcLen, 0, "Error: Cannot map input: %s\n", strerror(errno));
+        lx->inputEnd = 1;
+        return 0;
+    }
+    madvise(map, len, MADV_SEQUENTIAL);
+    munmap((void*)lx->srcBuf, lx->srcLen - lx->srcBase);
+    lx->srcBuf = map;
+    lx->srcBase = from;
+    lx->srcLen = from + len;
+    return 1;
+}
+
+// Read the next chunk of a streamed input into the window, first dropping
+// the text before the current batch (nothing refers to it any more). The
+// newline index takes in the text before it is dropped.
+// Returns 0 at the end of the input, and always for mapped inputs.
+static int refillInput(LexerState* lx)
+{
+    if (!lx->streaming || lx->inputEnd)
+    {
+        return 0;
+    }
+    if (lx->windowed)
+    {
+        return slideWindow(lx);
+    }
+    size_t have = lx->srcLen - lx->keepPos;
+    if (lx->keepPos > lx->srcBase)
+    {
+        LineIndex* idx = &lx->lineIndex;
+        scanLineStarts(idx, lx->scan, bufPtr(lx, idx->indexedTo), lx->srcLen);
+        dropLinesBefore(idx, lx->keepPos, &lx->lineHint);
+        memmove(lx->window, lx->window + (lx->keepPos - lx->srcBase), have);
+        lx->srcBase = lx->keepPos;
+    }
+    if (lx->windowCap - have < STREAM_CHUNK_SIZE)
+    {
+        // One batch spans more than the window: grow it
+        size_t cap = lx->windowCap * 2;
+        while (cap - have < STREAM_CHUNK_SIZE)
+        {
+            cap *= 2;
+        }
+        char* window = realloc(lx->window, cap);
+        if (window == NULL)
+        {
+            lexError(lx, DIAG_INPUT, lx->srcLen, 0, "Error: Out of memory reading input\n");
+            lx->inputEnd = 1;
+            return 0;
+        }
+        lx->window = window;
+        lx->windowCap = cap;
+    }
+    lx->srcBuf = lx->window;
+
+    ssize_t n;
+    do
+    {
+        n = read(lx->inputFd, lx->window + have, STREAM_CHUNK_SIZE);
+    } while (n < 0 && errno == EINTR);
+    if (n <= 0)
+    {
+        lx->inputEnd = 1;
+        return 0;
+    }
+    lx->srcLen += (size_t)n;
+    return 1;
+}
+
+// --- Helper function to get the next character ---
+static inline void getNextChar(LexerState* lx) 
+{
+    if (!lx->eofFlag) 
+    {
+        if (lx->readPos < lx->srcLen || refillInput(lx)) 
+        {
+            lx->currentChar = bufChar(lx, lx->readPos);
+            lx->readPos++;
+        } 
+        else 
+        {
+            lx->eofFlag = 1;
+            lx->currentChar = '\0'; // Null terminator to signify end
+        }
+    }
+}
+
+// --- Helper to look at the character after currentChar without consuming it ---
+static int peekChar(LexerState* lx) 
+{
+    if (lx->readPos < lx->srcLen || refillInput(lx)) 
+    {
+        return (unsigned char)bufChar(lx, lx->readPos);
+    }
+    return EOF;
+}
+
+// --- Helpers to build a token as a view of the input ---
+static void beginToken(LexerState* lx) 
+{
+    lx->tokStart = lx->readPos - 1; // Offset of currentChar
+    lx->tokLen = 0;
+    lx->tokKeyword = KW_NONE;
+    lx->tokSymbol = NO_SYMBOL;
+}
+
+// Add currentChar to the token and move on to the next character
+static inline void takeChar(LexerState* lx) 
+{
+    lx->tokLen++;
+    getNextChar(lx);
+}
+
+// --- Fast paths over the input window ---
+// These do the work of a getNextChar()/takeChar() loop with kernel calls or
+// plain table lookups. A kernel stops at the end of the window, so each one
+// loops until it stops on a byte of the input (or at its real end).
+
+// Make byte 'pos' (at most srcLen) of the input the current character
+static inline void seekBuffer(LexerState* lx, size_t pos) 
+{
+    if (pos < lx->srcLen || refillInput(lx)) 
+    {
+        lx->currentChar = bufChar(lx, pos);
+        lx->readPos = pos + 1;
+    } 
+    else 
+    {
+        lx->eofFlag = 1;
+        lx->currentChar = '\0';
+        lx->readPos = lx->srcLen;
+    }
+}
+
+// Skip whitespace
+static inline void skipSpace(LexerState* lx) 
+{
+    while (!lx->eofFlag && charHas(lx->currentChar, CF_SPACE)) 
+    {
+        // Most runs are a single space, which is not worth a kernel call
+        size_t pos = lx->readPos;
+        if (pos < lx->srcLen && charHas(bufChar(lx, pos), CF_SPACE)) 
+        {
+            const char* from = bufPtr(lx, pos);
+            const char* stop = lx->scan->skipSpace(from, bufPtr(lx, lx->srcLen));
+            pos += (size_t)(stop - from);
+        }
+        seekBuffer(lx, pos);
+    }
+}
+
+// Skip to the newline ending the current line (not consuming it)
+static inline void skipToEndOfLine(LexerState* lx) 
+{
+    while (!lx->eofFlag && lx->currentChar != '\n') 
+    {
+        const char* from = bufPtr(lx, lx->readPos);
+        const char* nl = lx->scan->findNewline(from, bufPtr(lx, lx->srcLen));
+        seekBuffer(lx, lx->readPos + (size_t)(nl - from));
+    }
+}
+
+// Skip the body of a block comment; currentChar is the first character after
+// the opening "/*". Stops on the '/' of the closing "*/" (not consuming it).
+// Returns 0, at EOF, if the comment is never closed.
+static int skipBlockComment(LexerState* lx) 
+{
+    while (!lx->eofFlag) 
+    {
+        size_t pos = lx->readPos - 1;
+        const char* from = bufPtr(lx, pos);
+        const char* end = bufPtr(lx, lx->srcLen);
+        const char* star = lx->scan->findCommentEnd(from, end);
+        if (star != end) 
+        {
+            seekBuffer(lx, pos + (size_t)(star - from) + 1);
+            return 1;
+        }
+        // Not closed in the window. Go on in the next chunk, from the last
+        // byte if it is a '*' that the chunk may complete.
+        size_t resume = lx->srcLen - (end > from && end[-1] == '*');
+        if (!refillInput(lx)) 
+        {
+            seekBuffer(lx, lx->srcLen);
+            return 0;
+        }
+        seekBuffer(lx, resume);
+    }
+    return 0;
+}
+
+// Add the plain body characters of a string literal to the token: everything
+// up to the closing 'quote', a backslash or a newline
+static inline void takeLiteralRun(LexerState* lx, char quote) 
+{
+    if (lx->eofFlag) 
+    {
+        return;
+    }
+    size_t pos = lx->readPos - 1;
+    const char* from = bufPtr(lx, pos);
+    const char* stop = lx->scan->findLiteralStop(from, bufPtr(lx, lx->srcLen), quote);
+    size_t n = (size_t)(stop - from);
+    if (n > 0) 
+    {
+        lx->tokLen += n;
+        seekBuffer(lx, pos + n);
+    }
+}
+
+// Add characters to the token while they have one of 'flags'
+static inline void takeWhile(LexerState* lx, unsigned short flags) 
+{
+    while (!lx->eofFlag && charHas(lx->currentChar, flags)) 
+    {
+        const unsigned char* buf = (const unsigned char*)lx->srcBuf - lx->srcBase;
+        size_t pos = lx->readPos - 1;
+        size_t end = lx->srcLen;
+        size_t len = lx->tokLen;
+        while (pos < end && (charTable[buf[pos]] & flags)) 
+        {
+            pos++;
+            len++;
+        }
+        lx->tokLen = len;
+        seekBuffer(lx, pos);
+    }
+}
+
+// Add the 'n' bytes from currentChar on to the token
+static inline void takeBytes(LexerState* lx, size_t n)
+{
+    size_t pos = lx->readPos - 1;
+    lx->tokLen += n;
+    seekBuffer(lx, pos + n);
+}
+
+// Decode the character at currentChar, a byte >= 0x80, into *cp (see
+// lexer_utf8.c). Returns its length, 0 if it is not well-formed UTF-8. Up
+// to four bytes (or the end of the input) are looked at, whatever is taken.
+static int currentUtf8(LexerState* lx, uint32_t* cp)
+{
+    size_t pos = lx->readPos - 1;
+    if (pos + 4 > lx->lookEnd)
+    {
+        lx->lookEnd = pos + 4;
+    }
+    while (lx->srcLen - pos < 4)
+    {
+        if (!refillInput(lx))
+        {
+            break;
+        }
+    }
+    return decodeUtf8(bufPtr(lx, pos), bufPtr(lx, lx->srcLen), cp);
+}
+
+// Add identifier characters to the token: ASCII ones through the class
+// table, others while they decode to XID_Continue
+static inline void takeIdentifierRest(LexerState* lx)
+{
+    takeWhile(lx, CF_IDENT);
+    while (charClass(lx->currentChar) == CC_UTF8)
+    {
+        uint32_t cp;
+        int n = currentUtf8(lx, &cp);
+        if (n == 0 || !isXidContinue(cp))
+        {
+            break;
+        }
+        takeBytes(lx, (size_t)n);
+        takeWhile(lx, CF_IDENT);
+    }
+}
+
+// Where the next scan starts: currentChar, or the end of the input at EOF
+static inline size_t scanPos(const LexerState* lx) 
+{
+    return lx->eofFlag ? lx->srcLen : lx->readPos - 1;
+}
+
+// Lines for messages, looked up only when one is reported. "at line %d"
+// has always meant the line of currentChar, counting it if it is a newline.
+static int tokenLine(LexerState* lx) 
+{
+    return lexerLineAt(lx, lx->tokStart);
+}
+
+static int currentLine(LexerState* lx) 
+{
+    return lexerLineAt(lx, lx->readPos);
+}
+
+static const char* tokenText(LexerState* lx) 
+{
+    return bufPtr(lx, lx->tokStart);
+}
+
+// Add the character at currentChar, a byte >= 0x80 inside a literal, to the
+// token: all of a UTF-8 sequence, or the one byte with a warning (the first
+// of the literal only, as *reported says)
+static void takeLiteralUtf8(LexerState* lx, const char* what, int* reported)
+{
+    uint32_t cp;
+    int n = currentUtf8(lx, &cp);
+    if (n == 0)
+    {
+        if (!*reported)
+        {
+            lexError(lx, DIAG_BAD_UTF8, lx->readPos - 1, 1, "Warning at line %d: Invalid UTF-8 in %s literal\n", tokenLine(lx), what);
+            *reported = 1;
+        }
+        n = 1;
+    }
+    takeBytes(lx, (size_t)n);
+}
+
+// Take a preprocessor line, from the '#' at tokStart, into the token: up to
+// the newline that ends it (not taken), past any preceded by a backslash
+static void takeDirective(LexerState* lx)
+{
+    while (1)
+    {
+        skipToEndOfLine(lx);
+        if (lx->eofFlag)
+        {
+            break;
+        }
+        // The newline is at readPos - 1, the '#' before it
+        size_t before = lx->readPos - 2;
+        if (bufChar(lx, before) == '\r' && before > lx->tokStart)
+        {
+            before--;
+        }
+        if (bufChar(lx, before) != '\\')
+        {
+            break;
+        }
+        getNextChar(lx);
+    }
+    lx->tokLen = scanPos(lx) - lx->tokStart;
+}
+
+// Mark the (empty) token that signals the end of the input
+static TokenType endOfInput(LexerState* lx) 
+{
+    lx->tokStart = lx->readPos;
+    lx->tokLen = 0;
+    lx->tokKeyword = KW_NONE;
+    lx->tokSymbol = NO_SYMBOL;
+    return UNKNOWN;
+}
+
+// Map a regular file read from its start into lx->srcBuf. Returns 0 if the
+// input has to be streamed instead (pipes, terminals, unmappable files).
+static int mapInput(LexerState* lx) 
+{
+    struct stat st;
+    if (fstat(lx->inputFd, &st) != 0 || !S_ISREG(st.st_mode) || lseek(lx->inputFd, 0, SEEK_CUR) != 0) 
+    {
+        return 0;
+    }
+
+    lx->srcLen = (size_t)st.st_size;
+    if (lx->srcLen == 0) 
+    {
+        lx->srcBuf = "";
+        return 1;
+    }
+
+    void* map = mmap(NULL, lx->srcLen, PROT_READ, MAP_PRIVATE, lx->inputFd, 0);
+    if (map == MAP_FAILED) 
+    {
+        lx->srcLen = 0;
+        return 0;
+    }
+    madvise(map, lx->srcLen, MADV_SEQUENTIAL);
+    lx->srcBuf = map;
+    lx->srcMapped = 1;
+    return 1;
+}
+
+// Set up the window for reading the input in chunks
+static int startStreaming(LexerState* lx) 
+{
+    lx->window = malloc(2 * STREAM_CHUNK_SIZE);
+    if (lx->window == NULL) 
+    {
+        return 0;
+    }
+    lx->windowCap = 2 * STREAM_CHUNK_SIZE;
+    lx->srcBuf = lx->window;
+    lx->streaming = 1;
+    return 1;
+}
+
+
+// --- Function Implementations ---
+
+// Start lexing 'fd' in lx and reset all per-file state. The descriptor is
+// closed with the lexer if 'ownsFd' is set. Returns 0 on failure.
+static int openLexerInput(LexerState* lx, int fd, int ownsFd) 
+{
+    if (lx->errStream == NULL) 
+    {
+        lx->errStream = stderr;
+    }
+    lx->scan = selectScanKernels();
+    lx->inputFd = fd;
+    lx->ownsFd = ownsFd;
+    // Reset input, counts and line number for new file
+    lx->srcBuf = NULL;
+    lx->srcLen = 0;
+    lx->srcBase = 0;
+    lx->srcMapped = 0;
+    lx->streaming = 0;
+    lx->inputEnd = 0;
+    lx->window = NULL;
+    lx->windowCap = 0;
+    lx->keepPos = 0;
+    lx->holdPos = SIZE_MAX;
+    lx->windowed = 0;
+    lx->fileSize = 0;
+    lx->readPos = 0;
+    lx->lookEnd = 0;
+    lx->eofFlag = 0;
+    lx->diags.limit = LEXER_DIAG_LIMIT;
+    lx->diags.dedupe = 1;
+    initLineIndex(&lx->lineIndex, 0, 1, 0);
+    lx->sharedLines = NULL;
+    lx->lineHint = 0;
+    lx->lineFrom = lx->lineTo = 0;
+    lx->cacheChecked = 0;
+    lx->cache = NULL;
+    lx->dialect = LEXER_DEFAULT_DIALECT;
+    if (!mapInput(lx) && !startStreaming(lx)) 
+    {
+        return 0;
+    }
+    getNextChar(lx); // Read the first character
+    lx->paren_count = 0;
+    lx->brace_count = 0;
+    lx->bracket_count = 0;
+    STATS_ONLY(memset(&lx->stats, 0, sizeof(lx->stats));)
+    STATS_ONLY(lx->sampleCountdown = 0;)
+    return 1;
+}
+
+// Open 'filename' into lx. Returns 0 if the file cannot be opened.
+static int openLexerFile(LexerState* lx, const char* filename) 
+{
+    int fd = open(filename, O_RDONLY);
+    if (fd < 0) 
+    {
+        return 0;
+    }
+    if (!openLexerInput(lx, fd, 1)) 
+    {
+        close(fd);
+        return 0;
+    }
+    return 1;
+}
+
+void finishLexerInput(LexerState* lx)
+{
+    // Report any unmatched delimiters at EOF
+    if (lx->paren_count > 0) 
+    {
+        lexError(lx, DIAG_UNCLOSED_DELIMITER, lx->srcLen, 0, "Error at EOF: Missing ')' (unmatched opening parentheses)\n");
+    }
+    if (lx->brace_count > 0) 
+    {
+        lexError(lx, DIAG_UNCLOSED_DELIMITER, lx->srcLen, 0, "Error at EOF: Missing '}' (unmatched opening brace)\n");
+    }
+    if (lx->bracket_count > 0) 
+    {
+        lexError(lx, DIAG_UNCLOSED_DELIMITER, lx->srcLen, 0, "Error at EOF: Missing ']' (unmatched opening bracket)\n");
+    }
+    if (lx->lineIndex.failed)
+    {
+        lexError(lx, DIAG_INPUT, lx->srcLen, 0, "Error: Out of memory indexing lines (some line numbers are wrong)\n");
+    }
+    lx->paren_count = lx->brace_count = lx->bracket_count = 0;
+    closeCacheEntry(lx); // Stores what was recorded, diagnostics included
+}
+
+// Release the input of lx, report any delimiters left open at EOF and print
+// the diagnostics
+static void closeLexerInput(LexerState* lx) 
+{
+    destroySplit(lx);
+    freeLookahead(lx);
+    finishLexerInput(lx);
+    flushLexerDiagnostics(lx);
+    freeDiagLog(&lx->diags);
+    freeLineIndex(&lx->lineIndex);
+
+    if (lx->srcMapped) 
+    {
+        munmap((void*)lx->srcBuf, lx->srcLen);
+    }
+    else if (lx->windowed)
+    {
+        munmap((void*)lx->srcBuf, lx->srcLen - lx->srcBase);
+    }
+    free(lx->window);
+    lx->window = NULL;
+    lx->srcBuf = NULL;
+    lx->srcLen = 0;
+    lx->srcMapped = 0;
+    lx->streaming = 0;
+    lx->windowed = 0;
+    if (lx->ownsFd && lx->inputFd >= 0) 
+    {
+        close(lx->inputFd);
+    }
+    lx->inputFd = -1;
+}
+
+void startBufferLexer(LexerState* lx, const char* buf, size_t len, size_t pos, size_t lineStart, int line)
+{
+    memset(lx, 0, sizeof(*lx));
+    lx->errStream = stderr;
+    lx->scan = selectScanKernels();
+    lx->inputFd = -1;
+    lx->srcBuf = buf;
+    lx->srcLen = len;
+    lx->holdPos = SIZE_MAX;
+    lx->dialect = LEXER_DEFAULT_DIALECT;
+    initLineIndex(&lx->lineIndex, lineStart, line, pos);
+    if (pos < len)
+    {
+        lx->currentChar = buf[pos];
+        lx->readPos = pos + 1;
+    }
+    else
+    {
+        lx->eofFlag = 1;
+        lx->readPos = len;
+    }
+}
+
+LexerState* createLexer(const char* filename) 
+{
+    LexerState* lx = calloc(1, sizeof(LexerState));
+    if (lx == NULL) 
+    {
+        return NULL;
+    }
+    if (!openLexerFile(lx, filename)) 
+    {
+        free(lx);
+        return NULL;
+    }
+    return lx;
+}
+
+LexerState* createLexerFd(int fd) 
+{
+    LexerState* lx = calloc(1, sizeof(LexerState));
+    if (lx == NULL) 
+    {
+        return NULL;
+    }
+    if (!openLexerInput(lx, fd, 0)) 
+    {
+        free(lx);
+        return NULL;
+    }
+    return lx;
+}
+
+void setLexerErrorStream(LexerState* lx, FILE* errStream) 
+{
+    lx->errStream = (errStream != NULL) ? errStream : stderr;
+}
+
+void setLexerInterner(LexerState* lx, Interner* interner) 
+{
+    lx->interner = interner;
+}
+
+void setLexerDirectives(LexerState* lx, int keep)
+{
+    lx->keepDirectives = (keep != 0);
+}
+
+void setLexerDialect(LexerState* lx, LexerDialect dialect)
+{
+    if ((unsigned)dialect < DIALECT_COUNT)
+    {
+        lx->dialect = dialect;
+    }
+}
+
+int parseLexerDialect(const char* name)
+{
+    static const struct {
+        const char* name;
+        LexerDialect dialect;
+    } names[] = {
+        { "c89", DIALECT_C89 }, { "c90", DIALECT_C89 },
+        { "c11", DIALECT_C11 }, { "c17", DIALECT_C11 }, { "c18", DIALECT_C11 },
+        { "c23", DIALECT_C23 }, { "c2x", DIALECT_C23 },
+        { "c++", DIALECT_CPP }, { "cpp", DIALECT_CPP },
+    };
+    for (size_t i = 0; i < sizeof(names) / sizeof(names[0]); i++)
+    {
+        if (strcmp(name, names[i].name) == 0)
+        {
+            return (int)names[i].dialect;
+        }
+    }
+    return -1;
+}
+
+LexerDialect lexerDialectForFile(const char* filename)
+{
+    static const char* const cppExtensions[] = {
+        "cpp", "cc", "cxx", "c++", "hpp", "hh", "hxx", "h++", "ipp", "tpp"
+    };
+    const char* dot = strrchr(filename, '.');
+    if (dot != NULL && strchr(dot, '/') == NULL)
+    {
+        for (size_t i = 0; i < sizeof(cppExtensions) / sizeof(cppExtensions[0]); i++)
+        {
+            if (strcmp(dot + 1, cppExtensions[i]) == 0)
+            {
+                return DIALECT_CPP;
+            }
+        }
+    }
+    return LEXER_DEFAULT_DIALECT;
+}
+
+void setLexerArena(LexerState* lx, Arena* arena)
+{
+    // Too late once either has memory of its own
+    if (lx->diags.capacity == 0 && lx->diags.textCap == 0 && lx->lineIndex.capacity == 0)
+    {
+        lx->diags.arena = arena;
+        lx->lineIndex.arena = arena;
+    }
+}
+
+void setLexerInputWindow(LexerState* lx, size_t bytes)
+{
+    size_t page = (size_t)sysconf(_SC_PAGESIZE);
+    bytes = (bytes + page - 1) & ~(page - 1);
+    if (!lx->srcMapped || lx->readPos != 1 || lx->cacheChecked || lx->split != NULL || bytes == 0 || lx->srcLen <= bytes)
+    {
+        return;
+    }
+    // The first character is in currentChar already; the rest is mapped anew
+    void* map = mmap(NULL, bytes, PROT_READ, MAP_PRIVATE, lx->inputFd, 0);
+    if (map == MAP_FAILED)
+    {
+        return; // Stays mapped whole
+    }
+    madvise(map, bytes, MADV_SEQUENTIAL);
+    munmap((void*)lx->srcBuf, lx->srcLen);
+    lx->fileSize = lx->srcLen;
+    lx->srcBuf = map;
+    lx->srcLen = bytes;
+    lx->srcMapped = 0;
+    lx->streaming = 1;
+    lx->windowed = 1;
+    lx->windowCap = bytes;
+}
+
+void destroyLexer(LexerState* lx) 
+{
+    if (lx == NULL) 
+    {
+        return;
+    }
+    closeLexerInput(lx);
+    free(lx);
+}
+
+void initializeLexer(const char* filename) 
+{
+    if (!openLexerFile(&defaultLexer, filename)) 
+    {
+        fprintf(stderr, "Error: Could not open file '%s'\n", filename);
+        exit(EXIT_FAILURE);
+    }
+    if (legacyBanners)
+    {
+        printf("Open   : %s : Success\n", filename);
+    }
+}
+
+void setLexerBanners(int enabled)
+{
+    legacyBanners = enabled;
+}
+
+void closeLexer() 
+{
+    if (defaultLexer.errStream != NULL) 
+    {
+        closeLexerInput(&defaultLexer);
+    }
+}
+
+// Returns the KeywordId of str, or KW_NONE (0) if it is not a keyword
+int isKeyword(const char* str) 
+{
+    return lookupKeyword(str, strlen(str));
+}
+
+int isOperator(const char* str)
+{
+    // Walk the lexer's DFA (of the default dialect) over the whole string
+    unsigned state = DFA_START;
+    for (; *str != '\0' && state != DFA_DEAD; str++)
+    {
+        state = dfaNextC23[state][dfaByteClassC23[(unsigned char)*str]];
+    }
+    return dfaAcceptC23[state] == DFA_OPERATOR;
+}
+
+// Check if a character is one of the designated 'SYMBOL' characters
+int isSymbolCharacter(char ch)
+{
+    return charClass(ch) == CC_SYMBOL;
+}
+
+int isConstant(const char* str)
+{
+    // This function is less relevant now as type is assigned directly in getNextToken
+    if (charHas(str[0], CF_DIGIT))
+    {
+        for (int i = 1; str[i] != '\0'; i++)
+        {
+            if (!charHas(str[i], CF_DIGIT))
+            {
+                return 0;
+            }
+        }
+        return 1;
+    }
+    return 0;
+}
+
+// UTF-8 names count too: XID_Start, then XID_Continue characters (C23)
+int isIdentifier(const char* str)
+{
+    if (charClass(str[0]) != CC_ALPHA && charClass(str[0]) != CC_UTF8)
+    {
+        return 0;
+    }
+    const char* end = str + strlen(str);
+    for (const char* p = str; p < end;)
+    {
+        uint32_t cp;
+        int n = decodeUtf8(p, end, &cp);
+        if (n == 0)
+        {
+            return 0;
+        }
+        if (n == 1 ? !charHas(*p, CF_IDENT) : !(p == str ? isXidStart(cp) : isXidContinue(cp))) {
+            return 0;
+        }
+        p += n;
+    }
+    return 1;
+}
+
+void categorizeToken(Token* token)
+{
+    // This function is mostly a placeholder now as getNextToken directly assigns types.
+    // The classifiers below work on NUL-terminated strings, so copy the view first.
+    size_t len = token->length;
+    char* text = malloc(len + 1);
+    if (text == NULL)
+    {
+        token->type = UNKNOWN;
+        return;
+    }
+    memcpy(text, token->lexeme, len);
+    text[len] = '\0';
+
+    if (isKeyword(text))
+    {
+        token->type = KEYWORD;
+    }
+    else if (isIdentifier(text))
+    {
+        token->type = IDENTIFIER;
+    }
+    else if (isConstant(text))
+    {
+        token->type = INTEGRAL_CONSTANT;
+    }
+    else if (isOperator(text))
+    {
+        token->type = OPERATOR;
+    }
+    else if (isSymbolCharacter(text[0]) && len == 1)
+    {
+        token->type = SYMBOL;
+    }
+    else
+    {
+        token->type = UNKNOWN;
+    }
+    free(text);
+}
+
+// --- Token scanners, one per character class that can start a token ---
+// Each is entered with currentChar on the first character of the token.
+
+// --- Dialects ---
+// The scanner from here on takes the dialect as a parameter and is inlined
+// into one instance per dialect (DIALECT_SCANNER below), where it is a
+// constant: these switches fold into direct reads of that dialect's tables.
+#define ALWAYS_INLINE inline __attribute__((always_inline))
+
+static ALWAYS_INLINE KeywordId dialectKeyword(LexerDialect dialect, const char* str, size_t len)
+{
+    switch (dialect)
+    {
+        case DIALECT_C89: return lookupKeywordC89(str, len);
+        case DIALECT_C11: return lookupKeywordC11(str, len);
+        case DIALECT_CPP: return lookupKeywordCpp(str, len);
+        default:          return lookupKeywordC23(str, len);
+    }
+}
+
+static ALWAYS_INLINE unsigned dfaStep(LexerDialect dialect, unsigned state, unsigned char c)
+{
+    switch (dialect)
+    {
+        case DIALECT_C89: return dfaNextC89[state][dfaByteClassC89[c]];
+        case DIALECT_C11: return dfaNextC11[state][dfaByteClassC11[c]];
+        case DIALECT_CPP: return dfaNextCpp[state][dfaByteClassCpp[c]];
+        default:          return dfaNextC23[state][dfaByteClassC23[c]];
+    }
+}
+
+static ALWAYS_INLINE DfaKind dfaAccepts(LexerDialect dialect, unsigned state)
+{
+    switch (dialect)
+    {
+        case DIALECT_C89: return (DfaKind)dfaAcceptC89[state];
+        case DIALECT_C11: return (DfaKind)dfaAcceptC11[state];
+        case DIALECT_CPP: return (DfaKind)dfaAcceptCpp[state];
+        default:          return (DfaKind)dfaAcceptC23[state];
+    }
+}
+
+// Returned by a scanner that skipped a broken literal instead of producing a
+// token: the scan starts again after it (a loop, not a recursive call, so a
+// file of broken lines needs no stack)
+#define NO_TOKEN ((TokenType)(UNKNOWN + 1))
 
-// --- Helper function to get the next character ---
-static void getNextChar() 
+// String literals (e.g., "Hello World\n")
+static TokenType lexString(LexerState* lx)
 {
-    if (!eofFlag) 
+    int reported = 0;
+    takeChar(lx);
+    while (lx->currentChar != '"' && lx->currentChar != '\n' && !lx->eofFlag)
     {
-        int c = fgetc(inputFile);
-        if (c == EOF) 
-        {
-            eofFlag = 1;
-            currentChar = '\0'; // Null terminator to signify end
-        } 
-        else 
+        if (lx->currentChar == '\\')
         {
-            currentChar = (char)c;
-            if (currentChar == '\n')
+            takeChar(lx);
+            if (!lx->eofFlag && charClass(lx->currentChar) != CC_UTF8)
             {
-                lineNum++; // Increment line number on newline
+                takeChar(lx);
             }
         }
+        else if (charClass(lx->currentChar) == CC_UTF8)
+        {
+            takeLiteralUtf8(lx, "string", &reported);
+        }
+        else
+        {
+            takeLiteralRun(lx, '"'); // Stops at the bytes >= 0x80 too
+        }
+    }
+    if (lx->currentChar == '"')
+    {
+        takeChar(lx);
+        return CONSTANT; // String literal is a generic constant type
     }
-}
-
-
-// --- Function Implementations ---
 
-void initializeLexer(const char* filename) 
-{
-    inputFile = fopen(filename, "r");
-    if (inputFile == NULL) 
+    // Unclosed string, the error message will be detailed
+    lexError(lx, DIAG_UNCLOSED_STRING, lx->tokStart, lx->tokLen, "Error at line %d: Missing '\"' (unclosed string literal) after \"%.*s\n", tokenLine(lx), (int)lx->tokLen, tokenText(lx));
+    skipToEndOfLine(lx);
+    if (lx->currentChar == '\n')
     {
-        fprintf(stderr, "Error: Could not open file '%s'\n", filename);
-        exit(EXIT_FAILURE);
+        getNextChar(lx);
     }
-    printf("Open   : %s : Success\n", filename);
-    getNextChar(); // Read the first character
-    // Reset counts and line number for new file
-    paren_count = 0;
-    brace_count = 0;
-    bracket_count = 0;
-    lineNum = 1;
+    return NO_TOKEN;
 }
 
-void closeLexer() 
+// Character literals (e.g., 'a', '\n')
+static TokenType lexChar(LexerState* lx)
 {
-    if (inputFile != NULL) 
-    {
-        fclose(inputFile);
-        inputFile = NULL;
+    takeChar(lx); // Store opening quote
+
+    // Handle content (single character or escape sequence)
+    if (lx->currentChar == '\\')
+    { // Escape sequence
+        takeChar(lx);
+        if (!lx->eofFlag && (lx->currentChar == '\'' || lx->currentChar == '\\' || lx->currentChar == 'n' ||
+                             lx->currentChar == 't' || lx->currentChar == 'b' || lx->currentChar == 'r' ||
+                             lx->currentChar == 'f' || lx->currentChar == 'a' || lx->currentChar == 'v' ||
+                             charHas(lx->currentChar, CF_DIGIT)))
+                             {
+            takeChar(lx);
+        }
+        else
+        {
+            lexError(lx, DIAG_BAD_ESCAPE, lx->tokStart + 1, lx->eofFlag ? 1 : 2, "Warning at line %d: Invalid escape sequence in character literal\n", tokenLine(lx));
+            if(!lx->eofFlag) { takeChar(lx); }
+        }
     }
-    // Report any unmatched delimiters at EOF
-    if (paren_count > 0) 
+    else if (charClass(lx->currentChar) == CC_UTF8) // Single UTF-8 character
     {
-        fprintf(stderr, "Error at EOF: Missing ')' (unmatched opening parentheses)\n");
+        int reported = 0;
+        takeLiteralUtf8(lx, "character", &reported);
     }
-    if (brace_count > 0) 
+    else if (lx->currentChar != '\'' && !lx->eofFlag && lx->currentChar != '\n') // Single character
     {
-        fprintf(stderr, "Error at EOF: Missing '}' (unmatched opening brace)\n");
+        takeChar(lx);
+    }
+
+    if (lx->currentChar == '\'')
+    { // Closing quote
+        takeChar(lx);
+        return CONSTANT; // Character literal is a generic constant type
     }
-    if (bracket_count > 0) 
+
+    // Unclosed char literal
+    lexError(lx, DIAG_UNCLOSED_CHAR, lx->tokStart, lx->tokLen, "Error at line %d: Missing ''' (unclosed character literal) after '%.*s\n", tokenLine(lx), (int)lx->tokLen, tokenText(lx));
+    while (lx->currentChar != '\n' && !lx->eofFlag && lx->currentChar != ';')
     {
-        fprintf(stderr, "Error at EOF: Missing ']' (unmatched opening bracket)\n");
+        getNextChar(lx);
     }
+    if (lx->currentChar == '\n') getNextChar(lx);
+    return NO_TOKEN;
 }
 
-int isKeyword(const char* str) 
+#define RAW_DELIMITER_MAX 16
+
+// C++ raw string prefixes: R, with or without an encoding prefix
+static int isRawStringPrefix(const char* str, size_t len)
 {
-    for (int i = 0; i < MAX_KEYWORDS; i++) 
+    return (len == 1 && str[0] == 'R') ||
+           (len == 2 && str[1] == 'R' && (str[0] == 'L' || str[0] == 'u' || str[0] == 'U')) ||
+           (len == 3 && str[0] == 'u' && str[1] == '8' && str[2] == 'R');
+}
+
+// C++ raw string literals (e.g., R"x(a\b)x"): the token holds the prefix
+// already and currentChar is the '"'. Nothing in the body is an escape and
+// newlines are part of it; only ')' followed by the delimiter and '"' ends it.
+static TokenType lexRawString(LexerState* lx)
+{
+    char delim[RAW_DELIMITER_MAX];
+    size_t delimLen = 0;
+    takeChar(lx);
+    while (!lx->eofFlag && delimLen < RAW_DELIMITER_MAX && lx->currentChar > ' ' && lx->currentChar < 0x7F &&
+           lx->currentChar != '(' && lx->currentChar != ')' && lx->currentChar != '\\')
     {
-        if (keywords[i] == NULL) 
-        {
-            break;
-        }
-        if (strcmp(str, keywords[i]) == 0) 
+        delim[delimLen++] = lx->currentChar;
+        takeChar(lx);
+    }
+    if (lx->eofFlag || lx->currentChar != '(')
+    {
+        lexError(lx, DIAG_UNCLOSED_STRING, lx->tokStart, lx->tokLen, "Error at line %d: Invalid delimiter in raw string literal %.*s\n", tokenLine(lx), (int)lx->tokLen, tokenText(lx));
+        skipToEndOfLine(lx);
+        if (lx->currentChar == '\n')
         {
-            return 1;
+            getNextChar(lx);
         }
+        return NO_TOKEN;
     }
-    return 0;
-}
+    takeChar(lx);
 
-int isOperator(const char* str) 
-{
-    if (strlen(str) == 1) 
+    int reported = 0;
+    while (!lx->eofFlag)
     {
-        for (int i = 0; operators[i] != '\0'; i++) 
+        if (lx->currentChar == ')')
         {
-            if (str[0] == operators[i]) 
+            takeChar(lx);
+            size_t i = 0;
+            while (i < delimLen && !lx->eofFlag && lx->currentChar == delim[i])
             {
-                return 1;
+                takeChar(lx);
+                i++;
             }
+            if (i == delimLen && !lx->eofFlag && lx->currentChar == '"')
+            {
+                takeChar(lx);
+                return CONSTANT;
+            }
+        }
+        else if (charClass(lx->currentChar) == CC_UTF8)
+        {
+            takeLiteralUtf8(lx, "string", &reported);
+        }
+        else if (lx->currentChar == '\\' || lx->currentChar == '\n')
+        {
+            takeChar(lx);
+        }
+        else
+        {
+            takeLiteralRun(lx, ')'); // Stops at the characters above too
         }
     }
-    return 0;
+
+    // Unclosed: it has taken the rest of the input
+    lexError(lx, DIAG_UNCLOSED_STRING, lx->tokStart, lx->tokLen, "Error at line %d: Missing ')%.*s\"' (unclosed raw string literal)\n", tokenLine(lx), (int)delimLen, delim);
+    return NO_TOKEN;
 }
 
-// Check if a character is one of the designated 'SYMBOL' characters
-int isSymbolCharacter(char ch) 
+// Identifiers and keywords. The class table only sends letters and '_' here
+// (and UTF-8 XID_Start characters, see takeXidStart) and only identifier
+// characters are taken, so the result is always a valid identifier. In C++
+// an identifier that is a raw string prefix, right before a '"', begins one.
+static ALWAYS_INLINE TokenType finishIdentifier(LexerState* lx, LexerDialect dialect)
 {
-    for (int i = 0; symbols[i] != '\0'; i++) 
+    takeIdentifierRest(lx);
+
+    if (dialect == DIALECT_CPP && lx->currentChar == '"' && !lx->eofFlag && isRawStringPrefix(tokenText(lx), lx->tokLen))
     {
-        if (ch == symbols[i]) 
-        {
-            return 1;
-        }
+        return lexRawString(lx);
     }
-    return 0;
+    lx->tokKeyword = dialectKeyword(dialect, tokenText(lx), lx->tokLen);
+    if (lx->tokKeyword != KW_NONE)
+    {
+        return KEYWORD;
+    }
+    if (lx->interner != NULL)
+    {
+        lx->tokSymbol = internString(lx->interner, tokenText(lx), lx->tokLen);
+    }
+    return IDENTIFIER;
 }
 
-int isConstant(const char* str) 
+static ALWAYS_INLINE TokenType lexIdentifier(LexerState* lx, LexerDialect dialect)
 {
-    // This function is less relevant now as type is assigned directly in getNextToken
-    if (isdigit(str[0])) 
+    takeChar(lx);
+    return finishIdentifier(lx, dialect);
+}
+
+// A byte >= 0x80 outside literals and comments: take it if it is a UTF-8
+// XID_Start character, which begins an identifier
+static int takeXidStart(LexerState* lx)
+{
+    uint32_t cp;
+    int n = currentUtf8(lx, &cp);
+    if (n > 0 && isXidStart(cp))
     {
-        for (int i = 1; str[i] != '\0'; i++) 
-        {
-            if (!isdigit(str[i])) 
-            {
-                return 0;
-            }
-        }
+        takeBytes(lx, (size_t)n);
         return 1;
     }
     return 0;
 }
 
-int isIdentifier(const char* str) 
+// A byte >= 0x80 outside literals and comments that cannot begin an
+// identifier: the run of non-ASCII characters that cannot is a single
+// UNKNOWN token, with a single warning.
+static TokenType lexNonAscii(LexerState* lx)
 {
-    if (!isalpha(str[0]) && str[0] != '_') 
+    uint32_t cp, first = 0;
+    int n = currentUtf8(lx, &cp);
+    size_t invalid = SIZE_MAX; // The first byte that is not UTF-8
+    do
     {
-        return 0;
+        if (n == 0)
+        {
+            invalid = (invalid == SIZE_MAX) ? lx->readPos - 1 : invalid;
+            n = 1;
+        }
+        else if (first == 0)
+        {
+            first = cp;
+        }
+        takeBytes(lx, (size_t)n);
+        if (charClass(lx->currentChar) != CC_UTF8)
+        {
+            break;
+        }
+        n = currentUtf8(lx, &cp);
+    } while (n == 0 || !isXidStart(cp));
+
+    if (invalid != SIZE_MAX)
+    {
+        lexError(lx, DIAG_BAD_UTF8, invalid, 1, "Warning at line %d: Invalid UTF-8 byte 0x%02X\n", tokenLine(lx), (unsigned char)bufChar(lx, invalid));
     }
-    for (int i = 1; str[i] != '\0'; i++) 
+    else
     {
-        if (!isalnum(str[i]) && str[i] != '_') {
-            return 0;
-        }
+        lexError(lx, DIAG_UNKNOWN_CHARACTER, lx->tokStart, lx->tokLen, "Warning: Unknown character U+%04X at line %d\n", (unsigned)first, tokenLine(lx));
     }
-    return 1;
+    return UNKNOWN;
 }
 
-void categorizeToken(Token* token) 
+// --- Operators, symbols and numbers: the generated DFA (lexer_dfa.c) ---
+// Run the DFA from currentChar and return the kind of the longest match
+// (DFA_NONE if there is none), leaving its end in *end.
+static ALWAYS_INLINE DfaKind runDfa(LexerState* lx, LexerDialect dialect, size_t* end)
 {
-    // This function is mostly a placeholder now as getNextToken directly assigns types.
-    if (isKeyword(token->lexeme)) 
+    size_t pos = lx->tokStart;
+    unsigned state = DFA_START;
+    DfaKind kind = DFA_NONE;
+    *end = pos;
+    while (pos < lx->srcLen || refillInput(lx))
     {
-        token->type = KEYWORD;
-    } 
-    else if (isIdentifier(token->lexeme)) 
+        state = dfaStep(dialect, state, (unsigned char)bufChar(lx, pos));
+        if (state == DFA_DEAD)
+        {
+            break;
+        }
+        pos++;
+        if (dfaAccepts(dialect, state) != DFA_NONE)
+        {
+            kind = dfaAccepts(dialect, state);
+            *end = pos;
+        }
+    }
+    lx->lookEnd = pos + 1; // The byte that ended the walk (or the end of the input)
+    return kind;
+}
+
+#ifdef LEXER_STATS
+// LexerStats.numberBases slot of each number kind (-1: not a number)
+static const signed char dfaNumberBase[DFA_KIND_COUNT] = {
+    [DFA_NONE] = -1, [DFA_OPERATOR] = -1, [DFA_SYMBOL] = -1,
+    [DFA_DECIMAL] = 0, [DFA_FLOAT] = 0, [DFA_OCTAL] = 1, [DFA_OCTAL_DIGIT] = 1,
+    [DFA_HEX] = 2, [DFA_HEXFLOAT] = 2, [DFA_HEX_EMPTY] = 2, [DFA_BINARY] = 3, [DFA_BINARY_EMPTY] = 3
+};
+#endif
+
+// Open/close delimiter counts, with a simple check for premature closing
+static TokenType countDelimiter(LexerState* lx, char ch)
+{
+    if (lx->noDelimiters)
     {
-        token->type = IDENTIFIER;
-    } 
-    else if (isConstant(token->lexeme)) 
+        return SYMBOL;
+    }
+    switch (ch)
     {
-        token->type = INTEGRAL_CONSTANT;
-    } 
-    else if (isOperator(token->lexeme)) 
+        case '(': lx->paren_count++; break;
+        case ')': lx->paren_count--; break;
+        case '{': lx->brace_count++; break;
+        case '}': lx->brace_count--; break;
+        case '[': lx->bracket_count++; break;
+        case ']': lx->bracket_count--; break;
+    }
+
+    if (lx->paren_count < 0)
     {
-        token->type = OPERATOR;
-    } 
-    else if (isSymbolCharacter(token->lexeme[0]) && strlen(token->lexeme) == 1) 
+        lexError(lx, DIAG_UNMATCHED_CLOSE, lx->tokStart, 1, "Error at line %d: Unmatched ')'\n", currentLine(lx));
+        lx->paren_count = 0;
+    }
+    if (lx->brace_count < 0)
     {
-        token->type = SYMBOL;
-    } 
-    else 
+        lexError(lx, DIAG_UNMATCHED_CLOSE, lx->tokStart, 1, "Error at line %d: Unmatched '}'\n", currentLine(lx));
+        lx->brace_count = 0;
+    }
+    if (lx->bracket_count < 0)
     {
-        token->type = UNKNOWN;
+        lexError(lx, DIAG_UNMATCHED_CLOSE, lx->tokStart, 1, "Error at line %d: Unmatched ']'\n", currentLine(lx));
+        lx->bracket_count = 0;
     }
+    return SYMBOL;
 }
 
-Token getNextToken() 
+// Operators, symbols and numeric constants: everything tools/tokens.spec
+// describes. The DFA (runDfa) finds the longest match, of kind 'kind' and
+// ending at 'end'; the kind says what to report.
+static TokenType lexDfa(LexerState* lx, DfaKind kind, size_t end)
 {
-    Token token;
-    memset(&token, 0, sizeof(Token));
-
-    while (1) 
+    char first = lx->currentChar;
+    if (kind == DFA_NONE)
     {
-        // Skip whitespace
-        while (isspace(currentChar) && !eofFlag) 
+        // Not the start of any token: the character after it becomes an UNKNOWN token
+        getNextChar(lx);
+        if (!lx->eofFlag)
         {
-            getNextChar();
+            beginToken(lx);
+            lexError(lx, DIAG_UNKNOWN_CHARACTER, lx->tokStart, 1, "Warning: Unknown token '%c' at line %d\n", lx->currentChar, currentLine(lx));
+            takeChar(lx);
+            return UNKNOWN;
         }
+        return endOfInput(lx);
+    }
+    lx->tokLen = end - lx->tokStart;
+    seekBuffer(lx, end);
+    STATS_ONLY(if (dfaNumberBase[kind] >= 0) lx->stats.numberBases[dfaNumberBase[kind]]++;)
+
+    switch (kind)
+    {
+        case DFA_OPERATOR:
+            return OPERATOR;
+        case DFA_SYMBOL:
+            return countDelimiter(lx, first);
+        case DFA_HEX_EMPTY:
+            lexError(lx, DIAG_BAD_NUMBER, lx->tokStart, lx->tokLen, "Error at line %d: Hexadecimal literal '0%c' must be followed by hexadecimal digits (0-9, A-F).\n", tokenLine(lx), tokenText(lx)[1]);
+            return INVALID_NUMBER;
+        case DFA_BINARY_EMPTY:
+            lexError(lx, DIAG_BAD_NUMBER, lx->tokStart, lx->tokLen, "Error at line %d: Binary literal '0%c' must be followed by binary digits (0 or 1).\n", tokenLine(lx), tokenText(lx)[1]);
+            return INVALID_NUMBER;
+        case DFA_OCTAL_DIGIT:
+            lexError(lx, DIAG_BAD_NUMBER, lx->tokStart, lx->tokLen, "Error at line %d: Invalid digit '%c' in octal literal '0%.*s'. Octal digits must be 0-7.\n", tokenLine(lx), tokenText(lx)[lx->tokLen - 1], (int)lx->tokLen - 2, tokenText(lx) + 1);
+            // Consume the rest of the invalid number-like sequence
+            while (charHas(lx->currentChar, CF_ALNUM) && !lx->eofFlag)
+            {
+                getNextChar(lx);
+            }
+            return INVALID_NUMBER;
+        default:
+            break;
+    }
+
+    // A valid number; one running straight into an identifier character
+    // (a UTF-8 XID_Continue one included) is not
+    uint32_t cp;
+    int width = charHas(lx->currentChar, CF_IDENT) ? 1 : 0;
+    if (charClass(lx->currentChar) == CC_UTF8 && (width = currentUtf8(lx, &cp)) > 0 && !isXidContinue(cp))
+    {
+        width = 0;
+    }
+    if (width > 0)
+    {
+        static const char* const baseNames[DFA_KIND_COUNT] = {
+            [DFA_DECIMAL] = "decimal", [DFA_OCTAL] = "octal", [DFA_HEX] = "hexadecimal",
+            [DFA_BINARY] = "binary", [DFA_FLOAT] = "floating", [DFA_HEXFLOAT] = "floating"
+        };
+        size_t at = lx->readPos - 1;
+        lexError(lx, DIAG_BAD_NUMBER, lx->tokStart, lx->tokLen + (size_t)width, "Error at line %d: Invalid character '%.*s' in %s literal '%.*s'.\n", tokenLine(lx), width, bufPtr(lx, at), baseNames[kind], (int)lx->tokLen, tokenText(lx));
+        seekBuffer(lx, at + (size_t)width); // Consume the invalid character
+        return INVALID_NUMBER;
+    }
+    return dfaKindType[kind];
+}
+
+size_t lexerScanReach(const LexerState* lx)
+{
+    size_t reach = lx->eofFlag ? lx->srcLen + 1 : lx->readPos;
+    return (lx->lookEnd > reach) ? lx->lookEnd : reach;
+}
+
+// Scan up to the next token into tokStart/tokLen/tokKeyword and return
+// its type, or NO_TOKEN after skipping a broken literal
+static ALWAYS_INLINE TokenType scanOnce(LexerState* lx, LexerDialect dialect)
+{
+    int cls;
+    while (1)
+    {
+        STATS_ONLY(size_t spaceFrom = scanPos(lx);)
+        skipSpace(lx);
+        STAT_ADD(lx, whitespaceBytes, scanPos(lx) - spaceFrom);
 
         // If EOF is reached after skipping, return UNKNOWN with empty lexeme
-        if (eofFlag) 
+        if (lx->eofFlag)
         {
-            token.type = UNKNOWN;
-            strcpy(token.lexeme, "");
-            return token;
+            return endOfInput(lx);
         }
 
+        cls = charClass(lx->currentChar);
+
         // --- Handle Preprocessor Directives (lines starting with #) ---
-        if (currentChar == '#') 
+        if (cls == CC_HASH)
         {
-            while (currentChar != '\n' && !eofFlag) 
+            STATS_ONLY(size_t lineFrom = scanPos(lx);)
+            if (lx->keepDirectives)
             {
-                getNextChar();
+                beginToken(lx);
+                takeDirective(lx);
+                STAT_ADD(lx, preprocessorBytes, lx->tokLen);
+                return DIRECTIVE;
             }
-            if (currentChar == '\n') 
+            skipToEndOfLine(lx);
+            if (lx->currentChar == '\n')
             {
-                getNextChar();
+                getNextChar(lx);
             }
+            STAT_ADD(lx, preprocessorBytes, scanPos(lx) - lineFrom);
             continue;
         }
 
         // --- Handle Comments ---
-        if (currentChar == '/') 
+        if (cls == CC_SLASH)
         {
-            char next = fgetc(inputFile);
-            if (next == EOF) 
-            {
-                ungetc(next, inputFile);
-                break;
-            }
-            ungetc(next, inputFile);
-
-            if (next == '/') 
+            STATS_ONLY(size_t commentFrom = scanPos(lx);)
+            int next = peekChar(lx);
+            if (next == '/')
             { // Single-line comment //
-                getNextChar();
-                getNextChar();
-                while (currentChar != '\n' && !eofFlag) 
-                {
-                    getNextChar();
-                }
-                if (currentChar == '\n') 
+                getNextChar(lx);
+                getNextChar(lx);
+                skipToEndOfLine(lx);
+                if (lx->currentChar == '\n')
                 {
-                    getNextChar();
+                    getNextChar(lx);
                 }
+                STAT_ADD(lx, commentBytes, scanPos(lx) - commentFrom);
                 continue;
-            } 
-            else if (next == '*') 
+            }
+            else if (next == '*')
             { // Multi-line comment /* ... */
-                getNextChar();
-                getNextChar();
-                int prevChar = 0;
-                while (!eofFlag && !(prevChar == '*' && currentChar == '/')) 
-                {
-                    prevChar = currentChar;
-                    getNextChar();
-                }
-                if (eofFlag) 
+                size_t commentStart = lx->readPos - 1;
+                getNextChar(lx);
+                getNextChar(lx);
+                if (!skipBlockComment(lx))
                 {
-                    fprintf(stderr, "Error at line %d: Unclosed multi-line comment '/*'\n", lineNum);
-                    token.type = UNKNOWN;
-                    strcpy(token.lexeme, "");
-                    return token;
+                    STAT_ADD(lx, commentBytes, scanPos(lx) - commentFrom);
+                    lexError(lx, DIAG_UNCLOSED_COMMENT, commentStart, lx->srcLen - commentStart, "Error at line %d: Unclosed multi-line comment '/*'\n", currentLine(lx));
+                    return endOfInput(lx);
                 }
-                getNextChar(); // Consume the '/' of "*/"
+                getNextChar(lx); // Consume the '/' of "*/"
+                STAT_ADD(lx, commentBytes, scanPos(lx) - commentFrom);
                 continue;
             }
         }
@@ -278,359 +1476,212 @@ Token getNextToken()
     }
 
     // Now, actual tokenization logic starts after skipping leading non-code elements
-    // 1. Check for string literals (e.g., "Hello World\n")
-    if (currentChar == '"') 
+    beginToken(lx);
+    switch (cls)
     {
-        int i = 0;
-        int startLine = lineNum;
-        token.lexeme[i++] = currentChar;
-        getNextChar();
-        while (currentChar != '"' && currentChar != '\n' && !eofFlag && i < MAX_TOKEN_SIZE - 2) 
-        {
-            if (currentChar == '\\') 
-            {
-                token.lexeme[i++] = currentChar;
-                getNextChar();
-                if (!eofFlag) 
-                {
-                    token.lexeme[i++] = currentChar;
-                    getNextChar();
-                }
-            } 
-            else 
-            {
-                token.lexeme[i++] = currentChar;
-                getNextChar();
-            }
-        }
-        if (currentChar == '"') 
-        {
-            token.lexeme[i++] = currentChar;
-            getNextChar();
-            token.lexeme[i] = '\0';
-            token.type = CONSTANT; // String literal is a generic constant type
-            return token;
-        } 
-        else 
+        case CC_DQUOTE:
+            return lexString(lx);
+        case CC_SQUOTE:
+            return lexChar(lx);
+        case CC_ALPHA:
+            return lexIdentifier(lx, dialect);
+        case CC_UTF8:
+            return takeXidStart(lx) ? finishIdentifier(lx, dialect) : lexNonAscii(lx);
+        default:
         {
-            token.type = UNKNOWN; // Remains UNKNOWN for unclosed string, but error message will be detailed
-            token.lexeme[i] = '\0';
-            fprintf(stderr, "Error at line %d: Missing '\"' (unclosed string literal) after \"%s\n", startLine, token.lexeme);
-            while (currentChar != '\n' && !eofFlag) 
-            {
-                getNextChar();
-            }
-            if (currentChar == '\n') 
-            {
-                getNextChar();
-            }
-            return getNextToken();
+            size_t end;
+            DfaKind kind = runDfa(lx, dialect, &end);
+            return lexDfa(lx, kind, end);
         }
     }
+}
 
-    // 2. Check for character literals (e.g., 'a', '\n')
-    if (currentChar == '\'') 
+// Scan one token and return its type. An UNKNOWN token of length 0 marks the
+// end of the input.
+static ALWAYS_INLINE TokenType scanToken(LexerState* lx, LexerDialect dialect)
+{
+    TokenType type;
+    do
     {
-        int i = 0;
-        int startLine = lineNum;
-        token.lexeme[i++] = currentChar; // Store opening quote
-        getNextChar();
+        type = scanOnce(lx, dialect);
+    } while (type == NO_TOKEN);
+    return type;
+}
 
-        // Handle content (single character or escape sequence)
-        if (currentChar == '\\') 
-        { // Escape sequence
-            token.lexeme[i++] = currentChar;
-            getNextChar();
-            if (!eofFlag && (currentChar == '\'' || currentChar == '\\' || currentChar == 'n' ||
-                             currentChar == 't' || currentChar == 'b' || currentChar == 'r' ||
-                             currentChar == 'f' || currentChar == 'a' || currentChar == 'v' ||
-                             isdigit(currentChar))) 
-                             {
-                token.lexeme[i++] = currentChar;
-                getNextChar();
-            } 
-            else 
-            {
-                fprintf(stderr, "Warning at line %d: Invalid escape sequence in character literal\n", startLine);
-                if(!eofFlag) { token.lexeme[i++] = currentChar; getNextChar(); }
-            }
-        } 
-        else if (currentChar != '\'' && !eofFlag && currentChar != '\n') // Single character
-        { 
-            token.lexeme[i++] = currentChar;
-            getNextChar();
-        }
-
-        if (currentChar == '\'') 
-        { // Closing quote
-            token.lexeme[i++] = currentChar;
-            getNextChar();
-            token.lexeme[i] = '\0';
-            token.type = CONSTANT; // Character literal is a generic constant type
-            return token;
-        } 
-        else 
+// scanToken() plus the LEXER_STATS counters: every token is counted, and
+// one in LEXER_STATS_SAMPLE is timed
+static ALWAYS_INLINE TokenType scanCounted(LexerState* lx, LexerDialect dialect)
+{
+#ifdef LEXER_STATS
+    TokenType type;
+    if (lx->sampleCountdown-- == 0)
+    {
+        lx->sampleCountdown = LEXER_STATS_SAMPLE - 1;
+        uint64_t start = statsClock();
+        type = scanToken(lx, dialect);
+        uint64_t ticks = statsClock() - start;
+        if (lx->tokLen > 0)
         {
-            token.type = UNKNOWN; // Remains UNKNOWN for unclosed char literal
-            token.lexeme[i] = '\0';
-            fprintf(stderr, "Error at line %d: Missing ''' (unclosed character literal) after '%s\n", startLine, token.lexeme);
-            while (currentChar != '\n' && !eofFlag && currentChar != ';') 
-            {
-                getNextChar();
-            }
-            if (currentChar == '\n') getNextChar();
-            return getNextToken();
+            lx->stats.sampledTicks[type] += ticks;
+            lx->stats.sampled[type]++;
         }
     }
-
-    // 3. Check for identifiers and keywords
-    if (isalpha(currentChar) || currentChar == '_') 
+    else
     {
-        int i = 0;
-        int startLine = lineNum; // Store line for identifier error
-        token.lexeme[i++] = currentChar;
-        getNextChar();
-        while ((isalnum(currentChar) || currentChar == '_') && !eofFlag && i < MAX_TOKEN_SIZE - 1) 
-        {
-            token.lexeme[i++] = currentChar;
-            getNextChar();
-        }
-        token.lexeme[i] = '\0';
-
-        // Validate the identifier after it's fully read
-        if (!isIdentifier(token.lexeme)) // isIdentifier checks starting char, but this is a double check
-        { 
-            fprintf(stderr, "Error at line %d: Invalid identifier '%s'. Identifiers must start with a letter or underscore.\n", startLine, token.lexeme);
-            token.type = UNKNOWN; // Mark as UNKNOWN because it's fundamentally not an identifier
-            return token;
-        }
-
-        if (isKeyword(token.lexeme)) 
-        {
-            token.type = KEYWORD;
-        } 
-        else 
-        {
-            token.type = IDENTIFIER;
-        }
-        return token;
+        type = scanToken(lx, dialect);
     }
-
-    // 4. Check for numeric constants (Integral_Constant with base validation)
-    if (isdigit(currentChar)) 
+    if (lx->tokLen > 0)
     {
-        int i = 0;
-        int startLine = lineNum;
-        token.lexeme[i++] = currentChar;
-        getNextChar();
+        countToken(&lx->stats, type, lx->tokLen);
+    }
+    return type;
+#else
+    return scanToken(lx, dialect);
+#endif
+}
+
+// --- Batch interface ---
 
-        // Handle 0x (hexadecimal) and 0b (binary) prefixes
-        if (token.lexeme[0] == '0' && (currentChar == 'x' || currentChar == 'X')) 
+// Shared by nextTokens() and the one-entry batch in nextToken(), inlined
+// into each dialect's instance
+static ALWAYS_INLINE size_t fillBatch(LexerState* lx, TokenBatch* batch, LexerDialect dialect)
+{
+    // A streamed input keeps the text of this batch in its window
+    size_t keep = lx->eofFlag ? lx->srcLen : lx->readPos - 1;
+    lx->keepPos = (keep < lx->holdPos) ? keep : lx->holdPos;
+    size_t n = 0;
+    while (n < batch->capacity)
+    {
+        TokenType type = scanCounted(lx, dialect);
+        if (type == UNKNOWN && lx->tokLen == 0)
         {
-            token.lexeme[i++] = currentChar; // Store 'x' or 'X'
-            getNextChar();
-            int hasDigits = 0;
-            while (isxdigit(currentChar) && !eofFlag && i < MAX_TOKEN_SIZE - 1) 
-            {
-                token.lexeme[i++] = currentChar;
-                getNextChar();
-                hasDigits = 1;
-            }
-            token.lexeme[i] = '\0';
-            if (!hasDigits) 
-            {
-                fprintf(stderr, "Error at line %d: Hexadecimal literal '0%c' must be followed by hexadecimal digits (0-9, A-F).\n", startLine, token.lexeme[1]);
-                token.type = INVALID_NUMBER; // Specific type for invalid number format
-                return token;
-            }
-            // Check for invalid characters immediately after a valid hex number
-            if (isalnum(currentChar) || currentChar == '_') 
-            {
-                 fprintf(stderr, "Error at line %d: Invalid character '%c' in hexadecimal literal '%s'.\n", startLine, currentChar, token.lexeme);
-                 token.type = INVALID_NUMBER;
-                 getNextChar(); // Consume the invalid character
-                 return token;
-            }
-            token.type = INTEGRAL_CONSTANT;
-            return token;
+            break; // End of input
         }
-        else if (token.lexeme[0] == '0' && (currentChar == 'b' || currentChar == 'B')) 
+        batch->type[n] = type;
+        batch->start[n] = lx->tokStart;
+        batch->length[n] = lx->tokLen;
+        if (batch->line != NULL || batch->column != NULL)
         {
-            token.lexeme[i++] = currentChar; // Store 'b' or 'B'
-            getNextChar();
-            int hasDigits = 0;
-            while ((currentChar == '0' || currentChar == '1') && !eofFlag && i < MAX_TOKEN_SIZE - 1) 
-            {
-                token.lexeme[i++] = currentChar;
-                getNextChar();
-                hasDigits = 1;
-            }
-            token.lexeme[i] = '\0';
-            if (!hasDigits) 
+            int column;
+            int line = lexerPosition(lx, lx->tokStart, &column);
+            if (batch->line != NULL)
             {
-                fprintf(stderr, "Error at line %d: Binary literal '0%c' must be followed by binary digits (0 or 1).\n", startLine, token.lexeme[1]);
-                token.type = INVALID_NUMBER; // Specific type for invalid number format
-                return token;
+                batch->line[n] = line;
             }
-            // Check for invalid characters after binary digits
-            if (isalnum(currentChar) || currentChar == '_') 
+            if (batch->column != NULL)
             {
-                 fprintf(stderr, "Error at line %d: Invalid character '%c' in binary literal '%s'.\n", startLine, currentChar, token.lexeme);
-                 token.type = INVALID_NUMBER;
-                 // Consume the invalid character to continue
-                 getNextChar();
-                 return token;
+                batch->column[n] = column;
             }
-            token.type = INTEGRAL_CONSTANT;
-            return token;
         }
-        else if (token.lexeme[0] == '0' && isdigit(currentChar)) // Octal (starts with 0, followed by digits 0-7)
-        { 
-            while (isdigit(currentChar) && !eofFlag && i < MAX_TOKEN_SIZE - 1) 
-            {
-                if (currentChar >= '8' && currentChar <= '9') // Use range correctly for '8' and '9'
-                { 
-                    fprintf(stderr, "Error at line %d: Invalid digit '%c' in octal literal '0%s'. Octal digits must be 0-7.\n", startLine, currentChar, token.lexeme + 1);
-                    token.lexeme[i++] = currentChar; // Add invalid char for error reporting
-                    getNextChar();
-                    token.lexeme[i] = '\0';
-                    token.type = INVALID_NUMBER; // Specific type for invalid number format
-                    // Consume the rest of the invalid number-like sequence
-                    while(isalnum(currentChar) && !eofFlag) getNextChar();
-                    return token;
-                }
-                token.lexeme[i++] = currentChar;
-                getNextChar();
-            }
-            // Check for invalid characters immediately after a valid octal number
-            if (isalnum(currentChar) || currentChar == '_') 
-            {
-                 fprintf(stderr, "Error at line %d: Invalid character '%c' in octal literal '%s'.\n", startLine, currentChar, token.lexeme);
-                 token.type = INVALID_NUMBER;
-                 getNextChar(); // Consume the invalid character
-                 return token;
-            }
-            token.lexeme[i] = '\0';
-            token.type = INTEGRAL_CONSTANT;
-            return token;
+        if (batch->keyword != NULL)
+        {
+            batch->keyword[n] = lx->tokKeyword;
         }
-        else { // Decimal literal (starts with non-zero digit, or just '0' if not followed by x/b)
-            while (isdigit(currentChar) && !eofFlag && i < MAX_TOKEN_SIZE - 1) 
-            {
-                token.lexeme[i++] = currentChar;
-                getNextChar();
-            }
-            // Check for invalid characters immediately after a valid decimal number
-            if (isalnum(currentChar) || currentChar == '_') 
-            {
-                 fprintf(stderr, "Error at line %d: Invalid character '%c' in decimal literal '%s'.\n", startLine, currentChar, token.lexeme);
-                 token.type = INVALID_NUMBER;
-                 getNextChar(); // Consume the invalid character
-                 return token;
-            }
-            token.lexeme[i] = '\0';
-            token.type = INTEGRAL_CONSTANT;
-            return token;
-        }
-    }
-
-    // 5. Check for operators (multi-character first, then single)
-    char temp_lexeme[4] = {0};
-    temp_lexeme[0] = currentChar;
-    getNextChar();
-
-    // Check for common 2-char operators (and potential 3-char like <<=)
-    if ( (temp_lexeme[0] == '=' && currentChar == '=') ||
-         (temp_lexeme[0] == '!' && currentChar == '=') ||
-         (temp_lexeme[0] == '+' && currentChar == '+') ||
-         (temp_lexeme[0] == '-' && currentChar == '-') ||
-         (temp_lexeme[0] == '&' && currentChar == '&') ||
-         (temp_lexeme[0] == '|' && currentChar == '|') ||
-         (temp_lexeme[0] == '/' && currentChar == '=') ||
-         (temp_lexeme[0] == '*' && currentChar == '=') ||
-         (temp_lexeme[0] == '%' && currentChar == '=') ||
-         (temp_lexeme[0] == '^' && currentChar == '=') ||
-         (temp_lexeme[0] == '~' && currentChar == '=')
-        ) {
-        temp_lexeme[1] = currentChar;
-        temp_lexeme[2] = '\0';
-        getNextChar();
-        strcpy(token.lexeme, temp_lexeme);
-        token.type = OPERATOR;
-        return token;
-    } 
-    else if (
-        (temp_lexeme[0] == '<' && currentChar == '<') ||
-        (temp_lexeme[0] == '>' && currentChar == '>')
-    ) 
-    {
-        temp_lexeme[1] = currentChar;
-        temp_lexeme[2] = '\0';
-        getNextChar();
-        if (!eofFlag && currentChar == '=') 
+        if (batch->symbol != NULL)
         {
-            temp_lexeme[2] = currentChar;
-            temp_lexeme[3] = '\0';
-            getNextChar();
+            batch->symbol[n] = lx->tokSymbol;
         }
-        strcpy(token.lexeme, temp_lexeme);
-        token.type = OPERATOR;
-        return token;
+        n++;
+    }
+    return n;
+}
+
+// --- Dialect instances ---
+// The whole scanner is compiled once per dialect, with the dialect a
+// constant; a lexer picks its instance once per token or batch, never per
+// character.
+typedef struct {
+    TokenType (*scanToken)(LexerState* lx);
+    size_t (*fillBatch)(LexerState* lx, TokenBatch* batch);
+} DialectScanner;
+
+#define DIALECT_SCANNER(name, dialect) \
+    static TokenType scanToken##name(LexerState* lx) { return scanCounted(lx, dialect); } \
+    static size_t fillBatch##name(LexerState* lx, TokenBatch* batch) { return fillBatch(lx, batch, dialect); }
+
+DIALECT_SCANNER(C89, DIALECT_C89)
+DIALECT_SCANNER(C11, DIALECT_C11)
+DIALECT_SCANNER(C23, DIALECT_C23)
+DIALECT_SCANNER(Cpp, DIALECT_CPP)
+
+static const DialectScanner dialectScanners[DIALECT_COUNT] = {
+    [DIALECT_C89] = { scanTokenC89, fillBatchC89 },
+    [DIALECT_C11] = { scanTokenC11, fillBatchC11 },
+    [DIALECT_C23] = { scanTokenC23, fillBatchC23 },
+    [DIALECT_CPP] = { scanTokenCpp, fillBatchCpp },
+};
+
+TokenType lexerScanToken(LexerState* lx)
+{
+    return dialectScanners[lx->dialect].scanToken(lx);
+}
+
+size_t lexerFillTokens(LexerState* lx, TokenBatch* batch)
+{
+    if (lx->split != NULL)
+    {
+        return splitTokens(lx, batch);
     }
-    // 6. Check for single character operators or SYMBOLS
-    else if (isOperator(temp_lexeme)) 
+    return dialectScanners[lx->dialect].fillBatch(lx, batch);
+}
+
+size_t nextTokens(LexerState* lx, TokenBatch* batch)
+{
+    if (!lx->cacheChecked)
     {
-        strcpy(token.lexeme, temp_lexeme);
-        token.type = OPERATOR;
-        return token;
+        lx->cacheChecked = 1;
+        openCacheEntry(lx);
     }
-    else if (isSymbolCharacter(temp_lexeme[0]))
+    if (lx->cache != NULL)
     {
-        strcpy(token.lexeme, temp_lexeme);
-        token.type = SYMBOL;
-        // Update counts for delimiters
-        if (token.lexeme[0] == '(') paren_count++;
-        else if (token.lexeme[0] == ')') paren_count--;
-        else if (token.lexeme[0] == '{') brace_count++;
-        else if (token.lexeme[0] == '}') brace_count--;
-        else if (token.lexeme[0] == '[') bracket_count++;
-        else if (token.lexeme[0] == ']') bracket_count--;
-
-        // Simple error check for premature closing
-        if (paren_count < 0) 
-        {
-            fprintf(stderr, "Error at line %d: Unmatched ')'\n", lineNum);
-            paren_count = 0;
-        }
-        if (brace_count < 0) 
-        {
-            fprintf(stderr, "Error at line %d: Unmatched '}'\n", lineNum);
-            brace_count = 0;
-        }
-        if (bracket_count < 0) 
-        {
-            fprintf(stderr, "Error at line %d: Unmatched ']'\n", lineNum);
-            bracket_count = 0;
-        }
-        return token;
+        return cacheTokens(lx, batch);
     }
+    return lexerFillTokens(lx, batch);
+}
+
+const char* lexerTextAt(LexerState* lx, size_t offset)
+{
+    return bufPtr(lx, offset);
+}
+
+// --- Single-token interface, a one-entry batch ---
 
-    // If none of the above, it's an UNKNOWN token
-    if (!eofFlag) 
+Token nextToken(LexerState* lx)
+{
+    TokenType type;
+    size_t start, length;
+    int line, column;
+    KeywordId keyword;
+    uint32_t symbol;
+    TokenBatch one = { &type, &start, &length, &line, &column, &keyword, &symbol, 1 };
+
+    Token token;
+    size_t n = nextTokens(lx, &one);
+    if (n == 0)
     {
-        token.lexeme[0] = currentChar;
-        token.lexeme[1] = '\0';
-        token.type = UNKNOWN;
-        fprintf(stderr, "Warning: Unknown token '%s' at line %d\n", token.lexeme, lineNum);
-        getNextChar();
-        return token;
+        type = UNKNOWN;
+        start = lx->tokStart;
+        length = 0;
+        lexerLineColumn(lx, start, &line, &column);
+        keyword = KW_NONE;
+        symbol = NO_SYMBOL;
     }
-
-    token.type = UNKNOWN;
-    strcpy(token.lexeme, "");
+    token.lexeme = lexerTextAt(lx, start);
+    token.length = length;
+    token.offset = start;
+    token.line = line;
+    token.column = column;
+    token.type = type;
+    token.keyword = keyword;
+    token.symbol = symbol;
     return token;
 }
 
+Token getNextToken() 
+{
+    return nextToken(&defaultLexer);
+}
+
 // Function to return string representation of TokenType
 const char* getTokenTypeString(TokenType type) 
 {
@@ -650,6 +1701,10 @@ const char* getTokenTypeString(TokenType type)
             return "Identifier";
         case INVALID_NUMBER: // <--- NEW: String for INVALID_NUMBER type
             return "Invalid number";
+        case FLOATING_CONSTANT:
+            return "Floating constant";
+        case DIRECTIVE:
+            return "Directive";
         case UNKNOWN:
             return "Unknown";
         case SPECIAL_CHARACTER: // Fallback, should not be hit
@@ -1,8 +1,17 @@
 #ifndef LEXER_H
 #define LEXER_H
 
-#define MAX_KEYWORDS 20
-#define MAX_TOKEN_SIZE 100
+#include <stddef.h>
+#include <stdio.h>
+#include <stdint.h>
+#include "keywords.h"
+#include "interner.h"
+#include "arena.h"
+
+#define MAX_KEYWORDS KEYWORD_COUNT
+// Bump when the tokens or diagnostics of some input change: it is part of
+// the key of every token cache entry (tokcache.h)
+#define LEXER_VERSION 19
 
 typedef enum {
     KEYWORD,
@@ -13,18 +22,272 @@ typedef enum {
     IDENTIFIER,
     SYMBOL,
     INVALID_NUMBER,    // <--- NEW: For ill-formed numbers
+    FLOATING_CONSTANT, // Decimal and hexadecimal floating constants
+    DIRECTIVE,         // A whole preprocessor line, when kept (setLexerDirectives)
     UNKNOWN
 } TokenType;
 
+// A token is a view into the lexer's input: 'lexeme' points at the first
+// byte and is NOT NUL-terminated, so always print it with "%.*s" and 'length'.
+// Lexemes have no length limit. The view stays valid until closeLexer() for
+// files that can be mapped; for streamed inputs (pipes, terminals, windowed
+// files) it is only valid until the next call that fetches tokens.
 typedef struct {
-    char lexeme[MAX_TOKEN_SIZE];
+    const char* lexeme;
+    size_t length;
+    size_t offset;     // Byte offset of the first character in the input
+    int line;          // Line the token starts on
+    int column;        // 1-based byte column of its first character
     TokenType type;
+    KeywordId keyword; // Which keyword a KEYWORD token is; KW_NONE otherwise
+    uint32_t symbol;   // Interned id of an IDENTIFIER (see setLexerInterner); NO_SYMBOL otherwise
 } Token;
 
+// Reentrant interface: each LexerState lexes one file independently, so
+// separate states may be used from separate threads at the same time.
+typedef struct LexerState LexerState;
+
+LexerState* createLexer(const char* filename); // NULL if the file cannot be opened
+LexerState* createLexerFd(int fd);             // Lex an open descriptor (e.g. stdin); it is not closed
+Token nextToken(LexerState* lx);
+void setLexerErrorStream(LexerState* lx, FILE* errStream); // Diagnostics go to stderr by default
+void setLexerInterner(LexerState* lx, Interner* interner);  // Intern identifiers into a (shared) interner
+// Nonzero: return each preprocessor line, from its '#' up to the newline that
+// ends it (backslash-newlines included), as one DIRECTIVE token instead of
+// skipping it. Set before the first token.
+void setLexerDirectives(LexerState* lx, int keep);
+// Language dialects. Each has its own keywords, operators and number forms,
+// compiled into tables and into its own instance of the scanner, so a lexer
+// never tests the dialect while it scans. C23 has digit separators (1'000),
+// binary constants and "::"; C++ adds its keywords, ".*", "->*", "<=>" and
+// raw string literals (R"x(...)x"). C89 lacks hexadecimal floating
+// constants and "long long" suffixes but keeps '//' comments.
+typedef enum {
+    DIALECT_C89,
+    DIALECT_C11,
+    DIALECT_C23,
+    DIALECT_CPP,
+    DIALECT_COUNT
+} LexerDialect;
+#define LEXER_DEFAULT_DIALECT DIALECT_C23
+// Set before the first token; a new lexer is in LEXER_DEFAULT_DIALECT
+void setLexerDialect(LexerState* lx, LexerDialect dialect);
+// "c89", "c11", "c23" or "c++" (also "c90", "c17", "c18", "c2x", "cpp"); -1 otherwise
+int parseLexerDialect(const char* name);
+// DIALECT_CPP for C++ file extensions (.cpp, .hpp, ...), else the default
+LexerDialect lexerDialectForFile(const char* filename);
+// Keep the diagnostics and the newline index in 'arena' instead of malloc'd
+// memory; destroyLexer() then leaves them there, for the caller to reset the
+// arena after it. Set before the first token.
+void setLexerArena(LexerState* lx, Arena* arena);
+// Map at most about 'bytes' of the input file at a time, sliding the mapping
+// along as tokens are fetched, so that files larger than memory are lexed in
+// bounded resident memory. The input then counts as streamed (see Token and
+// splitLexer) and bypasses the token cache. No effect on pipes, on files not
+// larger than 'bytes', or once tokens have been fetched.
+void setLexerInputWindow(LexerState* lx, size_t bytes);
+void destroyLexer(LexerState* lx);                        // Also prints the diagnostics (see below)
+
+// Batch interface: fills caller-owned parallel arrays with up to 'capacity'
+// tokens per call, without building Token structs. 'line', 'column',
+// 'keyword' and 'symbol' may be NULL when not wanted; lines and columns are
+// looked up in a newline index, which is only built when they are asked for.
+// nextToken() is a one-entry batch.
+typedef struct {
+    TokenType* type;
+    size_t* start;      // Byte offset of each token
+    size_t* length;
+    int* line;          // Optional
+    int* column;        // Optional; 1-based byte column
+    KeywordId* keyword; // Optional; KW_NONE except for KEYWORD tokens
+    uint32_t* symbol;   // Optional; symbol id of IDENTIFIER tokens, NO_SYMBOL otherwise
+    size_t capacity;    // Entries available in each array
+} TokenBatch;
+
+// Returns the number of tokens stored, 0 once the input is exhausted. Streamed
+// inputs are read in fixed-size chunks; the window keeps the text of the
+// current batch only, so memory stays bounded for inputs of any size.
+size_t nextTokens(LexerState* lx, TokenBatch* batch);
+// Text of the token starting at 'offset', from the latest batch (see Token)
+const char* lexerTextAt(LexerState* lx, size_t offset);
+// Line and 1-based byte column of byte 'offset' of the input (the end of the
+// input included). Returns 0, setting both to 0, for offsets past the end or,
+// in a streamed input, on lines before the latest batch.
+int lexerLineColumn(LexerState* lx, size_t offset, int* line, int* column);
+
+// Lookahead for parsers (lexer_lookahead.c): a fixed-capacity ring of tokens
+// in the lexer, refilled a batch at a time, so that looking k tokens ahead
+// and backtracking copy nothing. Do not mix with nextToken() / nextTokens()
+// on the same lexer.
+#define LEXER_LOOKAHEAD 1024 // Default ring capacity, in tokens
+
+// Ring capacity (rounded up to a power of two), before the first peek.
+// Returns 0 when out of memory or once tokens are buffered.
+int setLexerLookahead(LexerState* lx, size_t capacity);
+// The token k places ahead (0: the next one); past the end, an UNKNOWN token
+// of length 0. The Token stays put until it is consumed and no mark holds it,
+// but a streamed input's lexeme only until the next peek that fetches tokens.
+// NULL when the ring cannot hold it: k, plus the tokens the oldest mark keeps
+// behind the next one, reaches the capacity; also when out of memory for the
+// default ring on the first use.
+const Token* peekToken(LexerState* lx, size_t k);
+void consumeToken(LexerState* lx); // Move past the next token (not past the end)
+// Marks nest: rewinding to a mark or unmarking it also drops the marks made
+// after it. The ring keeps every token from the oldest mark on. markTokens()
+// returns NO_MARK when out of memory, which rewinding and unmarking ignore.
+#define NO_MARK ((size_t)-1)
+size_t markTokens(LexerState* lx);               // The next token becomes a place to come back to
+void rewindTokens(LexerState* lx, size_t mark); // Back to it; the mark is dropped
+void unmarkTokens(LexerState* lx, size_t mark); // Drop it, staying where we are
+
+// Literal values, decoded on demand from a token's text (a Token's 'lexeme'
+// and 'length', or lexerTextAt() and a batch's 'length'); the lexer itself
+// never decodes them.
+typedef struct {
+    uint64_t value;  // Modulo 2^64 when 'overflow' is set
+    int base;        // 2, 8, 10 or 16, from the prefix
+    int overflow;    // The constant does not fit in 64 bits
+} IntegerValue;
+
+// Value of an INTEGRAL_CONSTANT, suffix and digit separators (1'000) ignored.
+// Returns 0 if the text is not a well-formed integer constant.
+int decodeIntegerConstant(const char* lexeme, size_t length, IntegerValue* value);
+// Bytes a string or character literal (quotes included) stands for, escapes
+// decoded and \u / \U written as UTF-8. Stores at most 'capacity' of them in
+// 'buf' (not NUL-terminated) and returns how many there are in all, so a
+// call with capacity 0 measures. An encoding prefix (L, u, U, u8) is skipped
+// and the bytes stay as in the source; a C++ raw string stands for its body
+// as written. Returns 0 for other text.
+size_t decodeLiteral(const char* lexeme, size_t length, char* buf, size_t capacity);
+// Decode the UTF-8 sequence at p into *cp and return its length, or 0 if it
+// is not well-formed (or runs past 'end'), as the lexer checks its input
+int decodeUtf8(const char* p, const char* end, uint32_t* cp);
+
+// Diagnostics are not printed as they happen: each lexer keeps them as
+// records in a buffer and writes them to its error stream once, when it is
+// closed (destroyLexer(), closeLexer()). Repeats of a message on the same
+// line are kept once, and past the limit only a count is kept; a note at
+// the end says how many were left out.
+typedef enum {
+    DIAG_UNCLOSED_STRING,
+    DIAG_UNCLOSED_CHAR,
+    DIAG_BAD_ESCAPE,         // Warning
+    DIAG_UNCLOSED_COMMENT,
+    DIAG_UNKNOWN_CHARACTER,  // Warning
+    DIAG_BAD_NUMBER,         // Missing digits, bad digit, or a letter after the number
+    DIAG_UNMATCHED_CLOSE,    // ')', '}' or ']' with nothing open
+    DIAG_UNCLOSED_DELIMITER, // '(', '{' or '[' still open at EOF
+    DIAG_INPUT,              // Reading the input, or indexing its lines, failed
+    DIAG_INCLUDE,            // Warning: an #include that is not followed (headers.h)
+    DIAG_BAD_UTF8            // Warning: bytes that are not well-formed UTF-8
+} DiagCode;
+
+typedef struct {
+    DiagCode code;
+    int warning;         // Otherwise an error
+    int line;
+    int column;          // 1-based byte column
+    size_t offset;       // The span of the input it is about
+    size_t length;
+    const char* message; // The text printed for it, newline included (not NUL-terminated)
+    size_t messageLength;
+} Diagnostic;
+
+#define LEXER_DIAG_LIMIT 1000 // Default number of diagnostics kept per input
+
+void setLexerDiagnosticLimit(LexerState* lx, size_t limit); // 0: no limit
+size_t getLexerDiagnosticCount(const LexerState* lx);
+// The i-th diagnostic buffered so far (0 if there is none); 'message' is
+// valid until more tokens are fetched
+int getLexerDiagnostic(const LexerState* lx, size_t i, Diagnostic* d);
+// Write out the buffered diagnostics now and empty the buffer
+void flushLexerDiagnostics(LexerState* lx);
+
+// Intra-file parallel mode: from here on, lex the input of lx in chunks of
+// about 'chunkSize' bytes (0 for the default) on 'threads' threads (0 for one
+// per CPU). Tokens, diagnostics and delimiter counts come out exactly as the
+// sequential lexer produces them. Returns 0, leaving lx sequential, for
+// inputs that are not held in memory (pipes, windowed files) or when out of
+// memory; a later window that runs out of memory hands over to the sequential
+// lexer at its start.
+int splitLexer(LexerState* lx, int threads, size_t chunkSize);
+
+// Hot-path counters, compiled in only with -DLEXER_STATS (without it the
+// lexer carries no counting code at all and getLexerStats() returns 0).
+// Scanning counts are of the work done: in split mode they include chunk
+// text that was lexed speculatively and then again. Diagnostics are counted
+// as they are found, repeats and those past the limit included, but not the
+// EOF reports of destroyLexer().
+#define LEXER_STATS_LENGTHS 8 // Length buckets: 1, 2, 3-4, 5-8, 9-16, 17-32, 33-64, 65+
+#define LEXER_STATS_SAMPLE 64 // One token in this many is timed
+
+typedef struct {
+    uint64_t tokens[UNKNOWN + 1];                       // Per TokenType
+    uint64_t lengths[UNKNOWN + 1][LEXER_STATS_LENGTHS]; // Lexeme length histogram per TokenType
+    uint64_t whitespaceBytes;
+    uint64_t commentBytes;      // Line and block comments, delimiters included
+    uint64_t preprocessorBytes; // '#' lines, up to their newline
+    uint64_t numberBases[4];    // Numbers started: decimal, octal, hexadecimal, binary
+    uint64_t sampled[UNKNOWN + 1];     // Tokens timed, per TokenType
+    uint64_t sampledTicks[UNKNOWN + 1]; // Their total time, in 'tickUnit'
+    const char* tickUnit;      // "cycles" (TSC) or "ns"
+    uint64_t errors;
+    uint64_t warnings;
+} LexerStats;
+
+// Copy the counters of lx into 'stats'; returns 0 when built without LEXER_STATS
+int getLexerStats(const LexerState* lx, LexerStats* stats);
+// Add the counters of 'from' into 'into'
+void addLexerStats(LexerStats* into, const LexerStats* from);
+// Human-readable report
+void printLexerStats(const LexerStats* stats, FILE* out);
+
+// Incremental re-lexing for editors (lexer_incr.c). A TokenList holds the
+// whole token stream of an in-memory text as parallel arrays.
+typedef struct {
+    TokenType* type;
+    size_t* start;
+    size_t* length;
+    int* line;
+    KeywordId* keyword;
+    size_t* reach; // Tokens 0..i depend only on the bytes before reach[i]
+    size_t count, capacity;
+    LexerDialect dialect; // What lexText() lexed as; relexEdit() goes on in it
+} TokenList;
+
+// The change an edit makes to a TokenList: old tokens [first, first + removed)
+// are replaced by 'inserted', and every old token after them moves by
+// 'shift' bytes and 'lineShift' lines.
+typedef struct {
+    size_t first;
+    size_t removed;
+    TokenList inserted;  // Offsets and lines in the edited text
+    ptrdiff_t shift;
+    int lineShift;
+} TokenDelta;
+
+// Lex all of text[0..len) as 'dialect' into 'list' (emptied first). Returns 0
+// when out of memory.
+int lexText(const char* text, size_t len, LexerDialect dialect, TokenList* list);
+void freeTokenList(TokenList* list);
+
+// 'old' is the stream of a text in which the bytes [offset, offset + deleted)
+// were then replaced by 'inserted' bytes, giving newText[0..newLen). Re-lexes
+// newText in old's dialect, from the last token whose reach is not past the
+// edit until the tokens line up with 'old' again, and describes the difference
+// in 'delta' (whose 'inserted' list is reused between calls). Diagnostics of
+// the re-lexed part are not reported. Returns 0 when out of memory.
+int relexEdit(const TokenList* old, const char* newText, size_t newLen,
+              size_t offset, size_t deleted, size_t inserted, TokenDelta* delta);
+// Apply 'delta' to the stream it was computed from
+int applyTokenDelta(TokenList* list, const TokenDelta* delta);
+
+// Single-file interface, backed by one process-wide LexerState
 void initializeLexer(const char* filename);
+void setLexerBanners(int enabled); // 0: initializeLexer() prints no "Open" banner on stdout
 Token getNextToken();
 void categorizeToken(Token* token); // Still declared but largely unused
-int isKeyword(const char* str);
+int isKeyword(const char* str); // Returns the KeywordId, 0 (KW_NONE) if not a keyword
 int isOperator(const char* str);
 int isSymbolCharacter(char ch);
 int isConstant(const char* str); // For checking if a string IS a constant, but now we'll have more specific types
@@ -33,4 +296,4 @@ int isIdentifier(const char* str);
 const char* getTokenTypeString(TokenType type);
 void closeLexer();
 
-#endif
\ No newline at end of file
+#endif
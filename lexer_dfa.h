@@ -0,0 +1,56 @@
+// Generated by tools/gen_dfa.c from tools/tokens.spec -- do not edit.
+#ifndef LEXER_DFA_H
+#define LEXER_DFA_H
+
+#include <stdint.h>
+#include "lexer.h"
+
+// Token kinds: what the longest match ending in an accepting state is
+typedef enum {
+    DFA_NONE = 0,
+    DFA_OPERATOR,
+    DFA_SYMBOL,
+    DFA_DECIMAL,
+    DFA_OCTAL,
+    DFA_HEX,
+    DFA_BINARY,
+    DFA_FLOAT,
+    DFA_HEXFLOAT,
+    DFA_HEX_EMPTY,
+    DFA_BINARY_EMPTY,
+    DFA_OCTAL_DIGIT,
+    DFA_KIND_COUNT
+} DfaKind;
+
+#define DFA_DEAD 0    // No token can continue from here
+#define DFA_START 1
+
+extern const TokenType dfaKindType[DFA_KIND_COUNT];
+
+// One DFA per dialect: byte -> input class, state x class -> state, and the
+// DfaKind a state accepts (DFA_NONE if none)
+#define DFA_STATES_C89 34
+#define DFA_CLASSES_C89 34
+extern const uint8_t dfaByteClassC89[256];
+extern const uint8_t dfaNextC89[DFA_STATES_C89][DFA_CLASSES_C89];
+extern const uint8_t dfaAcceptC89[DFA_STATES_C89];
+
+#define DFA_STATES_C11 52
+#define DFA_CLASSES_C11 36
+extern const uint8_t dfaByteClassC11[256];
+extern const uint8_t dfaNextC11[DFA_STATES_C11][DFA_CLASSES_C11];
+extern const uint8_t dfaAcceptC11[DFA_STATES_C11];
+
+#define DFA_STATES_C23 70
+#define DFA_CLASSES_C23 39
+extern const uint8_t dfaByteClassC23[256];
+extern const uint8_t dfaNextC23[DFA_STATES_C23][DFA_CLASSES_C23];
+extern const uint8_t dfaAcceptC23[DFA_STATES_C23];
+
+#define DFA_STATES_Cpp 72
+#define DFA_CLASSES_Cpp 39
+extern const uint8_t dfaByteClassCpp[256];
+extern const uint8_t dfaNextCpp[DFA_STATES_Cpp][DFA_CLASSES_Cpp];
+extern const uint8_t dfaAcceptCpp[DFA_STATES_Cpp];
+
+#endif
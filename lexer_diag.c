@@ -0,0 +1,196 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "lexer_internal.h"
+
+// The diagnostics buffer: records are appended while lexing and printed in
+// one go at the end, so an input full of errors costs a vsnprintf per kept
+// record and nothing per record past the limit.
+
+int diagIsWarning(DiagCode code)
+{
+    return code == DIAG_BAD_ESCAPE || code == DIAG_UNKNOWN_CHARACTER || code == DIAG_INCLUDE ||
+           code == DIAG_BAD_UTF8;
+}
+
+// Make room for 'need' elements of 'size' bytes in *p, from 'arena' if it
+// is set; 0 when out of memory
+static int reserveArray(Arena* arena, void** p, size_t* cap, size_t need, size_t size)
+{
+    if (need <= *cap)
+    {
+        return 1;
+    }
+    size_t n = (*cap > 0) ? *cap * 2 : 64;
+    while (n < need)
+    {
+        n *= 2;
+    }
+    void* grown = (arena != NULL) ? arenaGrow(arena, *p, *cap * size, n * size) : realloc(*p, n * size);
+    if (grown == NULL)
+    {
+        return 0;
+    }
+    *p = grown;
+    *cap = n;
+    return 1;
+}
+
+// An earlier entry with the same code, line and message as the last one
+static int isRepeat(const DiagLog* log, const DiagEntry* last)
+{
+    for (size_t i = log->count; i-- > 0; )
+    {
+        const DiagEntry* e = &log->entries[i];
+        if (e->line != last->line)
+        {
+            break; // Repeats are looked for among the entries of the same line only
+        }
+        if (e->code == last->code && e->textLength == last->textLength &&
+            memcmp(log->text + e->text, log->text + last->text, e->textLength) == 0)
+        {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+static void appendEntry(DiagLog* log, const DiagEntry* at, size_t textLength)
+{
+    DiagEntry e = *at;
+    e.token = log->token;
+    e.text = log->textLen;
+    e.textLength = textLength;
+    if (log->dedupe && isRepeat(log, &e))
+    {
+        log->repeated++;
+        return;
+    }
+    if (!reserveArray(log->arena, (void**)&log->entries, &log->capacity, log->count + 1, sizeof(DiagEntry)))
+    {
+        log->dropped++;
+        return;
+    }
+    log->entries[log->count++] = e;
+    log->textLen += textLength;
+}
+
+void logDiagnostic(DiagLog* log, const DiagEntry* at, const char* fmt, va_list ap)
+{
+    if (log->limit > 0 && log->count >= log->limit)
+    {
+        log->dropped++;
+        return;
+    }
+    va_list copy;
+    va_copy(copy, ap);
+    int n = vsnprintf(NULL, 0, fmt, copy);
+    va_end(copy);
+    if (n < 0)
+    {
+        return;
+    }
+    if (!reserveArray(log->arena, (void**)&log->text, &log->textCap, log->textLen + (size_t)n + 1, 1))
+    {
+        log->dropped++;
+        return;
+    }
+    vsnprintf(log->text + log->textLen, (size_t)n + 1, fmt, ap);
+    appendEntry(log, at, (size_t)n);
+}
+
+void addDiagnostic(DiagLog* log, const DiagEntry* at, const char* fmt, ...)
+{
+    va_list ap;
+    va_start(ap, fmt);
+    logDiagnostic(log, at, fmt, ap);
+    va_end(ap);
+}
+
+void copyDiagnostic(DiagLog* into, const DiagLog* from, const DiagEntry* e)
+{
+    if (into->limit > 0 && into->count >= into->limit)
+    {
+        into->dropped++;
+        return;
+    }
+    if (!reserveArray(into->arena, (void**)&into->text, &into->textCap, into->textLen + e->textLength, 1))
+    {
+        into->dropped++;
+        return;
+    }
+    memcpy(into->text + into->textLen, from->text + e->text, e->textLength);
+    appendEntry(into, e, e->textLength);
+}
+
+void flushDiagLog(DiagLog* log, FILE* out)
+{
+    for (size_t i = 0; i < log->count; i++)
+    {
+        fwrite(log->text + log->entries[i].text, 1, log->entries[i].textLength, out);
+    }
+    if (log->repeated > 0)
+    {
+        fprintf(out, "Note: %zu repeated diagnostic(s) not shown\n", log->repeated);
+    }
+    if (log->dropped > 0 && log->limit > 0)
+    {
+        fprintf(out, "Note: %zu more diagnostic(s) not shown (limit %zu)\n", log->dropped, log->limit);
+    }
+    else if (log->dropped > 0)
+    {
+        fprintf(out, "Note: %zu more diagnostic(s) not shown (out of memory)\n", log->dropped);
+    }
+    log->textLen = 0;
+    log->count = 0;
+    log->dropped = 0;
+    log->repeated = 0;
+}
+
+void freeDiagLog(DiagLog* log)
+{
+    if (log->arena == NULL)
+    {
+        free(log->text);
+        free(log->entries);
+    }
+    log->text = NULL;
+    log->entries = NULL;
+    log->textLen = log->textCap = 0;
+    log->count = log->capacity = 0;
+}
+
+// --- Public interface ---
+
+void setLexerDiagnosticLimit(LexerState* lx, size_t limit)
+{
+    lx->diags.limit = limit;
+}
+
+size_t getLexerDiagnosticCount(const LexerState* lx)
+{
+    return lx->diags.count;
+}
+
+int getLexerDiagnostic(const LexerState* lx, size_t i, Diagnostic* d)
+{
+    if (i >= lx->diags.count)
+    {
+        return 0;
+    }
+    const DiagEntry* e = &lx->diags.entries[i];
+    d->code = e->code;
+    d->warning = diagIsWarning(e->code);
+    d->line = e->line;
+    d->column = e->column;
+    d->offset = e->offset;
+    d->length = e->length;
+    d->message = lx->diags.text + e->text;
+    d->messageLength = e->textLength;
+    return 1;
+}
+
+void flushLexerDiagnostics(LexerState* lx)
+{
+    flushDiagLog(&lx->diags, lx->errStream);
+}
@@ -0,0 +1,250 @@
+#include <stdlib.h>
+#include <string.h>
+#include "lexer_internal.h"
+
+// Incremental re-lexing. The scanner keeps no state between tokens except its
+// position, and a token depends only on the bytes its scan has read: from its
+// first character up to the character after it, and further where a scanner
+// looks ahead, as the DFA does before it backs off to a shorter match ("..",
+// or "1e+" followed by no digit), or as decoding the next UTF-8 character
+// does to see whether an identifier or a run of unknown characters goes on
+// (up to four bytes). Each token's reach records the end of what the scans up
+// to it read (lexerScanReach). So after an edit:
+//  - every token whose reach is not past the start of the edit is unchanged,
+//    and lexing can start again at the start of the last of them;
+//  - once the new lexer produces a token past the edit that the old stream
+//    also had (same shifted start, type and length), the rest of the old
+//    stream is unchanged apart from its offsets and lines.
+// UNKNOWN tokens are not used as restart points: they can be the character
+// after a stray one, which a scan starting on them would read differently.
+
+static int reserveTokens(TokenList* list, size_t need)
+{
+    if (need <= list->capacity || need == 0)
+    {
+        return 1;
+    }
+    size_t cap = (list->capacity > 0) ? list->capacity * 2 : 256;
+    while (cap < need)
+    {
+        cap *= 2;
+    }
+    TokenType* type = realloc(list->type, cap * sizeof(TokenType));
+    if (type != NULL) list->type = type;
+    size_t* start = realloc(list->start, cap * sizeof(size_t));
+    if (start != NULL) list->start = start;
+    size_t* length = realloc(list->length, cap * sizeof(size_t));
+    if (length != NULL) list->length = length;
+    int* line = realloc(list->line, cap * sizeof(int));
+    if (line != NULL) list->line = line;
+    KeywordId* keyword = realloc(list->keyword, cap * sizeof(KeywordId));
+    if (keyword != NULL) list->keyword = keyword;
+    size_t* reach = realloc(list->reach, cap * sizeof(size_t));
+    if (reach != NULL) list->reach = reach;
+    if (type == NULL || start == NULL || length == NULL || line == NULL || keyword == NULL || reach == NULL)
+    {
+        return 0;
+    }
+    list->capacity = cap;
+    return 1;
+}
+
+static int pushToken(TokenList* list, LexerState* lx, TokenType type)
+{
+    if (!reserveTokens(list, list->count + 1))
+    {
+        return 0;
+    }
+    size_t i = list->count++;
+    list->type[i] = type;
+    list->start[i] = lx->tokStart;
+    list->length[i] = lx->tokLen;
+    list->line[i] = lexerLineAt(lx, lx->tokStart);
+    list->keyword[i] = lx->tokKeyword;
+    list->reach[i] = lexerScanReach(lx);
+    if (i > 0 && list->reach[i - 1] > list->reach[i])
+    {
+        list->reach[i] = list->reach[i - 1];
+    }
+    return 1;
+}
+
+void freeTokenList(TokenList* list)
+{
+    free(list->type);
+    free(list->start);
+    free(list->length);
+    free(list->line);
+    free(list->keyword);
+    free(list->reach);
+    memset(list, 0, sizeof(*list));
+}
+
+// Set up a lexer that only produces tokens: diagnostics go to 'log' (and are
+// dropped by the caller) and delimiters are not matched. 'pos' is on 'line'.
+static void startQuietLexer(LexerState* lx, const char* text, size_t len, size_t pos, int line,
+                            LexerDialect dialect, DiagLog* log)
+{
+    size_t lineStart = pos;
+    while (lineStart > 0 && text[lineStart - 1] != '\n')
+    {
+        lineStart--;
+    }
+    startBufferLexer(lx, text, len, pos, lineStart, line);
+    setLexerDialect(lx, dialect);
+    lx->diagLog = log;
+    lx->noDelimiters = 1;
+}
+
+int lexText(const char* text, size_t len, LexerDialect dialect, TokenList* list)
+{
+    LexerState lx;
+    DiagLog log = { 0 };
+    int ok = 1;
+    list->count = 0;
+    list->dialect = dialect;
+    startQuietLexer(&lx, text, len, 0, 1, dialect, &log);
+    while (ok)
+    {
+        TokenType type = lexerScanToken(&lx);
+        if (type == UNKNOWN && lx.tokLen == 0)
+        {
+            break; // End of input
+        }
+        ok = pushToken(list, &lx, type);
+    }
+    ok = ok && !lx.lineIndex.failed; // Some lines would be wrong
+    freeDiagLog(&log);
+    freeLineIndex(&lx.lineIndex);
+    return ok;
+}
+
+int relexEdit(const TokenList* old, const char* newText, size_t newLen,
+              size_t offset, size_t deleted, size_t inserted, TokenDelta* delta)
+{
+    // The tokens whose scans read nothing from the edit on are unchanged;
+    // restart at the last of them
+    size_t before = 0, hi = old->count;
+    while (before < hi)
+    {
+        size_t mid = before + (hi - before) / 2;
+        if (old->reach[mid] <= offset)
+        {
+            before = mid + 1;
+        }
+        else
+        {
+            hi = mid;
+        }
+    }
+    while (before > 0 && old->type[before - 1] == UNKNOWN)
+    {
+        before--;
+    }
+    size_t first = 0;
+    size_t from = 0;
+    int line = 1;
+    if (before > 0)
+    {
+        first = before - 1;
+        from = old->start[first];
+        line = old->line[first];
+    }
+
+    LexerState lx;
+    DiagLog log = { 0 };
+    int ok = 1;
+    size_t editEnd = offset + inserted;
+    size_t k = first; // Old token being compared
+    delta->first = first;
+    delta->removed = old->count - first;
+    delta->inserted.count = 0;
+    delta->shift = 0;
+    delta->lineShift = 0;
+    delta->inserted.dialect = old->dialect;
+    startQuietLexer(&lx, newText, newLen, from, line, old->dialect, &log);
+    while (ok)
+    {
+        TokenType type = lexerScanToken(&lx);
+        if (type == UNKNOWN && lx.tokLen == 0)
+        {
+            break; // End of input: the old tail is gone
+        }
+        if (lx.tokStart >= editEnd)
+        {
+            // Where this token would have been before the edit
+            size_t was = lx.tokStart - inserted + deleted;
+            while (k < old->count && old->start[k] < was)
+            {
+                k++;
+            }
+            if (k < old->count && old->start[k] == was && old->type[k] == type && old->length[k] == lx.tokLen)
+            {
+                delta->removed = k - first;
+                delta->shift = (ptrdiff_t)inserted - (ptrdiff_t)deleted;
+                delta->lineShift = lexerLineAt(&lx, lx.tokStart) - old->line[k];
+                break;
+            }
+        }
+        ok = pushToken(&delta->inserted, &lx, type);
+    }
+    ok = ok && !lx.lineIndex.failed; // Some lines would be wrong
+    freeDiagLog(&log);
+    freeLineIndex(&lx.lineIndex);
+    return ok;
+}
+
+int applyTokenDelta(TokenList* list, const TokenDelta* delta)
+{
+    const TokenList* in = &delta->inserted;
+    size_t tail = delta->first + delta->removed;
+    size_t rest = list->count - tail;
+    size_t count = delta->first + in->count + rest;
+    if (!reserveTokens(list, count))
+    {
+        return 0;
+    }
+
+    // Move the unchanged tail into place, then shift it
+    size_t to = delta->first + in->count;
+    if (rest > 0)
+    {
+        memmove(list->type + to, list->type + tail, rest * sizeof(TokenType));
+        memmove(list->start + to, list->start + tail, rest * sizeof(size_t));
+        memmove(list->length + to, list->length + tail, rest * sizeof(size_t));
+        memmove(list->line + to, list->line + tail, rest * sizeof(int));
+        memmove(list->keyword + to, list->keyword + tail, rest * sizeof(KeywordId));
+        memmove(list->reach + to, list->reach + tail, rest * sizeof(size_t));
+    }
+    for (size_t i = to; i < count; i++)
+    {
+        list->start[i] += (size_t)delta->shift;
+        list->reach[i] += (size_t)delta->shift;
+        list->line[i] += delta->lineShift;
+    }
+
+    if (in->count > 0)
+    {
+        memcpy(list->type + delta->first, in->type, in->count * sizeof(TokenType));
+        memcpy(list->start + delta->first, in->start, in->count * sizeof(size_t));
+        memcpy(list->length + delta->first, in->length, in->count * sizeof(size_t));
+        memcpy(list->line + delta->first, in->line, in->count * sizeof(int));
+        memcpy(list->keyword + delta->first, in->keyword, in->count * sizeof(KeywordId));
+        memcpy(list->reach + delta->first, in->reach, in->count * sizeof(size_t));
+    }
+    // Reaches never decrease: the re-lexed tokens go on from the kept ones',
+    // and the tail from theirs until it is past them
+    for (size_t i = (delta->first > 0) ? delta->first : 1; i < count; i++)
+    {
+        if (list->reach[i] < list->reach[i - 1])
+        {
+            list->reach[i] = list->reach[i - 1];
+        }
+        else if (i >= to)
+        {
+            break;
+        }
+    }
+    list->count = count;
+    return 1;
+}
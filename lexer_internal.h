@@ -0,0 +1,265 @@
+#ifndef LEXER_INTERNAL_H
+#define LEXER_INTERNAL_H
+
+#include <stdarg.h>
+#include "lexer.h"
+#include "lexer_simd.h"
+
+// Shared between the lexer modules; not part of the public interface.
+
+// Buffered diagnostics (lexer_diag.c). Every lexer logs into its own
+// DiagLog, printed when it is closed. A chunk lexer of a split input logs
+// against the token it was scanning instead, and the merge copies into the
+// real lexer's log only those of the tokens that turn out to be in the real
+// stream.
+typedef struct {
+    size_t token;  // Index of the token being scanned when it was logged
+    DiagCode code;
+    int line, column;
+    size_t offset, length; // Span in the input
+    size_t text, textLength; // Message, in DiagLog.text
+} DiagEntry;
+
+typedef struct {
+    char* text;
+    size_t textLen, textCap;
+    DiagEntry* entries;
+    size_t count, capacity;
+    size_t token;    // Index of the token being scanned now
+    size_t limit;    // Entries kept at most (0: no limit)
+    int dedupe;      // Drop repeats of a message on the same line
+    size_t dropped;  // Not kept: over the limit
+    size_t repeated; // Not kept: repeats
+    Arena* arena;    // Where text and entries live; NULL: malloc
+} DiagLog;
+
+// Newline index (lexer_lines.c): where the lines of the input start, so that
+// lines and columns are found from offsets instead of being counted while
+// scanning. It covers the offsets from firstStart on.
+typedef struct {
+    size_t* starts;    // starts[i]: where line firstLine + 1 + i begins
+    size_t count, capacity;
+    int firstLine;     // Line of the offsets in [firstStart, starts[0])
+    size_t firstStart;
+    size_t indexedTo;  // Every newline before this offset is in 'starts'
+    Arena* arena;      // Where 'starts' lives; NULL: malloc
+    int failed;        // 'starts' could not grow: the lines before firstStart were forgotten
+} LineIndex;
+
+typedef struct SplitState SplitState;
+typedef struct CacheEntry CacheEntry;
+typedef struct Lookahead Lookahead;
+
+// Counter updates that vanish unless built with -DLEXER_STATS
+#ifdef LEXER_STATS
+#include <time.h>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+#define STATS_ONLY(code) code
+#define STAT_ADD(lx, field, n) ((lx)->stats.field += (n))
+#define STAT_DIAG(lx, code) (diagIsWarning(code) ? (lx)->stats.warnings++ : (lx)->stats.errors++)
+
+// Timestamp for token sampling: the TSC on x86, nanoseconds elsewhere
+static inline uint64_t statsClock()
+{
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+#endif
+}
+
+static inline void countToken(LexerStats* stats, TokenType type, size_t length)
+{
+    int bucket = 0;
+    while (bucket < LEXER_STATS_LENGTHS - 1 && length > ((size_t)1 << bucket))
+    {
+        bucket++;
+    }
+    stats->tokens[type]++;
+    stats->lengths[type][bucket]++;
+}
+#else
+#define STATS_ONLY(code)
+#define STAT_ADD(lx, field, n) ((void)0)
+#define STAT_DIAG(lx, code) ((void)0)
+#endif
+
+// All lexer state lives in a LexerState so that several inputs can be
+// lexed at once; the legacy single-file API drives defaultLexer.
+struct LexerState
+{
+    int inputFd;
+    int ownsFd;      // Close inputFd with the lexer
+    FILE* errStream; // Where diagnostics go (stderr unless redirected)
+    char currentChar;
+    int eofFlag;     // To indicate if EOF has been reached
+
+    // Input window: srcBuf holds the bytes [srcBase, srcLen) of the input, and
+    // all positions below are offsets into the whole input. Regular files are
+    // mapped whole (srcBase 0); anything else is streamed in chunks.
+    const char* srcBuf;
+    size_t srcBase;
+    size_t srcLen;
+    int srcMapped;      // srcBuf came from mmap
+    size_t readPos;     // Bytes consumed so far; currentChar is at readPos - 1
+    size_t lookEnd;     // End of the bytes a scan looked at past currentChar (see lexerScanReach)
+
+    // Streaming: srcBuf is 'window', refilled by read() on inputFd. Refills
+    // drop the text before keepPos, the start of the current batch or, if
+    // earlier, holdPos (the oldest token in the lookahead ring), and the
+    // lines that end before it from the newline index.
+    int streaming;
+    int inputEnd;       // read() has reported the end of the input
+    char* window;
+    size_t windowCap;
+    size_t keepPos;
+    size_t holdPos;
+    // Windowed file (setLexerInputWindow): streamed too, but srcBuf maps the
+    // bytes [srcBase, srcLen) of the file instead of 'window', and refills
+    // map the next stretch of at least windowCap bytes in its place
+    int windowed;
+    size_t fileSize;
+
+    // Token being built: a view of tokLen bytes starting at tokStart
+    size_t tokStart;
+    size_t tokLen;
+    KeywordId tokKeyword;
+    uint32_t tokSymbol;
+
+    const ScanKernels* scan; // SIMD or scalar skip kernels for the buffer fast paths
+    Interner* interner;      // Gives identifiers symbol ids when set
+
+    int keepDirectives; // '#' lines are DIRECTIVE tokens, not skipped
+    LexerDialect dialect; // Picks the scanner instance (lexer.c)
+
+    // Counters for unmatched delimiters
+    int paren_count;   // ()
+    int brace_count;   // {}
+    int bracket_count; // []
+
+    // Intra-file parallel mode (lexer_split.c)
+    SplitState* split;  // Set on a lexer whose tokens come from splitLexer()
+    DiagLog* diagLog;   // Set on a chunk lexer: log diagnostics here, not in 'diags'
+    int noDelimiters;   // Set on a chunk lexer: the merge matches delimiters
+
+    // Diagnostics waiting to be printed
+    DiagLog diags;
+
+    // Line starts, built as far as lines have been asked for. A chunk lexer
+    // reads its parent's index instead (sharedLines), which it never grows.
+    LineIndex lineIndex;
+    LineIndex* sharedLines;
+    size_t lineHint;    // Where in the index the last lookup ended
+    size_t lineFrom, lineTo; // It was on line lineNumber, the offsets [lineFrom, lineTo)
+    int lineNumber;
+
+    // Persistent token cache (tokcache.c): looked up before the first token
+    int cacheChecked;
+    CacheEntry* cache;  // Set while replaying or recording an entry
+
+    // Token ring of peekToken() (lexer_lookahead.c), made on first use
+    Lookahead* lookahead;
+
+#ifdef LEXER_STATS
+    LexerStats stats;
+    unsigned sampleCountdown; // Tokens until the next timed one
+#endif
+};
+
+// lexer.c: scan one token into tokStart/tokLen/...; UNKNOWN of length 0 at EOF
+TokenType lexerScanToken(LexerState* lx);
+// lexer.c: set up lx (not owning anything but its newline index) to lex
+// buf[0..len) from byte 'pos' as if a token began there; 'pos' is on line
+// 'line', which starts at 'lineStart'
+void startBufferLexer(LexerState* lx, const char* buf, size_t len, size_t pos, size_t lineStart, int line);
+
+// lexer.c: the end of lexing lx, short of releasing its input: report the
+// delimiters left open and store the token cache entry being recorded. The
+// diagnostics stay buffered.
+void finishLexerInput(LexerState* lx);
+
+// lexer.c: where the bytes the scans so far have read end. A scanner that
+// looks past currentChar (the DFA backing off from a longer match, a UTF-8
+// character decoded to see whether it goes on a token) records how far in
+// lookEnd; the end of the input counts as a byte once reached.
+// The tokens up to the latest one depend on nothing from here on.
+size_t lexerScanReach(const LexerState* lx);
+
+// lexer.c: fill a batch by lexing (sequentially or split), past the cache
+size_t lexerFillTokens(LexerState* lx, TokenBatch* batch);
+
+// lexer_utf8.c. C23 identifier characters past ASCII: XID_Start and XID_Continue
+int isXidStart(uint32_t cp);
+int isXidContinue(uint32_t cp);
+
+// lexer_lookahead.c: release the token ring
+void freeLookahead(LexerState* lx);
+
+// lexer_lines.c
+void initLineIndex(LineIndex* idx, size_t lineStart, int line, size_t from);
+void freeLineIndex(LineIndex* idx);
+// Add the line starts after the newlines in [indexedTo, to); 'text' points
+// at byte indexedTo. Out of memory, the newlines are only counted and the
+// index is marked failed.
+void scanLineStarts(LineIndex* idx, const ScanKernels* scan, const char* text, size_t to);
+// Append the line starts of 'part', an index of the text from at most
+// into->indexedTo on, that 'into' does not have yet (marking 'into' failed
+// when it cannot take them, or when 'part' failed)
+void mergeLineIndex(LineIndex* into, const LineIndex* part);
+// Forget the lines that end at or before 'pos'; 'hint' is the lexer's lineHint
+void dropLinesBefore(LineIndex* idx, size_t pos, size_t* hint);
+// Line of byte 'offset' (at most srcLen): 1 + the newlines before it, or 0
+// if the index no longer knows it
+int lexerLineAt(LexerState* lx, size_t offset);
+
+// Line and column of 'offset' for the lexers' in-order lookups: mostly on
+// the line of the previous lookup, which takes one comparison, or the next
+static inline int lexerPosition(LexerState* lx, size_t offset, int* column)
+{
+    if (offset - lx->lineFrom >= lx->lineTo - lx->lineFrom)
+    {
+        const LineIndex* idx = &lx->lineIndex;
+        size_t k = lx->lineHint;
+        if (lx->sharedLines != NULL || k + 1 >= idx->count || offset < idx->starts[k] || offset >= idx->starts[k + 1])
+        {
+            int line;
+            lexerLineColumn(lx, offset, &line, column);
+            return line;
+        }
+        lx->lineHint = k + 1;
+        lx->lineFrom = idx->starts[k];
+        lx->lineTo = idx->starts[k + 1];
+        lx->lineNumber = idx->firstLine + (int)k + 1;
+    }
+    *column = (int)(offset - lx->lineFrom + 1);
+    return lx->lineNumber;
+}
+
+// lexer_diag.c
+int diagIsWarning(DiagCode code);
+// Format and append a diagnostic (unless it is dropped); 'at' gives all but
+// the message and the token
+void logDiagnostic(DiagLog* log, const DiagEntry* at, const char* fmt, va_list ap);
+void __attribute__((format(printf, 3, 4))) addDiagnostic(DiagLog* log, const DiagEntry* at, const char* fmt, ...);
+// Append entry 'e' of another log
+void copyDiagnostic(DiagLog* into, const DiagLog* from, const DiagEntry* e);
+// Print the entries and notes about what was dropped, then empty the log
+void flushDiagLog(DiagLog* log, FILE* out);
+void freeDiagLog(DiagLog* log);
+
+// tokcache.c: look the input of lx up (if the cache is on); fill a batch from
+// the entry or record it; store a finished recording and release the entry
+void openCacheEntry(LexerState* lx);
+size_t cacheTokens(LexerState* lx, TokenBatch* batch);
+void closeCacheEntry(LexerState* lx);
+
+// lexer_split.c
+size_t splitTokens(LexerState* lx, TokenBatch* batch);
+void destroySplit(LexerState* lx);
+
+#endif
@@ -0,0 +1,272 @@
+#include <stdlib.h>
+#include <string.h>
+#include "lexer_internal.h"
+
+// Newline index. The scanner does not count lines: tokens and diagnostics
+// carry byte offsets, and their lines and columns are looked up here when
+// somebody asks. The index is a sorted table of line starts, built by the
+// findNewlines kernel ahead of the lookups (in steps, so lexing without
+// asking for lines never builds it). Lookups mostly move forward a few
+// lines from the previous one; any other is a binary search.
+
+#define LINE_INDEX_STEP (256 * 1024) // Bytes indexed at least per extension
+#define LINE_SCAN_PIECE 4096         // Bytes per kernel call, so room can be reserved
+
+#define lineStartOf(idx, k) (((k) > 0) ? (idx)->starts[(k) - 1] : (idx)->firstStart)
+
+void initLineIndex(LineIndex* idx, size_t lineStart, int line, size_t from)
+{
+    idx->count = 0;
+    idx->firstLine = line;
+    idx->firstStart = lineStart;
+    idx->indexedTo = from;
+    idx->failed = 0;
+}
+
+void freeLineIndex(LineIndex* idx)
+{
+    if (idx->arena == NULL)
+    {
+        free(idx->starts);
+    }
+    idx->starts = NULL;
+    idx->count = idx->capacity = 0;
+}
+
+// Make room for 'more' line starts. Returns 0, and marks the index failed,
+// when out of memory.
+static int reserveLines(LineIndex* idx, size_t more)
+{
+    if (idx->count + more <= idx->capacity)
+    {
+        return 1;
+    }
+    size_t n = (idx->capacity > 0) ? idx->capacity * 2 : 1024;
+    while (n < idx->count + more)
+    {
+        n *= 2;
+    }
+    size_t* starts = (idx->arena != NULL) ? arenaGrow(idx->arena, idx->starts, idx->capacity * sizeof(size_t), n * sizeof(size_t))
+                                          : realloc(idx->starts, n * sizeof(size_t));
+    if (starts == NULL)
+    {
+        idx->failed = 1;
+        return 0;
+    }
+    idx->starts = starts;
+    idx->capacity = n;
+    return 1;
+}
+
+// Forget the line starts in the table: the index then begins at the last one
+static void forgetLines(LineIndex* idx)
+{
+    idx->firstStart = lineStartOf(idx, idx->count);
+    idx->firstLine += (int)idx->count;
+    idx->count = 0;
+}
+
+// Add the line starts of [indexedTo, to) to the table, piece by piece.
+// Returns 0 if it stops early because the table cannot grow.
+static int addLineStarts(LineIndex* idx, const ScanKernels* scan, const char* text, size_t to)
+{
+    size_t pos = idx->indexedTo;
+    while (pos < to)
+    {
+        size_t n = (to - pos < LINE_SCAN_PIECE) ? to - pos : LINE_SCAN_PIECE;
+        if (idx->failed || !reserveLines(idx, n))
+        {
+            idx->indexedTo = pos;
+            return 0;
+        }
+        idx->count += scan->findNewlines(text, text + n, pos, idx->starts + idx->count);
+        text += n;
+        pos += n;
+    }
+    if (to > idx->indexedTo)
+    {
+        idx->indexedTo = to;
+    }
+    return 1;
+}
+
+void scanLineStarts(LineIndex* idx, const ScanKernels* scan, const char* text, size_t to)
+{
+    size_t from = idx->indexedTo;
+    if (to <= from || addLineStarts(idx, scan, text, to))
+    {
+        return;
+    }
+    // Count the rest without storing it: the index keeps the last line start
+    const char* p = text + (idx->indexedTo - from);
+    const char* end = text + (to - from);
+    forgetLines(idx);
+    while ((p = scan->findNewline(p, end)) < end)
+    {
+        idx->firstLine++;
+        idx->firstStart = from + (size_t)(++p - text);
+    }
+    idx->indexedTo = to;
+}
+
+void mergeLineIndex(LineIndex* into, const LineIndex* part)
+{
+    // Skip what 'into' has already; a binary search, as it is mostly nothing
+    size_t lo = 0, hi = part->count;
+    while (lo < hi)
+    {
+        size_t mid = lo + (hi - lo) / 2;
+        if (part->starts[mid] <= into->indexedTo)
+        {
+            lo = mid + 1;
+        }
+        else
+        {
+            hi = mid;
+        }
+    }
+    size_t n = part->count - lo;
+    into->failed |= part->failed;
+    if (into->failed || !reserveLines(into, n))
+    {
+        // Keep only the last of them
+        forgetLines(into);
+        if (n > 0)
+        {
+            into->firstLine += (int)n;
+            into->firstStart = part->starts[part->count - 1];
+        }
+    }
+    else
+    {
+        memcpy(into->starts + into->count, part->starts + lo, n * sizeof(size_t));
+        into->count += n;
+    }
+    if (part->indexedTo > into->indexedTo)
+    {
+        into->indexedTo = part->indexedTo;
+    }
+}
+
+void dropLinesBefore(LineIndex* idx, size_t pos, size_t* hint)
+{
+    size_t k = 0;
+    while (k < idx->count && idx->starts[k] <= pos)
+    {
+        k++;
+    }
+    if (k == 0)
+    {
+        return;
+    }
+    idx->firstStart = idx->starts[k - 1];
+    idx->firstLine += (int)k;
+    idx->count -= k;
+    memmove(idx->starts, idx->starts + k, idx->count * sizeof(size_t));
+    *hint = (*hint > k) ? *hint - k : 0;
+}
+
+// Number of line starts in the table at or before 'offset', i.e. how many
+// lines after firstLine it is on. Starts from the previous answer.
+static size_t findLine(const LineIndex* idx, size_t offset, size_t* hint)
+{
+    size_t lo = 0, hi = idx->count;
+    size_t k = (*hint < idx->count) ? *hint : idx->count;
+    if (offset >= lineStartOf(idx, k))
+    {
+        // Mostly the same line or one of the next few
+        size_t stop = (idx->count - k > 8) ? k + 8 : idx->count;
+        while (k < stop && idx->starts[k] <= offset)
+        {
+            k++;
+        }
+        if (k == idx->count || idx->starts[k] > offset)
+        {
+            *hint = k;
+            return k;
+        }
+        lo = k;
+    }
+    else
+    {
+        hi = k;
+    }
+    while (lo < hi)
+    {
+        size_t mid = lo + (hi - lo) / 2;
+        if (idx->starts[mid] <= offset)
+        {
+            lo = mid + 1;
+        }
+        else
+        {
+            hi = mid;
+        }
+    }
+    *hint = lo;
+    return lo;
+}
+
+// Line and line start of 'offset' (firstStart <= offset <= srcLen). The own
+// index of lx grows to cover it; a shared one (a chunk lexer's) is only read,
+// and the newlines past its end are counted in place.
+static int locate(LexerState* lx, size_t offset, size_t* lineStart)
+{
+    LineIndex* idx = (lx->sharedLines != NULL) ? lx->sharedLines : &lx->lineIndex;
+    if (offset > idx->indexedTo && lx->sharedLines == NULL)
+    {
+        size_t to = idx->indexedTo + LINE_INDEX_STEP;
+        to = (to > offset) ? to : offset;
+        to = (to < lx->srcLen) ? to : lx->srcLen;
+        if (!addLineStarts(idx, lx->scan, lx->srcBuf + (idx->indexedTo - lx->srcBase), to) && offset > idx->indexedTo)
+        {
+            // Out of memory: only count up to the offset, forgetting the lines before
+            scanLineStarts(idx, lx->scan, lx->srcBuf + (idx->indexedTo - lx->srcBase), offset);
+        }
+    }
+    if (offset > idx->indexedTo)
+    {
+        const char* p = lx->srcBuf + (idx->indexedTo - lx->srcBase);
+        const char* end = lx->srcBuf + (offset - lx->srcBase);
+        int line = idx->firstLine + (int)idx->count;
+        *lineStart = lineStartOf(idx, idx->count);
+        while ((p = lx->scan->findNewline(p, end)) < end)
+        {
+            line++;
+            *lineStart = (size_t)(++p - lx->srcBuf) + lx->srcBase;
+        }
+        return line;
+    }
+    size_t k = findLine(idx, offset, &lx->lineHint);
+    *lineStart = lineStartOf(idx, k);
+    // Remember the line; the last one known runs at least to indexedTo
+    lx->lineFrom = *lineStart;
+    lx->lineTo = (k < idx->count) ? idx->starts[k] : idx->indexedTo + 1;
+    lx->lineNumber = idx->firstLine + (int)k;
+    return lx->lineNumber;
+}
+
+int lexerLineAt(LexerState* lx, size_t offset)
+{
+    const LineIndex* idx = (lx->sharedLines != NULL) ? lx->sharedLines : &lx->lineIndex;
+    if (offset < idx->firstStart)
+    {
+        return 0;
+    }
+    size_t lineStart;
+    return locate(lx, offset, &lineStart);
+}
+
+int lexerLineColumn(LexerState* lx, size_t offset, int* line, int* column)
+{
+    const LineIndex* idx = (lx->sharedLines != NULL) ? lx->sharedLines : &lx->lineIndex;
+    if (offset < idx->firstStart || offset > lx->srcLen)
+    {
+        *line = *column = 0;
+        return 0;
+    }
+    size_t lineStart;
+    *line = locate(lx, offset, &lineStart);
+    *column = (int)(offset - lineStart + 1);
+    return 1;
+}
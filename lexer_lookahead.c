@@ -0,0 +1,207 @@
+#include <stdlib.h>
+#include "lexer_internal.h"
+
+// Token lookahead for parsers. The tokens from the oldest mark (or from the
+// next token, with no marks) to the last one fetched sit in a ring of Tokens,
+// each at its position in the stream modulo the capacity, so peeking is an
+// index and rewinding is an assignment. A refill runs nextTokens() into a
+// scratch batch of up to LOOKAHEAD_BATCH tokens, which keeps the scanning in
+// the batch loop, then spreads the batch over the free slots.
+
+#define LOOKAHEAD_BATCH 256 // Tokens fetched per refill at most
+
+struct Lookahead
+{
+    Token* ring;
+    size_t mask;      // Capacity - 1
+    size_t next;      // Stream position of the next token
+    size_t end;       // One past the last token fetched
+    int ended;        // nextTokens() has returned 0
+    Token eof;        // What peeking past the end gives
+    size_t* marks;    // Positions of the marks, oldest first
+    size_t markCount, markCap;
+
+    TokenType type[LOOKAHEAD_BATCH];
+    size_t start[LOOKAHEAD_BATCH];
+    size_t length[LOOKAHEAD_BATCH];
+    int line[LOOKAHEAD_BATCH];
+    int column[LOOKAHEAD_BATCH];
+    KeywordId keyword[LOOKAHEAD_BATCH];
+    uint32_t symbol[LOOKAHEAD_BATCH];
+};
+
+int setLexerLookahead(LexerState* lx, size_t capacity)
+{
+    Lookahead* la = lx->lookahead;
+    if (la != NULL && (la->end > 0 || la->ended))
+    {
+        return 0;
+    }
+    size_t n = 2;
+    while (n < capacity)
+    {
+        n *= 2;
+    }
+    Token* ring = malloc(n * sizeof(Token));
+    if (ring == NULL)
+    {
+        return 0;
+    }
+    if (la == NULL)
+    {
+        la = calloc(1, sizeof(Lookahead));
+        if (la == NULL)
+        {
+            free(ring);
+            return 0;
+        }
+        lx->lookahead = la;
+    }
+    free(la->ring);
+    la->ring = ring;
+    la->mask = n - 1;
+    return 1;
+}
+
+// The lexer's ring, set up with the default capacity on first use. NULL when
+// out of memory.
+static Lookahead* getLookahead(LexerState* lx)
+{
+    if (lx->lookahead == NULL)
+    {
+        setLexerLookahead(lx, LEXER_LOOKAHEAD);
+    }
+    return lx->lookahead;
+}
+
+// Fetch one batch into the free slots. Returns 0 at the end of the input or
+// when the ring is full.
+static int refillLookahead(LexerState* lx, Lookahead* la)
+{
+    size_t first = (la->markCount > 0) ? la->marks[0] : la->next;
+    size_t room = la->mask + 1 - (la->end - first);
+    if (room == 0)
+    {
+        return 0;
+    }
+    // A streamed input keeps the text of the tokens held, not just the batch's
+    lx->holdPos = (first < la->end) ? la->ring[first & la->mask].offset : SIZE_MAX;
+    TokenBatch batch = { la->type, la->start, la->length, la->line, la->column, la->keyword, la->symbol,
+                         (room < LOOKAHEAD_BATCH) ? room : LOOKAHEAD_BATCH };
+    size_t n = nextTokens(lx, &batch);
+    if (n == 0)
+    {
+        la->ended = 1;
+        la->eof.length = 0;
+        la->eof.offset = lx->tokStart;
+        lexerLineColumn(lx, la->eof.offset, &la->eof.line, &la->eof.column);
+        la->eof.type = UNKNOWN;
+        la->eof.keyword = KW_NONE;
+        la->eof.symbol = NO_SYMBOL;
+        return 0;
+    }
+    for (size_t i = 0; i < n; i++)
+    {
+        Token* t = &la->ring[(la->end + i) & la->mask];
+        t->length = la->length[i];
+        t->offset = la->start[i];
+        t->line = la->line[i];
+        t->column = la->column[i];
+        t->type = la->type[i];
+        t->keyword = la->keyword[i];
+        t->symbol = la->symbol[i];
+    }
+    la->end += n;
+    return 1;
+}
+
+const Token* peekToken(LexerState* lx, size_t k)
+{
+    Lookahead* la = getLookahead(lx);
+    if (la == NULL)
+    {
+        return NULL;
+    }
+    while (la->next + k >= la->end && !la->ended)
+    {
+        if (!refillLookahead(lx, la) && !la->ended)
+        {
+            return NULL; // The ring is full
+        }
+    }
+    // The lexeme is set here: a refill may move a streamed input's window
+    Token* t = (la->next + k < la->end) ? &la->ring[(la->next + k) & la->mask] : &la->eof;
+    t->lexeme = lexerTextAt(lx, t->offset);
+    return t;
+}
+
+void consumeToken(LexerState* lx)
+{
+    Lookahead* la = getLookahead(lx);
+    if (la == NULL)
+    {
+        return;
+    }
+    if (la->next == la->end)
+    {
+        peekToken(lx, 0);
+    }
+    if (la->next < la->end)
+    {
+        la->next++;
+    }
+}
+
+size_t markTokens(LexerState* lx)
+{
+    Lookahead* la = getLookahead(lx);
+    if (la == NULL)
+    {
+        return NO_MARK;
+    }
+    if (la->markCount == la->markCap)
+    {
+        size_t n = (la->markCap > 0) ? la->markCap * 2 : 16;
+        size_t* marks = realloc(la->marks, n * sizeof(size_t));
+        if (marks == NULL)
+        {
+            return NO_MARK;
+        }
+        la->marks = marks;
+        la->markCap = n;
+    }
+    la->marks[la->markCount] = la->next;
+    return la->markCount++;
+}
+
+void rewindTokens(LexerState* lx, size_t mark)
+{
+    Lookahead* la = lx->lookahead;
+    if (la != NULL && mark < la->markCount)
+    {
+        la->next = la->marks[mark];
+        la->markCount = mark;
+    }
+}
+
+void unmarkTokens(LexerState* lx, size_t mark)
+{
+    Lookahead* la = lx->lookahead;
+    if (la != NULL && mark < la->markCount)
+    {
+        la->markCount = mark;
+    }
+}
+
+void freeLookahead(LexerState* lx)
+{
+    Lookahead* la = lx->lookahead;
+    if (la == NULL)
+    {
+        return;
+    }
+    free(la->ring);
+    free(la->marks);
+    free(la);
+    lx->lookahead = NULL;
+}
@@ -0,0 +1,302 @@
+#include <stdlib.h>
+#include <string.h>
+#include "lexer_simd.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define HAVE_X86_SIMD 1
+#endif
+
+// --- Scalar kernels (also used for the tails of the vector kernels) ---
+
+static const char* skipSpaceScalar(const char* p, const char* end)
+{
+    for (; p < end; p++)
+    {
+        unsigned char c = (unsigned char)*p;
+        if (c != ' ' && (unsigned char)(c - '\t') > '\r' - '\t')
+        {
+            break;
+        }
+    }
+    return p;
+}
+
+static const char* findNewlineScalar(const char* p, const char* end)
+{
+    const char* nl = memchr(p, '\n', (size_t)(end - p));
+    return (nl != NULL) ? nl : end;
+}
+
+static const char* findCommentEndScalar(const char* p, const char* end)
+{
+    for (; p < end; p++)
+    {
+        if (*p == '*' && p + 1 < end && p[1] == '/')
+        {
+            break;
+        }
+    }
+    return p;
+}
+
+static size_t findNewlinesScalar(const char* p, const char* end, size_t base, size_t* out)
+{
+    size_t n = 0;
+    const char* from = p;
+    while ((p = findNewlineScalar(p, end)) < end)
+    {
+        out[n++] = base + (size_t)(++p - from);
+    }
+    return n;
+}
+
+static const char* findLiteralStopScalar(const char* p, const char* end, char quote)
+{
+    while (p < end && *p != quote && *p != '\\' && *p != '\n' && (unsigned char)*p < 0x80)
+    {
+        p++;
+    }
+    return p;
+}
+
+static const ScanKernels scalarKernels = {
+    "scalar", skipSpaceScalar, findNewlineScalar, findNewlinesScalar, findCommentEndScalar, findLiteralStopScalar
+};
+
+#ifdef HAVE_X86_SIMD
+
+// --- SSE2 kernels, 16 bytes per step ---
+
+// Mask of the whitespace bytes in v: ' ' or '\t'..'\r'
+__attribute__((target("sse2")))
+static inline __m128i spaceMask128(__m128i v)
+{
+    __m128i t = _mm_sub_epi8(v, _mm_set1_epi8('\t'));
+    __m128i ctl = _mm_cmpeq_epi8(_mm_min_epu8(t, _mm_set1_epi8('\r' - '\t')), t);
+    return _mm_or_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8(' ')), ctl);
+}
+
+__attribute__((target("sse2")))
+static const char* skipSpaceSse2(const char* p, const char* end)
+{
+    while (end - p >= 16)
+    {
+        __m128i v = _mm_loadu_si128((const __m128i*)p);
+        unsigned stop = ~(unsigned)_mm_movemask_epi8(spaceMask128(v)) & 0xFFFFu;
+        if (stop != 0)
+        {
+            return p + __builtin_ctz(stop);
+        }
+        p += 16;
+    }
+    return skipSpaceScalar(p, end);
+}
+
+__attribute__((target("sse2")))
+static const char* findNewlineSse2(const char* p, const char* end)
+{
+    const __m128i nl = _mm_set1_epi8('\n');
+    while (end - p >= 16)
+    {
+        unsigned m = (unsigned)_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_loadu_si128((const __m128i*)p), nl));
+        if (m != 0)
+        {
+            return p + __builtin_ctz(m);
+        }
+        p += 16;
+    }
+    return findNewlineScalar(p, end);
+}
+
+__attribute__((target("sse2")))
+static const char* findCommentEndSse2(const char* p, const char* end)
+{
+    const __m128i star = _mm_set1_epi8('*');
+    const __m128i slash = _mm_set1_epi8('/');
+    while (end - p >= 17) // The second load reads one byte further
+    {
+        __m128i v = _mm_loadu_si128((const __m128i*)p);
+        __m128i next = _mm_loadu_si128((const __m128i*)(p + 1));
+        unsigned hit = (unsigned)_mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi8(v, star), _mm_cmpeq_epi8(next, slash)));
+        if (hit != 0)
+        {
+            return p + __builtin_ctz(hit);
+        }
+        p += 16;
+    }
+    return findCommentEndScalar(p, end);
+}
+
+__attribute__((target("sse2")))
+static size_t findNewlinesSse2(const char* p, const char* end, size_t base, size_t* out)
+{
+    const __m128i nl = _mm_set1_epi8('\n');
+    const char* from = p;
+    size_t n = 0;
+    while (end - p >= 16)
+    {
+        unsigned m = (unsigned)_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_loadu_si128((const __m128i*)p), nl));
+        size_t at = base + (size_t)(p - from) + 1;
+        for (; m != 0; m &= m - 1)
+        {
+            out[n++] = at + (size_t)__builtin_ctz(m);
+        }
+        p += 16;
+    }
+    return n + findNewlinesScalar(p, end, base + (size_t)(p - from), out + n);
+}
+
+__attribute__((target("sse2")))
+static const char* findLiteralStopSse2(const char* p, const char* end, char quote)
+{
+    const __m128i q = _mm_set1_epi8(quote);
+    const __m128i bs = _mm_set1_epi8('\\');
+    const __m128i nl = _mm_set1_epi8('\n');
+    while (end - p >= 16)
+    {
+        __m128i v = _mm_loadu_si128((const __m128i*)p);
+        __m128i hit = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(v, q), _mm_cmpeq_epi8(v, bs)), _mm_cmpeq_epi8(v, nl));
+        unsigned m = (unsigned)_mm_movemask_epi8(_mm_or_si128(hit, v)); // The high bits of v: non-ASCII bytes
+        if (m != 0)
+        {
+            return p + __builtin_ctz(m);
+        }
+        p += 16;
+    }
+    return findLiteralStopScalar(p, end, quote);
+}
+
+static const ScanKernels sse2Kernels = {
+    "sse2", skipSpaceSse2, findNewlineSse2, findNewlinesSse2, findCommentEndSse2, findLiteralStopSse2
+};
+
+// --- AVX2 kernels, 32 bytes per step ---
+
+__attribute__((target("avx2")))
+static const char* skipSpaceAvx2(const char* p, const char* end)
+{
+    const __m256i sp = _mm256_set1_epi8(' ');
+    const __m256i tab = _mm256_set1_epi8('\t');
+    const __m256i span = _mm256_set1_epi8('\r' - '\t');
+    while (end - p >= 32)
+    {
+        __m256i v = _mm256_loadu_si256((const __m256i*)p);
+        __m256i t = _mm256_sub_epi8(v, tab);
+        __m256i ws = _mm256_or_si256(_mm256_cmpeq_epi8(v, sp), _mm256_cmpeq_epi8(_mm256_min_epu8(t, span), t));
+        unsigned stop = ~(unsigned)_mm256_movemask_epi8(ws);
+        if (stop != 0)
+        {
+            return p + __builtin_ctz(stop);
+        }
+        p += 32;
+    }
+    return skipSpaceSse2(p, end);
+}
+
+__attribute__((target("avx2")))
+static const char* findNewlineAvx2(const char* p, const char* end)
+{
+    const __m256i nl = _mm256_set1_epi8('\n');
+    while (end - p >= 32)
+    {
+        unsigned m = (unsigned)_mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i*)p), nl));
+        if (m != 0)
+        {
+            return p + __builtin_ctz(m);
+        }
+        p += 32;
+    }
+    return findNewlineSse2(p, end);
+}
+
+__attribute__((target("avx2")))
+static const char* findCommentEndAvx2(const char* p, const char* end)
+{
+    const __m256i star = _mm256_set1_epi8('*');
+    const __m256i slash = _mm256_set1_epi8('/');
+    while (end - p >= 33) // The second load reads one byte further
+    {
+        __m256i v = _mm256_loadu_si256((const __m256i*)p);
+        __m256i next = _mm256_loadu_si256((const __m256i*)(p + 1));
+        unsigned hit = (unsigned)_mm256_movemask_epi8(_mm256_and_si256(_mm256_cmpeq_epi8(v, star), _mm256_cmpeq_epi8(next, slash)));
+        if (hit != 0)
+        {
+            return p + __builtin_ctz(hit);
+        }
+        p += 32;
+    }
+    return findCommentEndSse2(p, end);
+}
+
+__attribute__((target("avx2")))
+static size_t findNewlinesAvx2(const char* p, const char* end, size_t base, size_t* out)
+{
+    const __m256i nl = _mm256_set1_epi8('\n');
+    const char* from = p;
+    size_t n = 0;
+    while (end - p >= 32)
+    {
+        unsigned m = (unsigned)_mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i*)p), nl));
+        size_t at = base + (size_t)(p - from) + 1;
+        for (; m != 0; m &= m - 1)
+        {
+            out[n++] = at + (size_t)__builtin_ctz(m);
+        }
+        p += 32;
+    }
+    return n + findNewlinesSse2(p, end, base + (size_t)(p - from), out + n);
+}
+
+__attribute__((target("avx2")))
+static const char* findLiteralStopAvx2(const char* p, const char* end, char quote)
+{
+    const __m256i q = _mm256_set1_epi8(quote);
+    const __m256i bs = _mm256_set1_epi8('\\');
+    const __m256i nl = _mm256_set1_epi8('\n');
+    while (end - p >= 32)
+    {
+        __m256i v = _mm256_loadu_si256((const __m256i*)p);
+        __m256i hit = _mm256_or_si256(_mm256_or_si256(_mm256_cmpeq_epi8(v, q), _mm256_cmpeq_epi8(v, bs)), _mm256_cmpeq_epi8(v, nl));
+        unsigned m = (unsigned)_mm256_movemask_epi8(_mm256_or_si256(hit, v)); // The high bits of v: non-ASCII bytes
+        if (m != 0)
+        {
+            return p + __builtin_ctz(m);
+        }
+        p += 32;
+    }
+    return findLiteralStopSse2(p, end, quote);
+}
+
+static const ScanKernels avx2Kernels = {
+    "avx2", skipSpaceAvx2, findNewlineAvx2, findNewlinesAvx2, findCommentEndAvx2, findLiteralStopAvx2
+};
+
+#endif // HAVE_X86_SIMD
+
+const ScanKernels* selectScanKernels()
+{
+    const char* want = getenv("LEXER_SIMD");
+    if (want != NULL && strcmp(want, "scalar") == 0)
+    {
+        return &scalarKernels;
+    }
+#ifdef HAVE_X86_SIMD
+    __builtin_cpu_init();
+    int avx2 = __builtin_cpu_supports("avx2");
+    int sse2 = __builtin_cpu_supports("sse2");
+    if (want != NULL && strcmp(want, "sse2") == 0)
+    {
+        return sse2 ? &sse2Kernels : &scalarKernels;
+    }
+    if (avx2)
+    {
+        return &avx2Kernels;
+    }
+    if (sse2)
+    {
+        return &sse2Kernels;
+    }
+#endif
+    return &scalarKernels;
+}
@@ -0,0 +1,31 @@
+#ifndef LEXER_SIMD_H
+#define LEXER_SIMD_H
+
+#include <stddef.h>
+
+// Vectorised skip kernels for the lexer's fast paths. Each kernel scans
+// [p, end) and returns a pointer to the first byte the lexer has to look
+// at (or end). Line numbers are not tracked here: the lexer looks them up
+// in its newline index, which findNewlines builds.
+typedef struct {
+    const char* name; // "avx2", "sse2" or "scalar"
+
+    // First byte that is not ' ', '\t', '\n', '\v', '\f' or '\r'
+    const char* (*skipSpace)(const char* p, const char* end);
+    // First '\n'
+    const char* (*findNewline)(const char* p, const char* end);
+    // Store in out[] the offset after every '\n' in [p, end), counting p as
+    // offset 'base', and return how many there were (at most end - p)
+    size_t (*findNewlines)(const char* p, const char* end, size_t base, size_t* out);
+    // The '*' of the first "*/"
+    const char* (*findCommentEnd)(const char* p, const char* end);
+    // First 'quote', '\\', '\n' or byte >= 0x80 (the bytes that end a run of
+    // ASCII literal body; UTF-8 is decoded by the lexer)
+    const char* (*findLiteralStop)(const char* p, const char* end, char quote);
+} ScanKernels;
+
+// Best kernels for this CPU, chosen at runtime. Setting LEXER_SIMD to
+// "scalar", "sse2" or "avx2" forces a particular set when it is supported.
+const ScanKernels* selectScanKernels();
+
+#endif
@@ -0,0 +1,663 @@
+#include <stdlib.h>
+#include <string.h>
+#include "lexer_internal.h"
+#include "pool.h"
+
+// Intra-file parallel lexing. The input is cut into chunks at line starts and
+// every chunk is lexed on its own thread as if a token began there. That guess
+// is wrong when the chunk starts inside a block comment or a string continued
+// with a backslash, so the chunks are then stitched together in order: the
+// scanner keeps no state between tokens except its position, so a chunk's
+// tokens are right from the first one after which its lexer is at the same
+// position as the real stream. Where no such token exists the gap is lexed
+// again from the real position. Each chunk also indexes its newlines, and the
+// pieces are joined into the lexer's newline index, which every chunk lexer
+// of the window then reads lines from. Delimiter matching, which depends on
+// everything before it, is done per stitched segment and then composed.
+//
+// Work proceeds in windows of a few chunks per thread, so memory stays
+// bounded however large the input is. A window that runs out of memory is
+// dropped, and the sequential lexer takes over from where it began.
+
+#define SPLIT_CHUNK_SIZE (1 << 20)  // Default bytes per chunk
+#define SPLIT_CHUNKS_PER_THREAD 4   // Chunks per thread in each window
+#define NO_SYNC ((size_t)-1)
+
+// Tokens of one chunk, as parallel arrays. after[i] is where the scan for the
+// token after token i starts, which is all the lexer state there is.
+typedef struct {
+    TokenType* type;
+    size_t* start;
+    size_t* length;
+    KeywordId* keyword;
+    size_t* after;
+    size_t count, capacity;
+    DiagLog diags;
+#ifdef LEXER_STATS
+    LexerStats stats; // Of the chunk lexer
+#endif
+
+    size_t begin;   // Where the chunk lexer started
+    size_t limit;   // Start of the next chunk; the lexer stops once past it
+    LineIndex lines; // Line starts in [begin, limit)
+    size_t end;     // Where the scan after the last token starts (srcLen at EOF)
+    int failed;     // Out of memory: the tokens stop short
+} Chunk;
+
+// A delimiter that would be reported unmatched if no count came into the segment
+typedef struct {
+    size_t token;  // Index in the segment's chunk
+    char delim;    // ')', '}' or ']'
+    int live;      // Still unmatched with the real counts coming in
+} DelimEvent;
+
+// A run of chunk tokens that belongs to the final stream
+typedef struct {
+    Chunk* chunk;
+    size_t from, to;
+    int trailing;       // Also print what was logged after the last token (at EOF)
+    int net[3];         // Change of the paren/brace/bracket counts over the run
+    DelimEvent* events; // Each point where a count (from 0) first reaches -1, -2, ...
+    size_t eventCount, eventCap;
+    int failed;         // Out of memory: 'events' stop short
+} Segment;
+
+struct SplitState {
+    LexerState* lx;
+    int threads;
+    size_t chunkSize;
+    Chunk* chunks;      // The speculatively lexed chunks of the current window
+    Chunk* fixups;      // Per chunk: tokens lexed again from the real position
+    int chunkMax, chunkCount;
+    Segment* segs;
+    int segCount;
+
+    size_t nextBegin;   // Where the next window starts
+    size_t truth;       // Where the next scan of the real stream starts
+    int done;           // The real stream has reached EOF
+    size_t resume;      // Where the window that ran out of memory began, or NO_SYNC
+
+    // Hand-out position
+    int seg;
+    size_t pos, diag, event;
+};
+
+// --- Growable storage ---
+
+// Grow the array p of *cap elements of 'size' bytes to hold 'need'. Returns
+// NULL, leaving p and *cap as they were, when out of memory.
+static void* growArray(void* p, size_t* cap, size_t need, size_t size)
+{
+    if (need <= *cap)
+    {
+        return p;
+    }
+    size_t n = (*cap > 0) ? *cap * 2 : 1024;
+    while (n < need)
+    {
+        n *= 2;
+    }
+    void* grown = realloc(p, n * size);
+    if (grown != NULL)
+    {
+        *cap = n;
+    }
+    return grown;
+}
+
+// Grow c's token array 'field' from c->capacity to hold one more token
+#define GROW_TOKENS(c, field, cap)                                                      \
+    do                                                                                  \
+    {                                                                                   \
+        cap = (c)->capacity;                                                            \
+        void* grown = growArray((c)->field, &cap, (c)->count + 1, sizeof(*(c)->field)); \
+        if (grown == NULL)                                                              \
+        {                                                                               \
+            return 0;                                                                   \
+        }                                                                               \
+        (c)->field = grown;                                                             \
+    } while (0)
+
+// Returns 0 when out of memory
+static int pushToken(Chunk* c, const LexerState* cl, TokenType type)
+{
+    if (c->count == c->capacity)
+    {
+        size_t cap;
+        GROW_TOKENS(c, type, cap);
+        GROW_TOKENS(c, start, cap);
+        GROW_TOKENS(c, length, cap);
+        GROW_TOKENS(c, keyword, cap);
+        GROW_TOKENS(c, after, cap);
+        c->capacity = cap;
+    }
+    size_t i = c->count++;
+    c->type[i] = type;
+    c->start[i] = cl->tokStart;
+    c->length[i] = cl->tokLen;
+    c->keyword[i] = cl->tokKeyword;
+    return 1;
+}
+
+static void resetChunk(Chunk* c)
+{
+    c->count = 0;
+    c->failed = 0;
+    c->diags.textLen = 0;
+    c->diags.count = 0;
+    c->diags.token = 0;
+}
+
+static void freeChunk(Chunk* c)
+{
+    free(c->type);
+    free(c->start);
+    free(c->length);
+    free(c->keyword);
+    free(c->after);
+    freeDiagLog(&c->diags);
+    freeLineIndex(&c->lines);
+}
+
+// --- Chunk lexing ---
+
+// Where the next scan of cl starts
+static size_t scanPosition(const LexerState* cl)
+{
+    return cl->eofFlag ? cl->srcLen : cl->readPos - 1;
+}
+
+// Set up cl to lex lx's buffer from byte 'pos' as if a token began there,
+// with lx's newline index
+static void startChunkLexer(LexerState* cl, LexerState* lx, size_t pos, DiagLog* log)
+{
+    startBufferLexer(cl, lx->srcBuf, lx->srcLen, pos, 0, 1);
+    cl->sharedLines = &lx->lineIndex;
+    cl->errStream = lx->errStream;
+    cl->scan = lx->scan;
+    cl->keepDirectives = lx->keepDirectives;
+    cl->dialect = lx->dialect;
+    cl->diagLog = log;
+    cl->noDelimiters = 1;
+}
+
+// Lex into 'out' until the next scan would start at or after 'limit'. With a
+// 'target', stop early at the first token after which cl is where target's
+// lexer was after one of its tokens, and return that token's index.
+static size_t scanChunk(LexerState* cl, Chunk* out, size_t limit, const Chunk* target)
+{
+    size_t pos = scanPosition(cl);
+    size_t sync = NO_SYNC;
+    size_t j = 0;
+    while (pos < limit)
+    {
+        out->diags.token = out->count;
+        TokenType type = lexerScanToken(cl);
+        pos = scanPosition(cl);
+        if (type == UNKNOWN && cl->tokLen == 0)
+        {
+            break; // End of input
+        }
+        if (!pushToken(out, cl, type))
+        {
+            out->failed = 1;
+            break;
+        }
+        out->after[out->count - 1] = pos;
+        if (target != NULL)
+        {
+            while (j < target->count && target->after[j] < pos)
+            {
+                j++;
+            }
+            if (j < target->count && target->after[j] == pos)
+            {
+                sync = j;
+                break;
+            }
+        }
+    }
+    out->end = pos;
+    return sync;
+}
+
+static void indexChunkTask(size_t index, void* arg)
+{
+    SplitState* sp = arg;
+    Chunk* c = &sp->chunks[index];
+    initLineIndex(&c->lines, 0, 0, c->begin);
+    scanLineStarts(&c->lines, sp->lx->scan, sp->lx->srcBuf + c->begin, c->limit);
+}
+
+static void lexChunkTask(size_t index, void* arg)
+{
+    SplitState* sp = arg;
+    Chunk* c = &sp->chunks[index];
+    LexerState cl;
+    resetChunk(c);
+    startChunkLexer(&cl, sp->lx, c->begin, &c->diags);
+    scanChunk(&cl, c, c->limit, NULL);
+    STATS_ONLY(c->stats = cl.stats;)
+}
+
+// --- Stitching ---
+
+// Index of the token of c after which its lexer was at 'pos', or NO_SYNC
+static size_t findAfter(const Chunk* c, size_t pos)
+{
+    size_t lo = 0, hi = c->count;
+    while (lo < hi)
+    {
+        size_t mid = lo + (hi - lo) / 2;
+        if (c->after[mid] < pos)
+        {
+            lo = mid + 1;
+        }
+        else
+        {
+            hi = mid;
+        }
+    }
+    return (lo < c->count && c->after[lo] == pos) ? lo : NO_SYNC;
+}
+
+static void addSegment(SplitState* sp, Chunk* c, size_t from, size_t to)
+{
+    Segment* sg = &sp->segs[sp->segCount++];
+    sg->chunk = c;
+    sg->from = from;
+    sg->to = to;
+    sg->trailing = 0;
+    sg->eventCount = 0;
+    sg->failed = 0;
+}
+
+// Follow the real stream through the chunks of the window
+static void stitchChunks(SplitState* sp)
+{
+    LexerState* lx = sp->lx;
+    sp->segCount = 0;
+    for (int k = 0; k < sp->chunkCount && !sp->done; k++)
+    {
+        Chunk* c = &sp->chunks[k];
+        size_t from = 0;
+        if (sp->truth != c->begin)
+        {
+            if (sp->truth >= c->limit && sp->truth != c->end)
+            {
+                continue; // The real stream passed over the whole chunk
+            }
+            size_t j = findAfter(c, sp->truth);
+            if (j == NO_SYNC)
+            {
+                // The chunk started mid-comment or mid-string: lex from the
+                // real position until the two agree or the chunk runs out
+                Chunk* f = &sp->fixups[k];
+                LexerState cl;
+                resetChunk(f);
+                startChunkLexer(&cl, lx, sp->truth, &f->diags);
+                j = scanChunk(&cl, f, c->limit, c);
+                STATS_ONLY(addLexerStats(&lx->stats, &cl.stats);)
+                addSegment(sp, f, 0, f->count);
+                sp->truth = f->end;
+                if (j == NO_SYNC)
+                {
+                    sp->done = (sp->truth >= lx->srcLen);
+                    continue;
+                }
+            }
+            from = j + 1;
+        }
+        addSegment(sp, c, from, c->count);
+        sp->truth = c->end;
+        sp->done = (sp->truth >= lx->srcLen);
+    }
+    if (sp->done)
+    {
+        if (sp->segCount > 0)
+        {
+            sp->segs[sp->segCount - 1].trailing = 1;
+        }
+    }
+}
+
+// --- Delimiter matching ---
+
+static int delimIndex(char ch)
+{
+    switch (ch)
+    {
+        case '(': case ')': return 0;
+        case '{': case '}': return 1;
+        case '[': case ']': return 2;
+    }
+    return -1;
+}
+
+static void countDelimitersTask(size_t index, void* arg)
+{
+    SplitState* sp = arg;
+    const LexerState* lx = sp->lx;
+    Segment* sg = &sp->segs[index];
+    const Chunk* c = sg->chunk;
+    int depth[3] = { 0, 0, 0 };
+    int low[3] = { 0, 0, 0 };
+    for (size_t i = sg->from; i < sg->to; i++)
+    {
+        if (c->type[i] != SYMBOL)
+        {
+            continue;
+        }
+        char ch = lx->srcBuf[c->start[i]];
+        int d = delimIndex(ch);
+        if (d < 0)
+        {
+            continue;
+        }
+        if (ch == '(' || ch == '{' || ch == '[')
+        {
+            depth[d]++;
+            continue;
+        }
+        if (--depth[d] >= low[d])
+        {
+            continue;
+        }
+        low[d] = depth[d];
+        DelimEvent* events = growArray(sg->events, &sg->eventCap, sg->eventCount + 1, sizeof(DelimEvent));
+        if (events == NULL)
+        {
+            sg->failed = 1;
+            return;
+        }
+        sg->events = events;
+        DelimEvent* ev = &sg->events[sg->eventCount++];
+        ev->token = i;
+        ev->delim = ch;
+    }
+    memcpy(sg->net, depth, sizeof(depth));
+}
+
+// Run the lexer's clamped delimiter counts through the segments in order:
+// with c open coming in, only the events past the first c of a kind fire
+static void composeDelimiters(SplitState* sp)
+{
+    LexerState* lx = sp->lx;
+    int* counts[3] = { &lx->paren_count, &lx->brace_count, &lx->bracket_count };
+    for (int s = 0; s < sp->segCount; s++)
+    {
+        Segment* sg = &sp->segs[s];
+        int seen[3] = { 0, 0, 0 };
+        for (size_t e = 0; e < sg->eventCount; e++)
+        {
+            int d = delimIndex(sg->events[e].delim);
+            seen[d]++;
+            sg->events[e].live = (seen[d] > *counts[d]);
+        }
+        for (int d = 0; d < 3; d++)
+        {
+            int in = *counts[d];
+            *counts[d] = in + sg->net[d] + ((seen[d] > in) ? seen[d] - in : 0);
+        }
+    }
+}
+
+// --- Windows ---
+
+static void beginSegment(SplitState* sp)
+{
+    sp->pos = 0;
+    sp->diag = 0;
+    sp->event = 0;
+    if (sp->seg < sp->segCount)
+    {
+        const Segment* sg = &sp->segs[sp->seg];
+        const DiagLog* log = &sg->chunk->diags;
+        sp->pos = sg->from;
+        while (sp->diag < log->count && log->entries[sp->diag].token < sg->from)
+        {
+            sp->diag++;
+        }
+    }
+}
+
+// Lex the next window of chunks in parallel and stitch them. Returns 0 once
+// the input is exhausted, or with sp->resume set when out of memory.
+static int lexWindow(SplitState* sp)
+{
+    LexerState* lx = sp->lx;
+    if (sp->done)
+    {
+        return 0;
+    }
+    size_t from = sp->truth;
+
+    // Cut the window into chunks that start at line starts
+    sp->chunkCount = 0;
+    size_t pos = sp->nextBegin;
+    while (sp->chunkCount < sp->chunkMax && pos < lx->srcLen)
+    {
+        Chunk* c = &sp->chunks[sp->chunkCount++];
+        c->begin = pos;
+        if (lx->srcLen - pos <= sp->chunkSize)
+        {
+            pos = lx->srcLen;
+        }
+        else
+        {
+            const char* nl = lx->scan->findNewline(lx->srcBuf + pos + sp->chunkSize - 1, lx->srcBuf + lx->srcLen);
+            pos = (size_t)(nl - lx->srcBuf) + (nl < lx->srcBuf + lx->srcLen);
+        }
+        c->limit = pos;
+    }
+    sp->nextBegin = pos;
+    if (sp->chunkCount == 0)
+    {
+        sp->done = 1;
+        return 0;
+    }
+
+    // The lexer's index must reach the window before the pieces are added
+    parallelFor((size_t)sp->chunkCount, sp->threads, indexChunkTask, sp);
+    lexerLineAt(lx, sp->chunks[0].begin);
+    for (int k = 0; k < sp->chunkCount; k++)
+    {
+        mergeLineIndex(&lx->lineIndex, &sp->chunks[k].lines);
+    }
+
+    parallelFor((size_t)sp->chunkCount, sp->threads, lexChunkTask, sp);
+    for (int k = 0; k < sp->chunkCount; k++)
+    {
+        if (sp->chunks[k].failed)
+        {
+            sp->resume = from;
+            return 0;
+        }
+    }
+#ifdef LEXER_STATS
+    for (int k = 0; k < sp->chunkCount; k++)
+    {
+        addLexerStats(&lx->stats, &sp->chunks[k].stats);
+    }
+#endif
+    stitchChunks(sp);
+    parallelFor((size_t)sp->segCount, sp->threads, countDelimitersTask, sp);
+    for (int s = 0; s < sp->segCount; s++)
+    {
+        if (sp->segs[s].failed || sp->segs[s].chunk->failed)
+        {
+            sp->resume = from;
+            return 0;
+        }
+    }
+    composeDelimiters(sp);
+
+    sp->seg = 0;
+    beginSegment(sp);
+    return 1;
+}
+
+int splitLexer(LexerState* lx, int threads, size_t chunkSize)
+{
+    if (lx->streaming || lx->split != NULL)
+    {
+        return 0;
+    }
+    SplitState* sp = calloc(1, sizeof(SplitState));
+    if (sp == NULL)
+    {
+        return 0;
+    }
+    sp->lx = lx;
+    sp->threads = (threads > 0) ? threads : poolDefaultThreads();
+    sp->chunkSize = (chunkSize > 0) ? chunkSize : SPLIT_CHUNK_SIZE;
+    sp->chunkMax = sp->threads * SPLIT_CHUNKS_PER_THREAD;
+    sp->chunks = calloc((size_t)sp->chunkMax, sizeof(Chunk));
+    sp->fixups = calloc((size_t)sp->chunkMax, sizeof(Chunk));
+    sp->segs = calloc((size_t)sp->chunkMax * 2, sizeof(Segment));
+    if (sp->chunks == NULL || sp->fixups == NULL || sp->segs == NULL)
+    {
+        free(sp->chunks);
+        free(sp->fixups);
+        free(sp->segs);
+        free(sp);
+        return 0;
+    }
+    // Carry on from wherever the lexer is now
+    sp->truth = sp->nextBegin = scanPosition(lx);
+    sp->done = lx->eofFlag;
+    sp->resume = NO_SYNC;
+    lx->split = sp;
+    return 1;
+}
+
+// Pass on what chunk c logged while scanning its token 'token'
+static void printDiagnostics(SplitState* sp, const Chunk* c, size_t token)
+{
+    const DiagLog* log = &c->diags;
+    while (sp->diag < log->count && log->entries[sp->diag].token == token)
+    {
+        const DiagEntry* e = &log->entries[sp->diag++];
+        STAT_DIAG(sp->lx, e->code);
+        copyDiagnostic(&sp->lx->diags, log, e);
+    }
+}
+
+size_t splitTokens(LexerState* lx, TokenBatch* batch)
+{
+    SplitState* sp = lx->split;
+    size_t n = 0;
+    while (n < batch->capacity)
+    {
+        if (sp->seg >= sp->segCount)
+        {
+            if (!lexWindow(sp))
+            {
+                break;
+            }
+            continue;
+        }
+        Segment* sg = &sp->segs[sp->seg];
+        const Chunk* c = sg->chunk;
+        if (sp->pos == sg->to)
+        {
+            if (sg->trailing)
+            {
+                printDiagnostics(sp, c, c->count);
+            }
+            sp->seg++;
+            beginSegment(sp);
+            continue;
+        }
+
+        // Hand out the token with what the lexer would have printed while scanning it
+        size_t i = sp->pos++;
+        printDiagnostics(sp, c, i);
+        for (; sp->event < sg->eventCount && sg->events[sp->event].token == i; sp->event++)
+        {
+            if (sg->events[sp->event].live)
+            {
+                // The lexer reports it with the line of the character after it
+                const DelimEvent* ev = &sg->events[sp->event];
+                size_t next = c->start[i] + 1;
+                DiagEntry at = { .code = DIAG_UNMATCHED_CLOSE, .offset = c->start[i], .length = 1 };
+                lexerLineColumn(lx, at.offset, &at.line, &at.column);
+                STAT_ADD(lx, errors, 1);
+                addDiagnostic(&lx->diags, &at, "Error at line %d: Unmatched '%c'\n", lexerLineAt(lx, next + (next < lx->srcLen)), ev->delim);
+            }
+        }
+        batch->type[n] = c->type[i];
+        batch->start[n] = c->start[i];
+        batch->length[n] = c->length[i];
+        if (batch->line != NULL || batch->column != NULL)
+        {
+            int column;
+            int line = lexerPosition(lx, c->start[i], &column);
+            if (batch->line != NULL)
+            {
+                batch->line[n] = line;
+            }
+            if (batch->column != NULL)
+            {
+                batch->column[n] = column;
+            }
+        }
+        if (batch->keyword != NULL)
+        {
+            batch->keyword[n] = c->keyword[i];
+        }
+        if (batch->symbol != NULL)
+        {
+            batch->symbol[n] = NO_SYMBOL;
+        }
+        if (lx->interner != NULL && c->type[i] == IDENTIFIER)
+        {
+            uint32_t symbol = internString(lx->interner, lx->srcBuf + c->start[i], c->length[i]);
+            if (batch->symbol != NULL)
+            {
+                batch->symbol[n] = symbol;
+            }
+        }
+        n++;
+    }
+    if (sp->resume != NO_SYNC)
+    {
+        // Out of memory: the sequential lexer goes on from where the window began
+        lx->eofFlag = 0;
+        lx->currentChar = lx->srcBuf[sp->resume];
+        lx->readPos = sp->resume + 1;
+        destroySplit(lx);
+        return (n > 0) ? n : lexerFillTokens(lx, batch);
+    }
+    if (n == 0)
+    {
+        // Leave the lexer as the sequential one ends
+        lx->eofFlag = 1;
+        lx->currentChar = '\0';
+        lx->readPos = lx->srcLen;
+        lx->tokStart = lx->srcLen;
+        lx->tokLen = 0;
+    }
+    return n;
+}
+
+void destroySplit(LexerState* lx)
+{
+    SplitState* sp = lx->split;
+    if (sp == NULL)
+    {
+        return;
+    }
+    for (int k = 0; k < sp->chunkMax; k++)
+    {
+        freeChunk(&sp->chunks[k]);
+        freeChunk(&sp->fixups[k]);
+        free(sp->segs[2 * k].events);
+        free(sp->segs[2 * k + 1].events);
+    }
+    free(sp->chunks);
+    free(sp->fixups);
+    free(sp->segs);
+    free(sp);
+    lx->split = NULL;
+}
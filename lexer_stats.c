@@ -0,0 +1,100 @@
+#include <string.h>
+#include "lexer_internal.h"
+
+// The LEXER_STATS counters, as a struct and as a report. The counting
+// itself is inlined into the scanner (see lexer_internal.h).
+
+int getLexerStats(const LexerState* lx, LexerStats* stats)
+{
+    memset(stats, 0, sizeof(*stats));
+#ifdef LEXER_STATS
+    *stats = lx->stats;
+#if defined(__x86_64__) || defined(__i386__)
+    stats->tickUnit = "cycles";
+#else
+    stats->tickUnit = "ns";
+#endif
+    return 1;
+#else
+    (void)lx;
+    return 0;
+#endif
+}
+
+void addLexerStats(LexerStats* into, const LexerStats* from)
+{
+    for (int t = 0; t <= UNKNOWN; t++)
+    {
+        into->tokens[t] += from->tokens[t];
+        into->sampled[t] += from->sampled[t];
+        into->sampledTicks[t] += from->sampledTicks[t];
+        for (int b = 0; b < LEXER_STATS_LENGTHS; b++)
+        {
+            into->lengths[t][b] += from->lengths[t][b];
+        }
+    }
+    for (int b = 0; b < 4; b++)
+    {
+        into->numberBases[b] += from->numberBases[b];
+    }
+    into->whitespaceBytes += from->whitespaceBytes;
+    into->commentBytes += from->commentBytes;
+    into->preprocessorBytes += from->preprocessorBytes;
+    into->errors += from->errors;
+    into->warnings += from->warnings;
+    if (into->tickUnit == NULL)
+    {
+        into->tickUnit = from->tickUnit;
+    }
+}
+
+void printLexerStats(const LexerStats* stats, FILE* out)
+{
+    static const char* const lengthNames[LEXER_STATS_LENGTHS] = { "1", "2", "3-4", "5-8", "9-16", "17-32", "33-64", "65+" };
+    static const char* const baseNames[4] = { "decimal", "octal", "hex", "binary" };
+    uint64_t total = 0;
+    for (int t = 0; t <= UNKNOWN; t++)
+    {
+        total += stats->tokens[t];
+    }
+
+    fprintf(out, "Stats   : %llu tokens, %llu errors, %llu warnings\n", (unsigned long long)total,
+            (unsigned long long)stats->errors, (unsigned long long)stats->warnings);
+    fprintf(out, "Skipped : %llu whitespace, %llu comment, %llu preprocessor bytes\n",
+            (unsigned long long)stats->whitespaceBytes, (unsigned long long)stats->commentBytes,
+            (unsigned long long)stats->preprocessorBytes);
+    fprintf(out, "Numbers :");
+    for (int b = 0; b < 4; b++)
+    {
+        fprintf(out, " %llu %s%s", (unsigned long long)stats->numberBases[b], baseNames[b], (b < 3) ? "," : "\n");
+    }
+
+    // One row per token type: count, mean sampled time, length histogram
+    fprintf(out, "%-20s %10s %10s", "Type", "Tokens", stats->tickUnit ? stats->tickUnit : "ticks");
+    for (int b = 0; b < LEXER_STATS_LENGTHS; b++)
+    {
+        fprintf(out, " %8s", lengthNames[b]);
+    }
+    fputc('\n', out);
+    for (int t = 0; t <= UNKNOWN; t++)
+    {
+        if (stats->tokens[t] == 0)
+        {
+            continue;
+        }
+        fprintf(out, "%-20s %10llu", getTokenTypeString((TokenType)t), (unsigned long long)stats->tokens[t]);
+        if (stats->sampled[t] > 0)
+        {
+            fprintf(out, " %10.1f", (double)stats->sampledTicks[t] / (double)stats->sampled[t]);
+        }
+        else
+        {
+            fprintf(out, " %10s", "-");
+        }
+        for (int b = 0; b < LEXER_STATS_LENGTHS; b++)
+        {
+            fprintf(out, " %8llu", (unsigned long long)stats->lengths[t][b]);
+        }
+        fputc('\n', out);
+    }
+}
@@ -0,0 +1,95 @@
+#include "lexer_internal.h"
+#include "lexer_xid.h"
+
+// UTF-8 for the lexer: bytes >= 0x80 are decoded only where the scanner
+// meets them (the literal kernel stops at them too), so ASCII text never
+// comes here. Identifiers follow C23 (UAX #31): XID_Start characters begin
+// one and XID_Continue characters go on, per the generated tables in
+// lexer_xid.c.
+
+// The well-formed sequences of Unicode table 3-7: no overlong forms, no
+// surrogates, nothing past U+10FFFF
+int decodeUtf8(const char* p, const char* end, uint32_t* cp)
+{
+    const unsigned char* s = (const unsigned char*)p;
+    size_t avail = (size_t)(end - p);
+    unsigned char c = s[0];
+    uint32_t min;
+    int n;
+    if (c < 0x80)
+    {
+        *cp = c;
+        return 1;
+    }
+    if (c >= 0xC2 && c <= 0xDF)
+    {
+        n = 2;
+        min = 0x80;
+        *cp = c & 0x1F;
+    }
+    else if (c >= 0xE0 && c <= 0xEF)
+    {
+        n = 3;
+        min = 0x800;
+        *cp = c & 0x0F;
+    }
+    else if (c >= 0xF0 && c <= 0xF4)
+    {
+        n = 4;
+        min = 0x10000;
+        *cp = c & 0x07;
+    }
+    else
+    {
+        return 0; // A continuation byte, or a lead byte of an overlong or too large form
+    }
+    if (avail < (size_t)n)
+    {
+        return 0;
+    }
+    for (int i = 1; i < n; i++)
+    {
+        if ((s[i] & 0xC0) != 0x80)
+        {
+            return 0;
+        }
+        *cp = (*cp << 6) | (s[i] & 0x3F);
+    }
+    if (*cp < min || *cp > 0x10FFFF || (*cp >= 0xD800 && *cp <= 0xDFFF))
+    {
+        return 0;
+    }
+    return n;
+}
+
+static int inRanges(const uint32_t (*ranges)[2], size_t count, uint32_t cp)
+{
+    size_t lo = 0, hi = count;
+    while (lo < hi)
+    {
+        size_t mid = lo + (hi - lo) / 2;
+        if (cp < ranges[mid][0])
+        {
+            hi = mid;
+        }
+        else if (cp > ranges[mid][1])
+        {
+            lo = mid + 1;
+        }
+        else
+        {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+int isXidStart(uint32_t cp)
+{
+    return inRanges(xidStartRanges, XID_START_RANGES, cp);
+}
+
+int isXidContinue(uint32_t cp)
+{
+    return inRanges(xidContinueRanges, XID_CONTINUE_RANGES, cp);
+}
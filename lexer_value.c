@@ -0,0 +1,355 @@
+#include <string.h>
+#include "lexer.h"
+
+// Values of literal tokens, decoded only when asked for. The lexer hands out
+// text; these turn an INTEGRAL_CONSTANT into its number and a string or
+// character literal into its bytes.
+//
+// Digits are converted eight at a time with SWAR (SIMD within a register):
+// eight characters are loaded as one 64-bit word, checked against the
+// base's digit range in a few word operations, and folded into one value.
+
+#define ONES 0x0101010101010101ULL
+#define HIGH 0x8080808080808080ULL
+
+static uint64_t load8(const char* p)
+{
+    uint64_t w;
+    memcpy(&w, p, 8);
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    w = __builtin_bswap64(w); // The first character in the low byte
+#endif
+    return w;
+}
+
+// High bit of each byte of w (all bytes below 0x80) that lies in [lo, hi].
+// A byte below 0x80 plus at most 0x80 stays below 0x100, so no carry
+// crosses into the next byte.
+static uint64_t bytesInRange(uint64_t w, unsigned lo, unsigned hi)
+{
+    uint64_t atLeastLo = (w + ONES * (0x80 - lo)) & HIGH;
+    uint64_t aboveHi = (w + ONES * (0x7F - hi)) & HIGH;
+    return atLeastLo & ~aboveHi;
+}
+
+// Replace the eight hexadecimal digits in *w (one per byte) by their
+// values; 0 if any byte is not one
+static int hexDigits8(uint64_t* w)
+{
+    uint64_t x = *w;
+    if (x & HIGH)
+    {
+        return 0;
+    }
+    uint64_t digit = bytesInRange(x, '0', '9');
+    uint64_t letter = bytesInRange(x | (ONES * 0x20), 'a', 'f');
+    if ((digit | letter) != HIGH)
+    {
+        return 0;
+    }
+    // '0'-'9' keep their low nibble; 'a'-'f' and 'A'-'F' have 1-6 there, plus 9
+    *w = (x & (ONES * 0x0F)) + (letter >> 7) * 9;
+    return 1;
+}
+
+// Fold eight digit values of 'bits' bits each, first digit in the low byte
+// and most significant, into one number of 8 * bits bits. Neighbouring
+// lanes are paired three times, each step doubling the lane width.
+static uint64_t packDigits8(uint64_t w, int bits)
+{
+    w = ((w << bits) | (w >> 8)) & 0x00FF00FF00FF00FFULL;
+    w = ((w << (2 * bits)) | (w >> 16)) & 0x0000FFFF0000FFFFULL;
+    return ((w << (4 * bits)) | (w >> 32)) & ((1ULL << (8 * bits)) - 1);
+}
+
+// Eight decimal digits (values, one per byte) as a number below 10^8:
+// pairs, then quads, then the two halves, by multiplications that add
+// neighbouring lanes
+static uint64_t decimalDigits8(uint64_t w)
+{
+    w = (w * 10) + (w >> 8);
+    w = (((w & 0x000000FF000000FFULL) * (100 + (1000000ULL << 32))) +
+         (((w >> 16) & 0x000000FF000000FFULL) * (1 + (10000ULL << 32)))) >> 32;
+    return w;
+}
+
+static int digitValue(char c)
+{
+    if (c >= '0' && c <= '9')
+    {
+        return c - '0';
+    }
+    c |= 0x20;
+    return (c >= 'a' && c <= 'f') ? c - 'a' + 10 : 99;
+}
+
+int decodeIntegerConstant(const char* lexeme, size_t length, IntegerValue* value)
+{
+    const char* p = lexeme;
+    const char* end = lexeme + length;
+    // The suffix (u, l, ll in any mix the lexer accepts) does not change the value
+    while (end > p && (end[-1] == 'u' || end[-1] == 'U' || end[-1] == 'l' || end[-1] == 'L'))
+    {
+        end--;
+    }
+    // The base from the prefix, as the lexer's number states tell them apart
+    int base = 10;
+    if (end - p >= 2 && p[0] == '0' && (p[1] == 'x' || p[1] == 'X'))
+    {
+        base = 16;
+        p += 2;
+    }
+    else if (end - p >= 2 && p[0] == '0' && (p[1] == 'b' || p[1] == 'B'))
+    {
+        base = 2;
+        p += 2;
+    }
+    else if (end - p >= 2 && p[0] == '0')
+    {
+        base = 8;
+        p++;
+    }
+    if (p == end)
+    {
+        return 0;
+    }
+    // Digit separators (C23, C++14) go between two digits; the 0 of an
+    // octal prefix is one
+    const char* digits = (base == 8) ? p - 1 : p;
+
+    int bits = (base == 16) ? 4 : (base == 8) ? 3 : (base == 2) ? 1 : 0;
+    uint64_t v = 0;
+    int overflow = 0;
+    for (; end - p >= 8; p += 8)
+    {
+        uint64_t w = load8(p);
+        if ((w & HIGH) == 0 && bytesInRange(w, '\'', '\'') != 0)
+        {
+            break; // Separators: the rest goes digit by digit
+        }
+        uint64_t chunk;
+        if (base == 16)
+        {
+            if (!hexDigits8(&w))
+            {
+                return 0;
+            }
+            chunk = packDigits8(w, 4);
+        }
+        else
+        {
+            unsigned top = (base == 10) ? '9' : (base == 8) ? '7' : '1';
+            if ((w & HIGH) || bytesInRange(w, '0', top) != HIGH)
+            {
+                return 0;
+            }
+            w -= ONES * '0';
+            chunk = (base == 10) ? decimalDigits8(w) : packDigits8(w, bits);
+        }
+        if (base == 10)
+        {
+            overflow |= __builtin_mul_overflow(v, 100000000ULL, &v);
+            overflow |= __builtin_add_overflow(v, chunk, &v);
+        }
+        else
+        {
+            // At most 32 bits a chunk, so the shift is always defined
+            overflow |= (v >> (64 - 8 * bits)) != 0;
+            v = (v << (8 * bits)) | chunk;
+        }
+    }
+    for (; p < end; p++)
+    {
+        if (*p == '\'' && p > digits && p + 1 < end && p[-1] != '\'' && p[1] != '\'')
+        {
+            continue;
+        }
+        int d = digitValue(*p);
+        if (d >= base)
+        {
+            return 0;
+        }
+        overflow |= __builtin_mul_overflow(v, (uint64_t)base, &v);
+        overflow |= __builtin_add_overflow(v, (uint64_t)d, &v);
+    }
+    value->value = v;
+    value->base = base;
+    value->overflow = overflow;
+    return 1;
+}
+
+// --- String and character literals ---
+
+static void putByte(char* buf, size_t capacity, size_t at, unsigned char c)
+{
+    if (at < capacity)
+    {
+        buf[at] = (char)c;
+    }
+}
+
+// Code point 'cp' as UTF-8; returns its length
+static size_t putUtf8(char* buf, size_t capacity, size_t at, uint32_t cp)
+{
+    if (cp < 0x80)
+    {
+        putByte(buf, capacity, at, (unsigned char)cp);
+        return 1;
+    }
+    if (cp < 0x800)
+    {
+        putByte(buf, capacity, at, (unsigned char)(0xC0 | (cp >> 6)));
+        putByte(buf, capacity, at + 1, (unsigned char)(0x80 | (cp & 0x3F)));
+        return 2;
+    }
+    if (cp < 0x10000)
+    {
+        putByte(buf, capacity, at, (unsigned char)(0xE0 | (cp >> 12)));
+        putByte(buf, capacity, at + 1, (unsigned char)(0x80 | ((cp >> 6) & 0x3F)));
+        putByte(buf, capacity, at + 2, (unsigned char)(0x80 | (cp & 0x3F)));
+        return 3;
+    }
+    putByte(buf, capacity, at, (unsigned char)(0xF0 | ((cp >> 18) & 0x07)));
+    putByte(buf, capacity, at + 1, (unsigned char)(0x80 | ((cp >> 12) & 0x3F)));
+    putByte(buf, capacity, at + 2, (unsigned char)(0x80 | ((cp >> 6) & 0x3F)));
+    putByte(buf, capacity, at + 3, (unsigned char)(0x80 | (cp & 0x3F)));
+    return 4;
+}
+
+// The body of a raw string literal, from the '"' after R: R"x(body)x"
+static size_t decodeRawString(const char* p, const char* end, char* buf, size_t capacity)
+{
+    const char* open = memchr(p, '(', (size_t)(end - p));
+    if (open == NULL)
+    {
+        return 0;
+    }
+    size_t delimLen = (size_t)(open - (p + 1));
+    const char* body = open + 1;
+    if ((size_t)(end - body) < delimLen + 2 || end[-1] != '"' || *(end - 2 - delimLen) != ')' ||
+        memcmp(end - 1 - delimLen, p + 1, delimLen) != 0)
+    {
+        return 0;
+    }
+    size_t n = (size_t)(end - body) - delimLen - 2;
+    if (capacity > 0)
+    {
+        memcpy(buf, body, (n < capacity) ? n : capacity);
+    }
+    return n;
+}
+
+size_t decodeLiteral(const char* lexeme, size_t length, char* buf, size_t capacity)
+{
+    const char* p = lexeme;
+    const char* end = lexeme + length;
+    // The encoding prefix (L, u, U, u8) does not change the bytes written
+    if (end - p >= 2 && p[0] == 'u' && p[1] == '8')
+    {
+        p += 2;
+    }
+    else if (end > p && (p[0] == 'L' || p[0] == 'u' || p[0] == 'U'))
+    {
+        p++;
+    }
+    if (end - p >= 2 && p[0] == 'R' && p[1] == '"')
+    {
+        return decodeRawString(p + 1, end, buf, capacity);
+    }
+    if (p == end || (p[0] != '"' && p[0] != '\''))
+    {
+        return 0;
+    }
+    char quote = *p++;
+    if (end > p && end[-1] == quote)
+    {
+        end--;
+    }
+
+    size_t n = 0;
+    while (p < end)
+    {
+        // Copy the run up to the next escape in one go
+        const char* slash = memchr(p, '\\', (size_t)(end - p));
+        const char* runEnd = (slash != NULL) ? slash : end;
+        if (n < capacity)
+        {
+            size_t room = capacity - n;
+            size_t run = (size_t)(runEnd - p);
+            memcpy(buf + n, p, (run < room) ? run : room);
+        }
+        n += (size_t)(runEnd - p);
+        p = runEnd;
+        if (p == end)
+        {
+            break;
+        }
+
+        p++; // The backslash
+        if (p == end)
+        {
+            putByte(buf, capacity, n++, '\\'); // A lone one at the end is kept
+            break;
+        }
+        char c = *p++;
+        switch (c)
+        {
+            case 'n': putByte(buf, capacity, n++, '\n'); break;
+            case 't': putByte(buf, capacity, n++, '\t'); break;
+            case 'r': putByte(buf, capacity, n++, '\r'); break;
+            case 'b': putByte(buf, capacity, n++, '\b'); break;
+            case 'f': putByte(buf, capacity, n++, '\f'); break;
+            case 'a': putByte(buf, capacity, n++, '\a'); break;
+            case 'v': putByte(buf, capacity, n++, '\v'); break;
+            case '0': case '1': case '2': case '3':
+            case '4': case '5': case '6': case '7':
+            {
+                // Up to three octal digits
+                unsigned v = (unsigned)(c - '0');
+                for (int k = 1; k < 3 && p < end && *p >= '0' && *p <= '7'; k++)
+                {
+                    v = v * 8 + (unsigned)(*p++ - '0');
+                }
+                putByte(buf, capacity, n++, (unsigned char)v);
+                break;
+            }
+            case 'x':
+            {
+                // Any number of hex digits; the byte keeps the low eight bits
+                unsigned v = 0;
+                while (p < end && digitValue(*p) < 16)
+                {
+                    v = v * 16 + (unsigned)digitValue(*p++);
+                }
+                putByte(buf, capacity, n++, (unsigned char)v);
+                break;
+            }
+            case 'u':
+            case 'U':
+            {
+                int digits = (c == 'u') ? 4 : 8;
+                uint32_t cp = 0;
+                int k = 0;
+                for (; k < digits && p < end && digitValue(*p) < 16; k++)
+                {
+                    cp = cp * 16 + (uint32_t)digitValue(*p++);
+                }
+                if (k < digits || cp > 0x10FFFF)
+                {
+                    // Not a universal character name: kept as written
+                    putByte(buf, capacity, n++, '\\');
+                    putByte(buf, capacity, n++, (unsigned char)c);
+                    p -= k;
+                    break;
+                }
+                n += putUtf8(buf, capacity, n, cp);
+                break;
+            }
+            default:
+                // \\, \', \", \? and unknown escapes stand for the character itself
+                putByte(buf, capacity, n++, (unsigned char)c);
+                break;
+        }
+    }
+    return n;
+}
@@ -0,0 +1,15 @@
+// Generated by tools/gen_xid.c from DerivedCoreProperties.txt -- do not edit.
+#ifndef LEXER_XID_H
+#define LEXER_XID_H
+
+#include <stdint.h>
+
+// Unicode 14.0.0 identifier characters past ASCII, as sorted inclusive
+// ranges of code points
+#define XID_START_RANGES 653
+#define XID_CONTINUE_RANGES 759
+
+extern const uint32_t xidStartRanges[XID_START_RANGES][2];
+extern const uint32_t xidContinueRanges[XID_CONTINUE_RANGES][2];
+
+#endif
@@ -7,35 +7,711 @@ Description: A Lexical Analyzer (Lexer or Scanner) is the first phase of a compi
                 It acts as a bridge between the raw source code and the parser by breaking the program into keywords, identifiers, 
                 operators, literals, and punctuation symbols.
 */
+#include <pthread.h>
 #include <stdio.h>
-#include<string.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include "arena.h"
 #include "lexer.h" // Include your lexer header
+#include "output.h"
+#include "headers.h"
+#include "pool.h"
+#include "project.h"
+#include "tokcache.h"
 
-int main(int argc, char* argv[]) 
+#define TOKEN_BATCH_SIZE 4096
+// Project mode: a file bigger than this and than its share of the threads'
+// work is also split across them (see lexFiles)
+#define PROJECT_SPLIT_MIN ((uint64_t)16 << 20)
+
+// --symbols: the names of every file, and the identifiers seen. A file lexed
+// on the pool interns into a table of its own, merged into this one when its
+// output is written (see writeFinishedJobs): ids go in input order, whatever
+// order the threads finish in, and no lock is taken per identifier.
+static Interner* symbolTable = NULL;
+static size_t identifierTokens = 0;
+
+// --split: lex each file on this many threads (-1: off, 0: one per CPU)
+static int splitThreads = -1;
+
+// --stats: the counters of every lexer, summed (lexers built with -DLEXER_STATS)
+static int wantStats = 0;
+static int statsMissing = 0;
+static LexerStats totalStats;
+static pthread_mutex_t statsLock = PTHREAD_MUTEX_INITIALIZER;
+
+// Project mode: tokens of every file, and per type for --count
+static size_t totalTokens = 0;
+static size_t typeTotals[UNKNOWN + 1];
+
+// --max-diagnostics: diagnostics kept per file (the lexer's default otherwise)
+static long maxDiagnostics = -1;
+
+// --directives: keep '#' lines as DIRECTIVE tokens. --includes (or -I): also
+// follow #include directives through one header cache for every file.
+static int keepDirectives = 0;
+static HeaderCache* headerCache = NULL;
+
+// --format / --count / --emit and --banners: how every file's tokens are written
+static OutputFormat outputFormat = OUTPUT_TABLE;
+static int outputFlags = 0;
+
+// --input-window: map files larger than this many bytes a window at a time (0: whole)
+static size_t inputWindow = 0;
+
+// --std: the dialect of every file (-1: from each file's extension)
+static int dialect = -1;
+
+// Per-file storage: the token batch arrays and the lexer's diagnostics and
+// newline index come from an arena, reset after the file and handed on to
+// the next one, so a worker lexing many files allocates only for its first
+// few. There are as many as files lexed at the same time.
+static Arena** spareArenas = NULL;
+static size_t spareCount = 0, spareCapacity = 0;
+static pthread_mutex_t arenaLock = PTHREAD_MUTEX_INITIALIZER;
+
+static Arena* takeArena(void)
+{
+    Arena* arena = NULL;
+    pthread_mutex_lock(&arenaLock);
+    if (spareCount > 0)
+    {
+        arena = spareArenas[--spareCount];
+    }
+    pthread_mutex_unlock(&arenaLock);
+    return (arena != NULL) ? arena : createArena(0);
+}
+
+static void giveBackArena(Arena* arena)
+{
+    resetArena(arena);
+    pthread_mutex_lock(&arenaLock);
+    if (spareCount == spareCapacity)
+    {
+        size_t n = (spareCapacity > 0) ? spareCapacity * 2 : 16;
+        Arena** grown = realloc(spareArenas, n * sizeof(Arena*));
+        if (grown == NULL)
+        {
+            pthread_mutex_unlock(&arenaLock);
+            destroyArena(arena);
+            return;
+        }
+        spareArenas = grown;
+        spareCapacity = n;
+    }
+    spareArenas[spareCount++] = arena;
+    pthread_mutex_unlock(&arenaLock);
+}
+
+static void destroyArenas(void)
+{
+    while (spareCount > 0)
+    {
+        destroyArena(spareArenas[--spareCount]);
+    }
+    free(spareArenas);
+    spareArenas = NULL;
+    spareCapacity = 0;
+}
+
+// Lex one file ("-" for stdin), on 'split' threads if it is not -1 (see
+// splitThreads), and write its tokens to 'out', with identifiers interned
+// into 'symbols' (NULL without --symbols).
+// Tokens are consumed in batches straight from the lexer's arrays; lexemes
+// are views into the input, not strings. Returns 0 if the file could not be opened.
+static int lexFile(const char* filename, int split, Interner* symbols, Output* out, FILE* err)
+{
+    // "-" reads standard input, streamed in chunks
+    LexerState* lx = (strcmp(filename, "-") == 0) ? createLexerFd(STDIN_FILENO) : createLexer(filename);
+    if (lx == NULL)
+    {
+        fprintf(err, "Error: Could not open file '%s'\n", filename);
+        return 0;
+    }
+    Arena* arena = takeArena();
+    if (arena == NULL)
+    {
+        fprintf(err, "Error: Out of memory\n");
+        destroyLexer(lx);
+        return 0;
+    }
+    TokenType* types = arenaAlloc(arena, TOKEN_BATCH_SIZE * sizeof(TokenType));
+    size_t* starts = arenaAlloc(arena, TOKEN_BATCH_SIZE * sizeof(size_t));
+    size_t* lengths = arenaAlloc(arena, TOKEN_BATCH_SIZE * sizeof(size_t));
+    int* lines = arenaAlloc(arena, TOKEN_BATCH_SIZE * sizeof(int));
+    KeywordId* keywords = arenaAlloc(arena, TOKEN_BATCH_SIZE * sizeof(KeywordId));
+    uint32_t* ids = arenaAlloc(arena, TOKEN_BATCH_SIZE * sizeof(uint32_t));
+    if (types == NULL || starts == NULL || lengths == NULL || lines == NULL || keywords == NULL || ids == NULL)
+    {
+        fprintf(err, "Error: Out of memory\n");
+        destroyLexer(lx);
+        giveBackArena(arena);
+        return 0;
+    }
+    setLexerArena(lx, arena);
+    setLexerDialect(lx, (dialect >= 0) ? (LexerDialect)dialect : lexerDialectForFile(filename));
+    setLexerErrorStream(lx, err);
+    setLexerInterner(lx, symbols);
+    if (maxDiagnostics >= 0)
+    {
+        setLexerDiagnosticLimit(lx, (size_t)maxDiagnostics);
+    }
+    if (inputWindow > 0)
+    {
+        setLexerInputWindow(lx, inputWindow); // Before splitting: a windowed file stays sequential
+    }
+    if (split >= 0)
+    {
+        splitLexer(lx, split, 0); // Stays sequential for pipes
+    }
+    setLexerDirectives(lx, keepDirectives);
+    // Include mode: the tokens of the headers come after their #include
+    TranslationUnit* unit = NULL;
+    if (headerCache != NULL && (unit = openTranslationUnit(headerCache, lx, filename, err)) == NULL)
+    {
+        fprintf(err, "Error: Out of memory\n");
+        destroyLexer(lx);
+        giveBackArena(arena);
+        return 0;
+    }
+
+    TokenBatch batch = { .type = types, .start = starts, .length = lengths, .capacity = TOKEN_BATCH_SIZE };
+    // Only ask the lexer for the columns the format writes
+    if (out->format == OUTPUT_JSONL || out->format == OUTPUT_CSV || out->format == OUTPUT_BINARY)
+    {
+        batch.line = lines;
+    }
+    if (out->format == OUTPUT_BINARY)
+    {
+        batch.keyword = keywords;
+        batch.symbol = ids;
+    }
+
+    size_t count;
+    size_t tokens = 0;
+    size_t identifiers = 0;
+    const char* file = filename;
+    LexerState* source = lx;
+    beginOutputFile(out, filename);
+    while ((count = (unit != NULL) ? nextUnitTokens(unit, &batch, &file, &source) : nextTokens(lx, &batch)) > 0)
+    {
+        if (file != out->file)
+        {
+            switchOutputFile(out, file);
+        }
+        if (symbols != NULL && source != lx)
+        {
+            // Header lexers serve every file and intern nothing: the names
+            // of a header's tokens go into this file's table here
+            for (size_t i = 0; i < count; i++)
+            {
+                if (types[i] == IDENTIFIER)
+                {
+                    ids[i] = internString(symbols, lexerTextAt(source, starts[i]), lengths[i]);
+                }
+            }
+        }
+        writeOutputTokens(out, source, &batch, count);
+        tokens += count;
+        if (symbols != NULL)
+        {
+            for (size_t i = 0; i < count; i++)
+            {
+                identifiers += (types[i] == IDENTIFIER);
+            }
+        }
+    }
+    if (out->format == OUTPUT_COUNT)
+    {
+        for (int type = 0; type <= UNKNOWN; type++)
+        {
+            __atomic_fetch_add(&typeTotals[type], out->counts[type], __ATOMIC_RELAXED);
+        }
+    }
+    if (out->file != filename)
+    {
+        switchOutputFile(out, filename);
+    }
+    endOutputFile(out);
+    closeTranslationUnit(unit);
+    __atomic_fetch_add(&totalTokens, tokens, __ATOMIC_RELAXED);
+    __atomic_fetch_add(&identifierTokens, identifiers, __ATOMIC_RELAXED);
+
+    LexerStats stats;
+    if (wantStats && getLexerStats(lx, &stats))
+    {
+        pthread_mutex_lock(&statsLock);
+        addLexerStats(&totalStats, &stats);
+        pthread_mutex_unlock(&statsLock);
+    }
+    else if (wantStats)
+    {
+        statsMissing = 1;
+    }
+
+    destroyLexer(lx); // Prints the diagnostics, with any unmatched delimiters
+    giveBackArena(arena);
+    return 1;
+}
+
+// --- Multi-file mode: lex every file on the thread pool, print in input order ---
+typedef struct {
+    const char* filename;
+    int split;     // Threads to split it across, -1 for none
+    char* out;     // Formatted tokens, captured in memory
+    size_t outLen;
+    char* err;     // Diagnostics, captured in memory
+    size_t errLen;
+    Interner* symbols; // The file's names (--symbols), its output's ids
+    int failed;
+    int done;
+} FileJob;
+
+typedef struct {
+    FileJob* jobs;
+    size_t count;
+    size_t next;   // First job not written out yet
+    pthread_mutex_t lock;
+    Output* out;
+    int status;
+} FileRun;
+
+// The ids in symbolTable of a job's names, indexed by the job's ids. They
+// are added in the order the job met them, so with the jobs merged in input
+// order the ids are those of a sequential run. NULL when out of memory.
+static uint32_t* mergeSymbols(Interner* symbols)
+{
+    uint32_t count = internerCount(symbols);
+    uint32_t* map = malloc(((size_t)count + 1) * sizeof(uint32_t));
+    if (map == NULL)
+    {
+        return NULL;
+    }
+    map[NO_SYMBOL] = NO_SYMBOL;
+    for (uint32_t id = 1; id <= count; id++)
+    {
+        size_t len;
+        const char* name = internedString(symbols, id, &len);
+        if ((map[id] = internString(symbolTable, name, len)) == NO_SYMBOL)
+        {
+            free(map);
+            return NULL;
+        }
+    }
+    return map;
+}
+
+// Write out, in input order, the finished jobs that no unfinished one
+// precedes, so captured output is freed as early as the order allows
+static void writeFinishedJobs(FileRun* run)
 {
-    if (argc != 2) {
-        fprintf(stderr, "Usage: %s <filename.c>\n", argv[0]);
+    for (; run->next < run->count && run->jobs[run->next].done; run->next++)
+    {
+        FileJob* job = &run->jobs[run->next];
+        uint32_t* symbolMap = NULL;
+        if (job->symbols != NULL && (symbolMap = mergeSymbols(job->symbols)) == NULL)
+        {
+            fprintf(stderr, "Error: Out of memory\n");
+            job->failed = 1;
+            job->outLen = 0;
+        }
+        fflush(stderr);
+        writeOutputBytes(run->out, job->out, job->outLen, symbolMap);
+        flushOutput(run->out);
+        fwrite(job->err, 1, job->errLen, stderr);
+        if (job->failed)
+        {
+            run->status = 1;
+        }
+        free(job->out);
+        free(job->err);
+        free(symbolMap);
+        destroyInterner(job->symbols);
+        job->out = job->err = NULL;
+        job->symbols = NULL;
+    }
+}
+
+static void lexFileJob(size_t index, void* arg)
+{
+    FileRun* run = arg;
+    FileJob* job = &run->jobs[index];
+    FILE* out = open_memstream(&job->out, &job->outLen);
+    FILE* err = open_memstream(&job->err, &job->errLen);
+    job->symbols = (symbolTable != NULL) ? createInterner(0) : NULL;
+    Output output;
+    if (out == NULL || err == NULL || (symbolTable != NULL && job->symbols == NULL) ||
+        !openOutput(&output, out, outputFormat, outputFlags))
+    {
+        if (out != NULL) fclose(out);
+        if (err != NULL) fclose(err);
+        job->failed = 1;
+    }
+    else
+    {
+        job->failed = !lexFile(job->filename, job->split, job->symbols, &output, err);
+        job->failed |= !closeOutput(&output);
+        fclose(out);
+        fclose(err);
+    }
+
+    pthread_mutex_lock(&run->lock);
+    job->done = 1;
+    writeFinishedJobs(run);
+    pthread_mutex_unlock(&run->lock);
+}
+
+// Lex files[0..count) on the work-stealing pool, largest first so that no
+// big file is left to start last, and write their output in list order. A
+// file bigger than its share of the work is split across threads as well.
+// 'sizes' may be NULL: the files are then looked up here.
+static int lexFiles(const char** files, const uint64_t* sizes, size_t count, int threads, Output* out)
+{
+    uint64_t* found = NULL;
+    if (sizes == NULL)
+    {
+        found = calloc(count > 0 ? count : 1, sizeof(uint64_t));
+        if (found == NULL)
+        {
+            fprintf(stderr, "Error: Out of memory\n");
+            return 1;
+        }
+        for (size_t i = 0; i < count; i++)
+        {
+            struct stat st;
+            if (strcmp(files[i], "-") != 0 && stat(files[i], &st) == 0)
+            {
+                found[i] = (uint64_t)st.st_size;
+            }
+        }
+        sizes = found;
+    }
+    SourceList list = { .sizes = (uint64_t*)sizes, .count = count };
+    size_t* order = largestSourcesFirst(&list);
+    FileRun run = { 0 };
+    run.jobs = calloc(count > 0 ? count : 1, sizeof(FileJob));
+    if (run.jobs == NULL || order == NULL)
+    {
+        free(run.jobs);
+        free(order);
+        free(found);
+        fprintf(stderr, "Error: Out of memory\n");
         return 1;
     }
 
-    initializeLexer(argv[1]);
+    if (threads <= 0)
+    {
+        threads = poolDefaultThreads();
+    }
+    uint64_t totalBytes = 0;
+    for (size_t i = 0; i < count; i++)
+    {
+        totalBytes += sizes[i];
+    }
+    uint64_t share = totalBytes / (uint64_t)threads + 1;
+    for (size_t i = 0; i < count; i++)
+    {
+        run.jobs[i].filename = files[i];
+        run.jobs[i].split = -1;
+        if (threads > 1 && sizes[i] > PROJECT_SPLIT_MIN && sizes[i] > share)
+        {
+            // A few shares' worth of threads: it started first, so the
+            // others are still busy with the rest
+            uint64_t shares = (sizes[i] + share - 1) / share;
+            run.jobs[i].split = (shares < (uint64_t)threads) ? (int)shares : threads;
+        }
+    }
+    run.count = count;
+    run.out = out;
+    pthread_mutex_init(&run.lock, NULL);
 
-    printf("Parsing : %s : Started\n", argv[1]);
+    parallelForStealing(order, count, threads, lexFileJob, &run);
 
-    Token currentToken;
-    do 
+    pthread_mutex_destroy(&run.lock);
+    free(order);
+    free(found);
+    free(run.jobs);
+    return run.status;
+}
+
+static void usage(const char* prog)
+{
+    fprintf(stderr, "Usage: %s [options] <filename.c>\n", prog);
+    fprintf(stderr, "       %s [options] [-j threads] <file1.c> <file2.c> ...\n", prog);
+    fprintf(stderr, "       %s [options] [-j threads] --split <file.c> ...  (split each file across the threads)\n", prog);
+    fprintf(stderr, "       %s [options] [-j threads] <dir|'glob'> ...       (every .c and .h file under a directory)\n", prog);
+    fprintf(stderr, "Options:\n");
+    fprintf(stderr, "  --format=table|jsonl|csv|count|bin  How tokens are written (default: table)\n");
+    fprintf(stderr, "  --count                             Same as --format=count: per-type totals only\n");
+    fprintf(stderr, "  --emit=text|bin                     Table or the binary format of tokfile.h\n");
+    fprintf(stderr, "  --banners, --no-banners             Open/Parsing lines around each file (default: table only)\n");
+    fprintf(stderr, "  --symbols                           Intern identifiers; with bin, include the string table\n");
+    fprintf(stderr, "  --directives                        Keep preprocessor lines as Directive tokens\n");
+    fprintf(stderr, "  --includes                          Also follow #include, each header's tokens after it\n");
+    fprintf(stderr, "  -I DIR                              Search DIR for included headers (implies --includes)\n");
+    fprintf(stderr, "  --stats                             Report the lexer's counters (needs a -DLEXER_STATS build)\n");
+    fprintf(stderr, "  --cache=DIR                         Reuse the tokens of unchanged files from a token cache in DIR\n");
+    fprintf(stderr, "  --cache-size=MB                     Size limit of the cache directory (default: %llu)\n", (unsigned long long)(TOKCACHE_DEFAULT_LIMIT >> 20));
+    fprintf(stderr, "  --max-diagnostics=N                 Diagnostics printed per file, 0 for all (default: %d)\n", LEXER_DIAG_LIMIT);
+    fprintf(stderr, "  --input-window=MB                   Map bigger files this much at a time, to bound memory (default: whole)\n");
+    fprintf(stderr, "  --std=c89|c11|c23|c++               Language of every file (default: c++ for .cpp, .hpp, ..., else c23)\n");
+}
+
+int main(int argc, char* argv[])
+{
+    int threads = 0; // 0 = one per CPU
+    int multi = 0;   // -j given: use the multi-file mode even for one file
+    int symbols = 0;
+    int split = 0;
+    int banners = -1; // -1: the format's default
+    const char* cacheDir = NULL;
+    unsigned long long cacheMegabytes = 0; // 0: the default limit
+    int includes = 0;
+    const char** includeDirs = calloc((size_t)argc, sizeof(char*)); // -I, in order
+    size_t includeDirCount = 0;
+    int first = 1;
+    for (; first < argc && argv[first][0] == '-' && argv[first][1] != '\0'; first++)
+    {
+        const char* arg = argv[first];
+        int format = -1;
+        if (strcmp(arg, "-j") == 0 && first + 1 < argc)
+        {
+            threads = atoi(argv[++first]);
+            multi = 1;
+        }
+        else if (strcmp(arg, "--symbols") == 0)
+        {
+            symbols = 1;
+        }
+        else if (strcmp(arg, "--stats") == 0)
+        {
+            wantStats = 1;
+        }
+        else if (strcmp(arg, "--directives") == 0)
+        {
+            keepDirectives = 1;
+        }
+        else if (strcmp(arg, "--includes") == 0)
+        {
+            includes = 1;
+        }
+        else if (strncmp(arg, "-I", 2) == 0 && (arg[2] != '\0' || first + 1 < argc) && includeDirs != NULL)
+        {
+            includeDirs[includeDirCount++] = (arg[2] != '\0') ? arg + 2 : argv[++first];
+            includes = 1;
+        }
+        else if (strcmp(arg, "--split") == 0)
+        {
+            split = 1;
+        }
+        else if (strncmp(arg, "--cache=", 8) == 0 && arg[8] != '\0')
+        {
+            cacheDir = arg + 8;
+        }
+        else if (strncmp(arg, "--cache-size=", 13) == 0 && arg[13] >= '0' && arg[13] <= '9')
+        {
+            cacheMegabytes = strtoull(arg + 13, NULL, 10);
+        }
+        else if (strncmp(arg, "--max-diagnostics=", 18) == 0 && arg[18] >= '0' && arg[18] <= '9')
+        {
+            maxDiagnostics = atol(arg + 18);
+        }
+        else if (strncmp(arg, "--input-window=", 15) == 0 && arg[15] >= '0' && arg[15] <= '9')
+        {
+            inputWindow = (size_t)strtoull(arg + 15, NULL, 10) << 20;
+        }
+        else if (strncmp(arg, "--std=", 6) == 0 && parseLexerDialect(arg + 6) >= 0)
+        {
+            dialect = parseLexerDialect(arg + 6);
+        }
+        else if (strcmp(arg, "--banners") == 0 || strcmp(arg, "--no-banners") == 0)
+        {
+            banners = (strcmp(arg, "--banners") == 0);
+        }
+        else if (strcmp(arg, "--count") == 0)
+        {
+            outputFormat = OUTPUT_COUNT;
+        }
+        else if (strcmp(arg, "--emit=text") == 0 || strcmp(arg, "--emit=bin") == 0)
+        {
+            outputFormat = (strcmp(arg, "--emit=bin") == 0) ? OUTPUT_BINARY : OUTPUT_TABLE;
+        }
+        else if (strncmp(arg, "--format=", 9) == 0 && (format = parseOutputFormat(arg + 9)) >= 0)
+        {
+            outputFormat = (OutputFormat)format;
+        }
+        else
+        {
+            usage(argv[0]);
+            return 1;
+        }
+    }
+    if (first >= argc)
+    {
+        usage(argv[0]);
+        return 1;
+    }
+    // A directory or glob pattern makes it a project: every argument then
+    // becomes the list of files it stands for
+    int project = 0;
+    for (int i = first; i < argc; i++)
+    {
+        project = project || isProjectArgument(argv[i]);
+    }
+    SourceList sources = { 0 };
+    for (int i = first; project && i < argc; i++)
     {
-        currentToken = getNextToken();
-        if (strlen(currentToken.lexeme) > 0) // Only print if a lexeme was found
-        { 
-            // Print with fixed-width columns for alignment
-            printf("%-20s: %s\n", getTokenTypeString(currentToken.type), currentToken.lexeme);
+        if (!addSources(&sources, argv[i], stderr))
+        {
+            freeSourceList(&sources);
+            return 1;
         }
-    } while (currentToken.type != UNKNOWN || strlen(currentToken.lexeme) > 0); // Continue until true EOF
+    }
+    multi = multi || project || argc - first > 1;
+    if (split)
+    {
+        // The threads go to the chunks of each file, so files are lexed one by one
+        splitThreads = threads;
+        multi = 0;
+    }
+    if (banners < 0)
+    {
+        banners = (outputFormat == OUTPUT_TABLE); // Keep machine-readable output clean
+    }
+    outputFlags = (banners ? OUTPUT_BANNERS : 0) | (symbols ? OUTPUT_SYMBOLS : 0);
 
-    printf("Parsing : %s : Done\n", argv[1]);
+    if (cacheDir != NULL && !setTokenCache(cacheDir, (uint64_t)cacheMegabytes << 20))
+    {
+        fprintf(stderr, "Error: Cannot use '%s' as a token cache\n", cacheDir);
+        return 1;
+    }
+
+    if (symbols)
+    {
+        symbolTable = createInterner(0); // Only ever used by one thread at a time
+        if (symbolTable == NULL)
+        {
+            fprintf(stderr, "Error: Out of memory\n");
+            return 1;
+        }
+    }
 
-    closeLexer(); // Call closeLexer to report any pending errors
+    if (includes)
+    {
+        keepDirectives = 1;
+        headerCache = createHeaderCache(NULL, maxDiagnostics, dialect); // Names are interned per file
+        for (size_t i = 0; headerCache != NULL && i < includeDirCount; i++)
+        {
+            if (!addIncludePath(headerCache, includeDirs[i]))
+            {
+                destroyHeaderCache(headerCache);
+                headerCache = NULL;
+            }
+        }
+        if (headerCache == NULL)
+        {
+            fprintf(stderr, "Error: Out of memory\n");
+            return 1;
+        }
+    }
+    free(includeDirs);
+    outputFlags |= keepDirectives ? OUTPUT_DIRECTIVES : 0;
 
-    return 0;
+    Output out;
+    if (!openOutput(&out, stdout, outputFormat, outputFlags))
+    {
+        fprintf(stderr, "Error: Out of memory\n");
+        return 1;
+    }
+    startOutputStream(&out);
+
+    int status = 0;
+    if (multi && project)
+    {
+        status = lexFiles(sources.paths, sources.sizes, sources.count, threads, &out);
+    }
+    else if (multi)
+    {
+        status = lexFiles((const char**)argv + first, NULL, (size_t)(argc - first), threads, &out);
+    }
+    else if (split && project)
+    {
+        for (size_t i = 0; i < sources.count; i++)
+        {
+            if (!lexFile(sources.paths[i], splitThreads, symbolTable, &out, stderr))
+            {
+                status = 1;
+            }
+        }
+    }
+    else if (split)
+    {
+        for (int i = first; i < argc; i++)
+        {
+            if (!lexFile(argv[i], splitThreads, symbolTable, &out, stderr))
+            {
+                status = 1;
+            }
+        }
+    }
+    else if (!lexFile(argv[first], -1, symbolTable, &out, stderr))
+    {
+        closeOutput(&out);
+        exit(EXIT_FAILURE);
+    }
+
+    if (project)
+    {
+        writeOutputTotals(&out, typeTotals, sources.count);
+    }
+    if (!finishOutputStream(&out, symbolTable) || !closeOutput(&out))
+    {
+        fprintf(stderr, "Error: Could not write the output\n");
+        status = 1;
+    }
+    if (project)
+    {
+        fprintf((out.flags & OUTPUT_BANNERS) ? stdout : stderr, "Project : %zu files, %llu bytes, %zu tokens\n",
+                sources.count, (unsigned long long)sources.totalBytes, totalTokens);
+        freeSourceList(&sources);
+    }
+    if (symbolTable != NULL)
+    {
+        // The summary is a banner: on stderr when stdout is machine-readable
+        if (out.format != OUTPUT_BINARY)
+        {
+            fprintf((out.flags & OUTPUT_BANNERS) ? stdout : stderr, "Symbols : %zu identifiers, %u unique names\n",
+                    identifierTokens, internerCount(symbolTable));
+        }
+        destroyInterner(symbolTable);
+    }
+    if (cacheDir != NULL)
+    {
+        TokenCacheStats cache;
+        getTokenCacheStats(&cache);
+        fprintf((out.flags & OUTPUT_BANNERS) ? stdout : stderr, "Cache   : %llu hits, %llu misses, %llu stored, %llu evicted, %llu failed\n",
+                (unsigned long long)cache.hits, (unsigned long long)cache.misses, (unsigned long long)cache.stores,
+                (unsigned long long)cache.evictions, (unsigned long long)cache.failures);
+    }
+    if (headerCache != NULL)
+    {
+        HeaderCacheStats headers;
+        getHeaderCacheStats(headerCache, &headers);
+        fprintf((out.flags & OUTPUT_BANNERS) ? stdout : stderr, "Headers : %llu lexed, %llu inclusions, %llu skipped as repeats, %llu not found\n",
+                (unsigned long long)headers.headers, (unsigned long long)headers.inclusions,
+                (unsigned long long)headers.skipped, (unsigned long long)headers.missing);
+        destroyHeaderCache(headerCache);
+    }
+    if (wantStats && statsMissing)
+    {
+        fprintf(stderr, "Stats   : not available, the lexer was built without -DLEXER_STATS\n");
+    }
+    else if (wantStats)
+    {
+        printLexerStats(&totalStats, (out.flags & OUTPUT_BANNERS) ? stdout : stderr);
+    }
+    destroyArenas();
+    return status;
 }
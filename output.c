@@ -0,0 +1,410 @@
+#include <stdlib.h>
+#include <string.h>
+#include "output.h"
+
+#define OUTPUT_BUFFER_SIZE (1024 * 1024)
+#define LABEL_WIDTH 20 // Table labels are padded like "%-20s: "
+
+// --- Buffer ---
+void flushOutput(Output* o)
+{
+    if (o->len > 0 && fwrite(o->buf, 1, o->len, o->stream) != o->len)
+    {
+        o->failed = 1;
+    }
+    o->len = 0;
+    if (fflush(o->stream) != 0)
+    {
+        o->failed = 1;
+    }
+}
+
+// Room for n more bytes in the buffer (n must be small)
+static char* reserve(Output* o, size_t n)
+{
+    if (OUTPUT_BUFFER_SIZE - o->len < n)
+    {
+        flushOutput(o);
+    }
+    return o->buf + o->len;
+}
+
+static void put(Output* o, const char* bytes, size_t n)
+{
+    if (n > OUTPUT_BUFFER_SIZE / 2)
+    {
+        // Huge lexemes go straight out rather than through the buffer
+        flushOutput(o);
+        if (fwrite(bytes, 1, n, o->stream) != n)
+        {
+            o->failed = 1;
+        }
+        return;
+    }
+    memcpy(reserve(o, n), bytes, n);
+    o->len += n;
+}
+
+static void putString(Output* o, const char* str)
+{
+    put(o, str, strlen(str));
+}
+
+static void putNumber(Output* o, size_t v)
+{
+    char digits[24];
+    char* d = digits + sizeof(digits);
+    do
+    {
+        *--d = (char)('0' + v % 10);
+        v /= 10;
+    } while (v != 0);
+    put(o, d, (size_t)(digits + sizeof(digits) - d));
+}
+
+// Type name (n bytes) padded to the table column, then ": "
+static void putLabel(Output* o, const char* name, size_t n)
+{
+    size_t width = (n > LABEL_WIDTH) ? n : LABEL_WIDTH;
+    char* p = reserve(o, width + 2);
+    memcpy(p, name, n);
+    memset(p + n, ' ', width - n);
+    p[width] = ':';
+    p[width + 1] = ' ';
+    o->len += width + 2;
+}
+
+// --- Escaping ---
+// JSON string body: quotes, backslashes and control characters escaped;
+// well-formed UTF-8 is copied as it is, and each byte of an ill-formed
+// sequence becomes U+FFFD, so the output is always valid JSON
+static void putJsonString(Output* o, const char* s, size_t n)
+{
+    static const char hex[] = "0123456789abcdef";
+    put(o, "\"", 1);
+    size_t run = 0; // Start of the bytes not yet written
+    for (size_t i = 0; i < n; i++)
+    {
+        unsigned char c = (unsigned char)s[i];
+        uint32_t cp;
+        int len = 0;
+        if (c >= 0x80 && (len = decodeUtf8(s + i, s + n, &cp)) > 0)
+        {
+            i += (size_t)len - 1;
+            continue;
+        }
+        if (c >= 0x20 && c < 0x80 && c != '"' && c != '\\')
+        {
+            continue;
+        }
+        put(o, s + run, i - run);
+        run = i + 1;
+        char* p = reserve(o, 6);
+        if (c >= 0x80)
+        {
+            memcpy(p, "\\ufffd", 6);
+            o->len += 6;
+        }
+        else if (c == '"' || c == '\\')
+        {
+            p[0] = '\\';
+            p[1] = (char)c;
+            o->len += 2;
+        }
+        else if (c == '\n' || c == '\t' || c == '\r')
+        {
+            p[0] = '\\';
+            p[1] = (c == '\n') ? 'n' : (c == '\t') ? 't' : 'r';
+            o->len += 2;
+        }
+        else
+        {
+            memcpy(p, "\\u00", 4);
+            p[4] = hex[c >> 4];
+            p[5] = hex[c & 15];
+            o->len += 6;
+        }
+    }
+    put(o, s + run, n - run);
+    put(o, "\"", 1);
+}
+
+// CSV field: quoted, with doubled quotes, when it holds a separator, quote
+// or line break
+static void putCsvField(Output* o, const char* s, size_t n)
+{
+    size_t i = 0;
+    while (i < n && s[i] != ',' && s[i] != '"' && s[i] != '\n' && s[i] != '\r')
+    {
+        i++;
+    }
+    if (i == n)
+    {
+        put(o, s, n);
+        return;
+    }
+    put(o, "\"", 1);
+    size_t run = 0;
+    for (i = 0; i < n; i++)
+    {
+        if (s[i] == '"')
+        {
+            put(o, s + run, i + 1 - run); // Up to and including the quote...
+            run = i;                      // ...which is written again
+        }
+    }
+    put(o, s + run, n - run);
+    put(o, "\"", 1);
+}
+
+// --- Formats ---
+int openOutput(Output* o, FILE* stream, OutputFormat format, int flags)
+{
+    memset(o, 0, sizeof(*o));
+    o->stream = stream;
+    o->format = format;
+    o->flags = flags;
+    if (format == OUTPUT_BINARY)
+    {
+        o->flags &= ~OUTPUT_BANNERS; // Nothing but records in a binary stream
+        initTokenWriter(&o->bin, stream, (flags & OUTPUT_SYMBOLS) ? TOKFILE_SYMBOLS : 0);
+        return 1;
+    }
+    o->buf = malloc(OUTPUT_BUFFER_SIZE);
+    return o->buf != NULL;
+}
+
+void startOutputStream(Output* o)
+{
+    if (o->format == OUTPUT_CSV)
+    {
+        putString(o, "file,type,line,offset,length,text\n");
+    }
+    else if (o->format == OUTPUT_BINARY)
+    {
+        writeTokenHeader(&o->bin);
+    }
+}
+
+void beginOutputFile(Output* o, const char* filename)
+{
+    o->file = filename;
+    memset(o->counts, 0, sizeof(o->counts));
+    if (o->format == OUTPUT_BINARY)
+    {
+        beginTokenSection(&o->bin, filename);
+        return;
+    }
+    if (o->flags & OUTPUT_BANNERS)
+    {
+        putString(o, "Open   : ");
+        putString(o, filename);
+        putString(o, " : Success\nParsing : ");
+        putString(o, filename);
+        putString(o, " : Started\n");
+    }
+}
+
+static void writeTable(Output* o, LexerState* lx, const TokenBatch* batch, size_t count)
+{
+    const char* label = NULL;
+    size_t labelLen = 0;
+    TokenType labelType = UNKNOWN;
+    for (size_t i = 0; i < count; i++)
+    {
+        TokenType type = batch->type[i];
+        if (label == NULL || type != labelType)
+        {
+            label = getTokenTypeString(type);
+            labelLen = strlen(label);
+            labelType = type;
+        }
+        putLabel(o, label, labelLen);
+        put(o, lexerTextAt(lx, batch->start[i]), batch->length[i]);
+        put(o, "\n", 1);
+    }
+}
+
+static void writeJsonLines(Output* o, LexerState* lx, const TokenBatch* batch, size_t count)
+{
+    size_t fileLen = strlen(o->file);
+    for (size_t i = 0; i < count; i++)
+    {
+        put(o, "{\"file\":", 8);
+        putJsonString(o, o->file, fileLen);
+        put(o, ",\"type\":\"", 9);
+        putString(o, getTokenTypeString(batch->type[i]));
+        put(o, "\",\"line\":", 9);
+        putNumber(o, (size_t)batch->line[i]);
+        put(o, ",\"offset\":", 10);
+        putNumber(o, batch->start[i]);
+        put(o, ",\"length\":", 10);
+        putNumber(o, batch->length[i]);
+        put(o, ",\"text\":", 8);
+        putJsonString(o, lexerTextAt(lx, batch->start[i]), batch->length[i]);
+        put(o, "}\n", 2);
+    }
+}
+
+static void writeCsv(Output* o, LexerState* lx, const TokenBatch* batch, size_t count)
+{
+    size_t fileLen = strlen(o->file);
+    for (size_t i = 0; i < count; i++)
+    {
+        putCsvField(o, o->file, fileLen);
+        put(o, ",", 1);
+        putString(o, getTokenTypeString(batch->type[i]));
+        put(o, ",", 1);
+        putNumber(o, (size_t)batch->line[i]);
+        put(o, ",", 1);
+        putNumber(o, batch->start[i]);
+        put(o, ",", 1);
+        putNumber(o, batch->length[i]);
+        put(o, ",", 1);
+        putCsvField(o, lexerTextAt(lx, batch->start[i]), batch->length[i]);
+        put(o, "\n", 1);
+    }
+}
+
+void writeOutputTokens(Output* o, LexerState* lx, const TokenBatch* batch, size_t count)
+{
+    switch (o->format)
+    {
+        case OUTPUT_TABLE:
+            writeTable(o, lx, batch, count);
+            break;
+        case OUTPUT_JSONL:
+            writeJsonLines(o, lx, batch, count);
+            break;
+        case OUTPUT_CSV:
+            writeCsv(o, lx, batch, count);
+            break;
+        case OUTPUT_COUNT:
+            for (size_t i = 0; i < count; i++)
+            {
+                o->counts[batch->type[i]]++;
+            }
+            break;
+        case OUTPUT_BINARY:
+            writeTokens(&o->bin, batch, count);
+            break;
+    }
+}
+
+void switchOutputFile(Output* o, const char* filename)
+{
+    o->file = filename;
+    if (o->format == OUTPUT_BINARY)
+    {
+        endTokenSection(&o->bin);
+        beginTokenSection(&o->bin, filename);
+    }
+    else if (o->flags & OUTPUT_BANNERS)
+    {
+        putString(o, "In file : ");
+        putString(o, filename);
+        put(o, "\n", 1);
+    }
+}
+
+// One line per token type, then their sum
+static void writeCounts(Output* o, const size_t* counts)
+{
+    size_t total = 0;
+    for (int type = 0; type <= UNKNOWN; type++)
+    {
+        if (type == SPECIAL_CHARACTER || (type == DIRECTIVE && !(o->flags & OUTPUT_DIRECTIVES)))
+        {
+            continue; // Never produced
+        }
+        const char* name = getTokenTypeString((TokenType)type);
+        putLabel(o, name, strlen(name));
+        putNumber(o, counts[type]);
+        put(o, "\n", 1);
+        total += counts[type];
+    }
+    putLabel(o, "Total", 5);
+    putNumber(o, total);
+    put(o, "\n", 1);
+}
+
+void endOutputFile(Output* o)
+{
+    if (o->format == OUTPUT_BINARY)
+    {
+        endTokenSection(&o->bin);
+        return;
+    }
+    if (o->format == OUTPUT_COUNT)
+    {
+        // A "File" line keeps the totals of several files apart without banners
+        putLabel(o, "File", 4);
+        putString(o, o->file);
+        put(o, "\n", 1);
+        writeCounts(o, o->counts);
+    }
+    if (o->flags & OUTPUT_BANNERS)
+    {
+        putString(o, "Parsing : ");
+        putString(o, o->file);
+        putString(o, " : Done\n");
+    }
+}
+
+void writeOutputTotals(Output* o, const size_t* counts, size_t files)
+{
+    if (o->format != OUTPUT_COUNT)
+    {
+        return;
+    }
+    putLabel(o, "Files", 5);
+    putNumber(o, files);
+    put(o, "\n", 1);
+    writeCounts(o, counts);
+}
+
+void writeOutputBytes(Output* o, const void* bytes, size_t len, const uint32_t* symbolMap)
+{
+    if (o->format == OUTPUT_BINARY)
+    {
+        writeTokenBytes(&o->bin, bytes, len, symbolMap);
+    }
+    else
+    {
+        put(o, bytes, len);
+    }
+}
+
+int finishOutputStream(Output* o, Interner* symbols)
+{
+    if (o->format == OUTPUT_BINARY && !finishTokenWriter(&o->bin, symbols))
+    {
+        o->failed = 1;
+    }
+    return !o->failed;
+}
+
+int closeOutput(Output* o)
+{
+    flushOutput(o);
+    free(o->buf);
+    o->buf = NULL;
+    if (o->bin.failed)
+    {
+        o->failed = 1;
+    }
+    return !o->failed;
+}
+
+int parseOutputFormat(const char* name)
+{
+    static const char* const names[] = { "table", "jsonl", "csv", "count", "bin" };
+    for (int i = 0; i < (int)(sizeof(names) / sizeof(names[0])); i++)
+    {
+        if (strcmp(name, names[i]) == 0)
+        {
+            return i; // In OutputFormat order
+        }
+    }
+    return -1;
+}
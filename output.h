@@ -0,0 +1,67 @@
+#ifndef OUTPUT_H
+#define OUTPUT_H
+
+#include <stddef.h>
+#include <stdio.h>
+#include "lexer.h"
+#include "tokfile.h"
+
+// Token output for main: formats batches from nextTokens() into a large
+// buffer by hand (no printf per token) and writes it out in big blocks.
+typedef enum {
+    OUTPUT_TABLE,  // "Identifier          : main", the classic listing
+    OUTPUT_JSONL,  // One JSON object per token
+    OUTPUT_CSV,    // file,type,line,offset,length,text
+    OUTPUT_COUNT,  // Only the number of tokens of each type, per file
+    OUTPUT_BINARY  // tokfile.h records
+} OutputFormat;
+
+#define OUTPUT_BANNERS 1 // "Open : ..." / "Parsing : ..." lines around each file
+#define OUTPUT_SYMBOLS 2 // Binary: identifiers carry symbol ids, plus the string table
+#define OUTPUT_DIRECTIVES 4 // Count: a "Directive" line (the lexers keep directives)
+
+typedef struct {
+    FILE* stream;
+    OutputFormat format;
+    int flags;
+    char* buf;
+    size_t len;
+    const char* file;             // File being written
+    size_t counts[UNKNOWN + 1];   // OUTPUT_COUNT: tokens of each type in 'file'
+    TokenWriter bin;              // OUTPUT_BINARY
+    int failed;                   // A write failed
+} Output;
+
+// Returns 0 when out of memory
+int openOutput(Output* o, FILE* stream, OutputFormat format, int flags);
+// What comes once at the start of a whole stream: the CSV column names or
+// the binary header. Outputs whose bytes are copied into another (see
+// writeOutputBytes) leave it out.
+void startOutputStream(Output* o);
+void beginOutputFile(Output* o, const char* filename);
+// 'batch' needs 'line' for JSON Lines and CSV, and 'keyword' (plus 'symbol'
+// with OUTPUT_SYMBOLS) for the binary format
+void writeOutputTokens(Output* o, LexerState* lx, const TokenBatch* batch, size_t count);
+// The next tokens of the file being written come from another file (an
+// included header, or the includer again): JSON Lines and CSV name it, the
+// binary format starts a section for it, and the counts go on
+void switchOutputFile(Output* o, const char* filename);
+void endOutputFile(Output* o);
+// OUTPUT_COUNT only: the per-type totals of 'files' files, after a "Files"
+// line in place of the "File" one (other formats write nothing)
+void writeOutputTotals(Output* o, const size_t* counts, size_t files);
+// Write out what is buffered
+void flushOutput(Output* o);
+// Copy the output of another Output of the same format; 'symbolMap' (may be
+// NULL) maps the symbol ids of binary output, see writeTokenBytes()
+void writeOutputBytes(Output* o, const void* bytes, size_t len, const uint32_t* symbolMap);
+// End of the stream: the binary string table and trailer. Returns 0 if any
+// write failed.
+int finishOutputStream(Output* o, Interner* symbols);
+// Flush and free the buffer; returns 0 if any write failed
+int closeOutput(Output* o);
+
+// Parse a --format name ("table", "jsonl", "csv", "count", "bin"); -1 if unknown
+int parseOutputFormat(const char* name);
+
+#endif
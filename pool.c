@@ -0,0 +1,242 @@
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include "pool.h"
+
+typedef struct {
+    size_t count;
+    size_t next; // Next index to hand out, claimed atomically
+    void (*task)(size_t index, void* arg);
+    void* arg;
+} PoolJob;
+
+static void* poolWorker(void* p) 
+{
+    PoolJob* job = p;
+    while (1) 
+    {
+        size_t i = __atomic_fetch_add(&job->next, 1, __ATOMIC_RELAXED);
+        if (i >= job->count) 
+        {
+            break;
+        }
+        job->task(i, job->arg);
+    }
+    return NULL;
+}
+
+int poolDefaultThreads() 
+{
+    long n = sysconf(_SC_NPROCESSORS_ONLN);
+    return (n > 0) ? (int)n : 1;
+}
+
+// Run worker() on 'threads' threads, the calling one included; worker i
+// gets the argument at args + i * argSize. Workers that cannot be started
+// are run on the calling thread afterwards.
+static void runWorkers(int threads, void* (*worker)(void*), void* args, size_t argSize)
+{
+    pthread_t* tids = malloc(sizeof(pthread_t) * (size_t)(threads - 1));
+    int started = 0;
+    if (tids != NULL) 
+    {
+        for (; started < threads - 1; started++) 
+        {
+            if (pthread_create(&tids[started], NULL, worker, (char*)args + (size_t)(started + 1) * argSize) != 0) 
+            {
+                break;
+            }
+        }
+    }
+    worker(args);
+    for (int i = 0; i < started; i++) 
+    {
+        pthread_join(tids[i], NULL);
+    }
+    for (int i = started + 1; i < threads; i++) 
+    {
+        worker((char*)args + (size_t)i * argSize);
+    }
+    free(tids);
+}
+
+void parallelFor(size_t count, int threads, void (*task)(size_t index, void* arg), void* arg) 
+{
+    PoolJob job = { count, 0, task, arg };
+
+    if (threads <= 0) 
+    {
+        threads = poolDefaultThreads();
+    }
+    if ((size_t)threads > count) 
+    {
+        threads = (int)count;
+    }
+    if (threads <= 1) 
+    {
+        poolWorker(&job);
+        return;
+    }
+
+    // The calling thread works too, so only threads - 1 are spawned; with
+    // an argument size of 0 they all share the one job
+    runWorkers(threads, poolWorker, &job, 0);
+}
+
+// --- Work stealing ---
+// Each worker owns the tasks items[head, tail) of its deque. The owner and
+// thieves both lock it: a task is a whole file, so the lock is cheap next to
+// the task, and a deque on its own cache line keeps the owners apart.
+typedef struct {
+    _Alignas(64) pthread_mutex_t lock;
+    size_t head, tail;
+    size_t* items;
+} StealDeque;
+
+typedef struct {
+    StealDeque* deques;
+    int threads;
+    void (*task)(size_t index, void* arg);
+    void* arg;
+} StealJob;
+
+typedef struct {
+    StealJob* job;
+    int self;
+} StealWorker;
+
+static int popTask(StealDeque* d, size_t* index)
+{
+    pthread_mutex_lock(&d->lock);
+    int found = (d->head < d->tail);
+    if (found) 
+    {
+        // Atomic, as thieves look at head without the lock
+        *index = d->items[d->head];
+        __atomic_store_n(&d->head, d->head + 1, __ATOMIC_RELAXED);
+    }
+    pthread_mutex_unlock(&d->lock);
+    return found;
+}
+
+// Move the back half of the fullest other deque into the (empty) own one;
+// 0 once every deque is empty. Tasks never add tasks, so that is the end.
+static int stealTasks(StealJob* job, int self)
+{
+    while (1) 
+    {
+        int victim = -1;
+        size_t most = 0;
+        for (int i = 0; i < job->threads; i++) 
+        {
+            StealDeque* d = &job->deques[i];
+            // A racy look, only to pick the victim; the move itself is locked
+            size_t left = __atomic_load_n(&d->tail, __ATOMIC_RELAXED) - __atomic_load_n(&d->head, __ATOMIC_RELAXED);
+            if (i != self && left > most && left <= (size_t)-1 / 2) 
+            {
+                victim = i;
+                most = left;
+            }
+        }
+        if (victim < 0) 
+        {
+            return 0;
+        }
+
+        // Both locks, always in index order so two thieves cannot deadlock
+        StealDeque* own = &job->deques[self];
+        StealDeque* from = &job->deques[victim];
+        StealDeque* first = (self < victim) ? own : from;
+        StealDeque* second = (self < victim) ? from : own;
+        pthread_mutex_lock(&first->lock);
+        pthread_mutex_lock(&second->lock);
+        size_t left = from->tail - from->head;
+        size_t take = (left + 1) / 2;
+        if (take > 0) 
+        {
+            // The own deque is empty, and no deque ever holds more than at the start
+            memcpy(own->items, from->items + from->tail - take, take * sizeof(size_t));
+            __atomic_store_n(&own->head, 0, __ATOMIC_RELAXED);
+            __atomic_store_n(&own->tail, take, __ATOMIC_RELAXED);
+            __atomic_store_n(&from->tail, from->tail - take, __ATOMIC_RELAXED);
+        }
+        pthread_mutex_unlock(&second->lock);
+        pthread_mutex_unlock(&first->lock);
+        if (take > 0) 
+        {
+            return 1;
+        }
+    }
+}
+
+static void* stealWorker(void* p) 
+{
+    StealWorker* w = p;
+    StealJob* job = w->job;
+    size_t index;
+    do 
+    {
+        while (popTask(&job->deques[w->self], &index)) 
+        {
+            job->task(index, job->arg);
+        }
+    } while (stealTasks(job, w->self));
+    return NULL;
+}
+
+void parallelForStealing(const size_t* order, size_t count, int threads,
+                         void (*task)(size_t index, void* arg), void* arg)
+{
+    if (threads <= 0) 
+    {
+        threads = poolDefaultThreads();
+    }
+    if ((size_t)threads > count) 
+    {
+        threads = (int)count;
+    }
+
+    size_t per = (threads > 0) ? (count + (size_t)threads - 1) / (size_t)threads : 0;
+    StealDeque* deques = (threads > 1) ? aligned_alloc(64, sizeof(StealDeque) * (size_t)threads) : NULL;
+    size_t* items = (deques != NULL) ? malloc(sizeof(size_t) * per * (size_t)threads) : NULL;
+    StealWorker* workers = (items != NULL) ? malloc(sizeof(StealWorker) * (size_t)threads) : NULL;
+    if (workers == NULL) 
+    {
+        // One thread (or no memory for the deques): run them in order
+        for (size_t k = 0; k < count; k++) 
+        {
+            task(order[k], arg);
+        }
+        free(items);
+        free(deques);
+        return;
+    }
+
+    // Deal round-robin, so every deque starts with its share of the costly tasks
+    StealJob job = { deques, threads, task, arg };
+    for (int i = 0; i < threads; i++) 
+    {
+        pthread_mutex_init(&deques[i].lock, NULL);
+        deques[i].items = items + (size_t)i * per;
+        deques[i].head = 0;
+        deques[i].tail = 0;
+        workers[i].job = &job;
+        workers[i].self = i;
+    }
+    for (size_t k = 0; k < count; k++) 
+    {
+        StealDeque* d = &deques[k % (size_t)threads];
+        d->items[d->tail++] = order[k];
+    }
+
+    runWorkers(threads, stealWorker, workers, sizeof(StealWorker));
+
+    for (int i = 0; i < threads; i++) 
+    {
+        pthread_mutex_destroy(&deques[i].lock);
+    }
+    free(workers);
+    free(items);
+    free(deques);
+}
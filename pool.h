@@ -0,0 +1,22 @@
+#ifndef POOL_H
+#define POOL_H
+
+#include <stddef.h>
+
+// Run task(index, arg) for every index in [0, count) on up to 'threads'
+// worker threads (0 means one per online CPU) and wait for all of them.
+// Indices are handed out dynamically, so uneven tasks still balance.
+void parallelFor(size_t count, int threads, void (*task)(size_t index, void* arg), void* arg);
+
+// Work-stealing variant for tasks of very uneven cost, such as whole files:
+// runs task(order[k], arg) for k in [0, count). 'order' should list the
+// costliest tasks first. They are dealt round-robin into one deque per
+// worker; a worker takes from the front of its own deque and, once it is
+// empty, steals the back half of the fullest other one.
+void parallelForStealing(const size_t* order, size_t count, int threads,
+                         void (*task)(size_t index, void* arg), void* arg);
+
+// Number of online CPUs, at least 1
+int poolDefaultThreads();
+
+#endif
@@ -0,0 +1,280 @@
+#include <dirent.h>
+#include <glob.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include "interner.h"
+#include "project.h"
+
+static int isGlob(const char* arg)
+{
+    return strpbrk(arg, "*?[") != NULL;
+}
+
+int isProjectArgument(const char* arg)
+{
+    struct stat st;
+    if (stat(arg, &st) == 0)
+    {
+        return S_ISDIR(st.st_mode);
+    }
+    return isGlob(arg);
+}
+
+static int hasSourceExtension(const char* name, size_t len)
+{
+    return len > 2 && name[len - 2] == '.' && (name[len - 1] == 'c' || name[len - 1] == 'h');
+}
+
+// Append 'path' unless it is in the list already; 0 when out of memory
+static int addPath(SourceList* list, const char* path, uint64_t size)
+{
+    if (list->names == NULL && (list->names = createInterner(0)) == NULL)
+    {
+        return 0;
+    }
+    uint32_t before = internerCount(list->names);
+    uint32_t id = internString(list->names, path, strlen(path));
+    if (id == NO_SYMBOL)
+    {
+        return 0;
+    }
+    if (id <= before)
+    {
+        return 1; // Named twice
+    }
+    if (list->count == list->capacity)
+    {
+        size_t n = (list->capacity > 0) ? list->capacity * 2 : 64;
+        const char** paths = realloc(list->paths, n * sizeof(*paths));
+        if (paths == NULL)
+        {
+            return 0;
+        }
+        list->paths = paths;
+        uint64_t* sizes = realloc(list->sizes, n * sizeof(*sizes));
+        if (sizes == NULL)
+        {
+            return 0;
+        }
+        list->sizes = sizes;
+        list->capacity = n;
+    }
+    // The interner's copy of the name never moves
+    list->paths[list->count] = internedString(list->names, id, NULL);
+    list->sizes[list->count] = size;
+    list->count++;
+    list->totalBytes += size;
+    return 1;
+}
+
+static int compareNames(const void* a, const void* b)
+{
+    return strcmp(*(char* const*)a, *(char* const*)b);
+}
+
+// Add the sources under directory 'dir', depth first with each directory's
+// entries in name order. 0 on an error, which has been printed.
+static int addDirectory(SourceList* list, const char* dir, FILE* err)
+{
+    DIR* d = opendir(dir);
+    if (d == NULL)
+    {
+        fprintf(err, "Error: Could not read directory '%s'\n", dir);
+        return 0;
+    }
+    char** names = NULL;
+    size_t count = 0, capacity = 0;
+    int ok = 1;
+    struct dirent* e;
+    while ((e = readdir(d)) != NULL)
+    {
+        if (e->d_name[0] == '.')
+        {
+            continue; // ".", ".." and hidden entries (.git and the like)
+        }
+        if (count == capacity)
+        {
+            capacity = (capacity > 0) ? capacity * 2 : 32;
+            char** grown = realloc(names, capacity * sizeof(char*));
+            if (grown == NULL)
+            {
+                ok = 0;
+                break;
+            }
+            names = grown;
+        }
+        if ((names[count] = strdup(e->d_name)) == NULL)
+        {
+            ok = 0;
+            break;
+        }
+        count++;
+    }
+    closedir(d);
+    if (!ok)
+    {
+        fprintf(err, "Error: Out of memory\n");
+    }
+    else if (count > 0)
+    {
+        qsort(names, count, sizeof(char*), compareNames);
+    }
+
+    size_t dirLen = strlen(dir);
+    int slash = (dirLen > 0 && dir[dirLen - 1] == '/');
+    for (size_t i = 0; i < count && ok; i++)
+    {
+        size_t nameLen = strlen(names[i]);
+        char* path = malloc(dirLen + 1 + nameLen + 1);
+        if (path == NULL)
+        {
+            fprintf(err, "Error: Out of memory\n");
+            ok = 0;
+            break;
+        }
+        memcpy(path, dir, dirLen);
+        if (!slash)
+        {
+            path[dirLen] = '/';
+        }
+        memcpy(path + dirLen + !slash, names[i], nameLen + 1);
+
+        // lstat first: links are followed to files but not to directories,
+        // which could form a cycle
+        struct stat st;
+        if (lstat(path, &st) == 0 && S_ISDIR(st.st_mode))
+        {
+            ok = addDirectory(list, path, err);
+        }
+        else if (hasSourceExtension(names[i], nameLen) && stat(path, &st) == 0 && S_ISREG(st.st_mode))
+        {
+            if (!addPath(list, path, (uint64_t)st.st_size))
+            {
+                fprintf(err, "Error: Out of memory\n");
+                ok = 0;
+            }
+        }
+        free(path);
+    }
+    for (size_t i = 0; i < count; i++)
+    {
+        free(names[i]);
+    }
+    free(names);
+    return ok;
+}
+
+// A file named on the command line (or matched by a pattern) is lexed
+// whatever its extension; a directory is searched
+static int addArgument(SourceList* list, const char* path, FILE* err)
+{
+    struct stat st;
+    if (strcmp(path, "-") != 0 && stat(path, &st) == 0)
+    {
+        if (S_ISDIR(st.st_mode))
+        {
+            return addDirectory(list, path, err);
+        }
+        if (!addPath(list, path, (uint64_t)st.st_size))
+        {
+            fprintf(err, "Error: Out of memory\n");
+            return 0;
+        }
+        return 1;
+    }
+    // Missing files stay in the list, so lexing them reports the error in its place
+    if (!addPath(list, path, 0))
+    {
+        fprintf(err, "Error: Out of memory\n");
+        return 0;
+    }
+    return 1;
+}
+
+int addSources(SourceList* list, const char* arg, FILE* err)
+{
+    struct stat st;
+    if (!isGlob(arg) || stat(arg, &st) == 0)
+    {
+        return addArgument(list, arg, err);
+    }
+
+    // GLOB_NOSORT and a byte-wise sort: the order must not depend on the locale
+    glob_t g;
+    int r = glob(arg, GLOB_NOSORT, NULL, &g);
+    if (r == GLOB_NOMATCH)
+    {
+        fprintf(err, "Error: No files match '%s'\n", arg);
+        return 0;
+    }
+    if (r != 0)
+    {
+        fprintf(err, "Error: Could not expand '%s'\n", arg);
+        return 0;
+    }
+    qsort(g.gl_pathv, g.gl_pathc, sizeof(char*), compareNames);
+    int ok = 1;
+    for (size_t i = 0; i < g.gl_pathc && ok; i++)
+    {
+        ok = addArgument(list, g.gl_pathv[i], err);
+    }
+    globfree(&g);
+    return ok;
+}
+
+typedef struct {
+    uint64_t size;
+    size_t index;
+} SizedSource;
+
+static int compareSizes(const void* a, const void* b)
+{
+    const SizedSource* x = a;
+    const SizedSource* y = b;
+    if (x->size != y->size)
+    {
+        return (x->size > y->size) ? -1 : 1;
+    }
+    return (x->index > y->index) - (x->index < y->index);
+}
+
+size_t* largestSourcesFirst(const SourceList* list)
+{
+    size_t n = (list->count > 0) ? list->count : 1;
+    SizedSource* sized = malloc(n * sizeof(SizedSource));
+    size_t* order = malloc(n * sizeof(size_t));
+    if (sized == NULL || order == NULL)
+    {
+        free(sized);
+        free(order);
+        return NULL;
+    }
+    for (size_t i = 0; i < list->count; i++)
+    {
+        sized[i].size = list->sizes[i];
+        sized[i].index = i;
+    }
+    qsort(sized, list->count, sizeof(SizedSource), compareSizes);
+    for (size_t i = 0; i < list->count; i++)
+    {
+        order[i] = sized[i].index;
+    }
+    free(sized);
+    return order;
+}
+
+void freeSourceList(SourceList* list)
+{
+    free(list->paths);
+    free(list->sizes);
+    if (list->names != NULL)
+    {
+        destroyInterner(list->names);
+    }
+    list->paths = NULL;
+    list->sizes = NULL;
+    list->names = NULL;
+    list->count = list->capacity = 0;
+    list->totalBytes = 0;
+}
@@ -0,0 +1,37 @@
+#ifndef PROJECT_H
+#define PROJECT_H
+
+#include <stdint.h>
+#include <stdio.h>
+#include "interner.h"
+
+// Source discovery for project mode: turns the command-line arguments into
+// the list of files to lex, in an order that does not depend on the file
+// system (directory entries are sorted by name). A zeroed SourceList is empty.
+typedef struct {
+    const char** paths;  // Stored in 'names'
+    uint64_t* sizes;     // Bytes, from stat; 0 for "-" and missing files
+    Interner* names;     // Every path once, to drop repeats
+    size_t count, capacity;
+    uint64_t totalBytes;
+} SourceList;
+
+// Nonzero if 'arg' names a directory or is a glob pattern that is not also
+// the name of a file, i.e. needs addSources() to become a list of files
+int isProjectArgument(const char* arg);
+
+// Append the files 'arg' stands for: a file (or "-") as it is, the .c and .h
+// files under a directory at any depth (hidden entries and symbolic links
+// to directories skipped), or the matches of a glob pattern, where matched
+// directories are searched the same way. A file already in the list is not
+// added again. Returns 0 after printing to 'err' when 'arg' matches nothing
+// or cannot be read.
+int addSources(SourceList* list, const char* arg, FILE* err);
+
+// Indices of the files, largest first (ties in list order), for scheduling;
+// NULL when out of memory. Free with free().
+size_t* largestSourcesFirst(const SourceList* list);
+
+void freeSourceList(SourceList* list);
+
+#endif
@@ -0,0 +1,592 @@
+#include <dirent.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+#include "lexer_internal.h"
+#include "tokcache.h"
+#include "tokfile.h"
+
+// Entry layout (little-endian):
+//
+//   0  "LXTC", u32 TOKCACHE_VERSION
+//   8  u64 key, u64 size of the input
+//  24  u64 hash of everything from byte 32 on
+//  32  u32 reserved (0), u32 diagnostic count
+//  40  u64 repeated and u64 dropped diagnostic counts (see DiagLog)
+//  56  u64 offset of the token file
+//  64  diagnostics: u32 code, line, column, message length, u64 offset,
+//      length, then the message
+//      a token file of one section (tokfile.h), to the end
+#define ENTRY_HEADER 64
+#define DIAG_RECORD 32
+#define STALE_TEMP_SECONDS 3600 // Temporary files older than this were abandoned
+
+static char* cacheDir = NULL;
+static uint64_t cacheLimit = TOKCACHE_DEFAULT_LIMIT;
+static TokenCacheStats counters;
+
+#define COUNT(field) __atomic_fetch_add(&counters.field, 1, __ATOMIC_RELAXED)
+
+typedef enum { CACHE_REPLAY, CACHE_RECORD } CacheMode;
+
+struct CacheEntry {
+    CacheMode mode;
+    uint64_t key;
+    char path[4096];
+
+    // Replay: the mapped entry and a cursor over its tokens
+    const unsigned char* map;
+    size_t mapSize;
+    TokenFile* tokens;
+    TokenCursor cursor;
+
+    // Record: tokens are encoded into memory as they are handed out
+    FILE* stream;
+    char* bytes;
+    size_t byteCount;
+    TokenWriter writer;
+    int* lines;          // Columns the writer needs when the caller's batch has none
+    KeywordId* keywords;
+    size_t scratch;
+};
+
+// --- Hashing: 64-bit, four lanes of multiply-rotate (the xxHash64 scheme) ---
+#define PRIME1 0x9E3779B185EBCA87ULL
+#define PRIME2 0xC2B2AE3D27D4EB4FULL
+#define PRIME3 0x165667B19E3779F9ULL
+#define PRIME4 0x85EBCA77C2B2AE63ULL
+#define PRIME5 0x27D4EB2F165667C5ULL
+
+static inline uint64_t rotl(uint64_t v, int r)
+{
+    return (v << r) | (v >> (64 - r));
+}
+
+static inline uint64_t read64(const unsigned char* p)
+{
+    uint64_t v;
+    memcpy(&v, p, 8);
+    return v;
+}
+
+static inline uint64_t hashRound(uint64_t acc, uint64_t in)
+{
+    return rotl(acc + in * PRIME2, 31) * PRIME1;
+}
+
+static uint64_t hashBytes(const void* data, size_t len, uint64_t seed)
+{
+    const unsigned char* p = data;
+    const unsigned char* end = p + len;
+    uint64_t h;
+    if (len >= 32)
+    {
+        uint64_t v1 = seed + PRIME1 + PRIME2, v2 = seed + PRIME2, v3 = seed, v4 = seed - PRIME1;
+        for (; p + 32 <= end; p += 32)
+        {
+            v1 = hashRound(v1, read64(p));
+            v2 = hashRound(v2, read64(p + 8));
+            v3 = hashRound(v3, read64(p + 16));
+            v4 = hashRound(v4, read64(p + 24));
+        }
+        h = rotl(v1, 1) + rotl(v2, 7) + rotl(v3, 12) + rotl(v4, 18);
+        uint64_t lanes[4] = { v1, v2, v3, v4 };
+        for (int i = 0; i < 4; i++)
+        {
+            h = (h ^ hashRound(0, lanes[i])) * PRIME1 + PRIME4;
+        }
+    }
+    else
+    {
+        h = seed + PRIME5;
+    }
+    h += (uint64_t)len;
+    for (; p + 8 <= end; p += 8)
+    {
+        h = rotl(h ^ hashRound(0, read64(p)), 27) * PRIME1 + PRIME4;
+    }
+    for (; p < end; p++)
+    {
+        h = rotl(h ^ (*p * PRIME5), 11) * PRIME1;
+    }
+    h ^= h >> 33;
+    h *= PRIME2;
+    h ^= h >> 29;
+    h *= PRIME3;
+    return h ^ (h >> 32);
+}
+
+// --- Little-endian fields ---
+static void putLE(unsigned char* p, uint64_t v, int bytes)
+{
+    for (int i = 0; i < bytes; i++)
+    {
+        p[i] = (unsigned char)(v >> (8 * i));
+    }
+}
+
+static uint64_t getLE(const unsigned char* p, int bytes)
+{
+    uint64_t v = 0;
+    for (int i = bytes - 1; i >= 0; i--)
+    {
+        v = (v << 8) | p[i];
+    }
+    return v;
+}
+
+// --- Configuration ---
+int setTokenCache(const char* dir, uint64_t maxBytes)
+{
+    free(cacheDir);
+    cacheDir = NULL;
+    if (dir == NULL)
+    {
+        return 1;
+    }
+    struct stat st;
+    if ((mkdir(dir, 0777) != 0 && errno != EEXIST) || stat(dir, &st) != 0 || !S_ISDIR(st.st_mode) ||
+        access(dir, R_OK | W_OK | X_OK) != 0)
+    {
+        return 0;
+    }
+    cacheDir = strdup(dir);
+    cacheLimit = (maxBytes > 0) ? maxBytes : TOKCACHE_DEFAULT_LIMIT;
+    return cacheDir != NULL;
+}
+
+void getTokenCacheStats(TokenCacheStats* stats)
+{
+    stats->hits = __atomic_load_n(&counters.hits, __ATOMIC_RELAXED);
+    stats->misses = __atomic_load_n(&counters.misses, __ATOMIC_RELAXED);
+    stats->stores = __atomic_load_n(&counters.stores, __ATOMIC_RELAXED);
+    stats->evictions = __atomic_load_n(&counters.evictions, __ATOMIC_RELAXED);
+    stats->failures = __atomic_load_n(&counters.failures, __ATOMIC_RELAXED);
+}
+
+// --- Replay ---
+
+// Map the entry at e->path and check it belongs to lx's input. Loads its
+// diagnostics into lx. Returns 0 (leaving lx alone) if it is missing or
+// does not check out.
+static int openEntry(LexerState* lx, CacheEntry* e)
+{
+    int fd = open(e->path, O_RDONLY);
+    if (fd < 0)
+    {
+        return 0;
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size < ENTRY_HEADER)
+    {
+        close(fd);
+        return 0;
+    }
+    size_t size = (size_t)st.st_size;
+    void* map = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED)
+    {
+        return 0;
+    }
+    const unsigned char* m = map;
+    uint64_t tokOffset = getLE(m + 56, 8);
+    int ok = memcmp(m, "LXTC", 4) == 0 && getLE(m + 4, 4) == TOKCACHE_VERSION &&
+             getLE(m + 8, 8) == e->key && getLE(m + 16, 8) == lx->srcLen &&
+             tokOffset >= ENTRY_HEADER && tokOffset <= size &&
+             getLE(m + 24, 8) == hashBytes(m + 32, size - 32, 0);
+    if (ok)
+    {
+        e->tokens = readTokenFile(m + tokOffset, size - tokOffset);
+        ok = (e->tokens != NULL);
+    }
+
+    // Diagnostics, checked before any is taken
+    uint32_t diagCount = ok ? (uint32_t)getLE(m + 36, 4) : 0;
+    const unsigned char* p = m + ENTRY_HEADER;
+    for (uint32_t i = 0; ok && i < diagCount; i++)
+    {
+        ok = (size_t)(m + tokOffset - p) >= DIAG_RECORD &&
+             getLE(p + 12, 4) <= (size_t)(m + tokOffset - p) - DIAG_RECORD;
+        p += ok ? DIAG_RECORD + getLE(p + 12, 4) : 0;
+    }
+    if (!ok)
+    {
+        if (e->tokens != NULL)
+        {
+            closeTokenFile(e->tokens);
+            e->tokens = NULL;
+        }
+        munmap(map, size);
+        COUNT(failures);
+        return 0;
+    }
+    p = m + ENTRY_HEADER;
+    for (uint32_t i = 0; i < diagCount; i++)
+    {
+        DiagEntry at = { .code = (DiagCode)getLE(p, 4), .line = (int)getLE(p + 4, 4), .column = (int)getLE(p + 8, 4),
+                         .offset = getLE(p + 16, 8), .length = getLE(p + 24, 8), .textLength = getLE(p + 12, 4) };
+        DiagLog text = { .text = (char*)(p + DIAG_RECORD) };
+        copyDiagnostic(&lx->diags, &text, &at);
+        p += DIAG_RECORD + at.textLength;
+    }
+    lx->diags.repeated += getLE(m + 40, 8);
+    lx->diags.dropped += getLE(m + 48, 8);
+
+    e->map = m;
+    e->mapSize = size;
+    startTokenCursor(e->tokens, &e->cursor);
+    nextTokenSection(&e->cursor);
+    utimensat(AT_FDCWD, e->path, NULL, 0); // Recently used
+    return 1;
+}
+
+// Fill 'batch' from the entry
+static size_t replayTokens(LexerState* lx, CacheEntry* e, TokenBatch* batch)
+{
+    size_t n = 0;
+    FileToken t;
+    while (n < batch->capacity && readFileToken(&e->cursor, &t))
+    {
+        if (t.start > lx->srcLen || t.length > lx->srcLen - t.start)
+        {
+            e->cursor.corrupt = 1;
+            break;
+        }
+        batch->type[n] = t.type;
+        batch->start[n] = t.start;
+        batch->length[n] = t.length;
+        if (batch->line != NULL)
+        {
+            batch->line[n] = t.line;
+        }
+        if (batch->keyword != NULL)
+        {
+            batch->keyword[n] = t.keyword;
+        }
+        if (batch->symbol != NULL)
+        {
+            batch->symbol[n] = NO_SYMBOL;
+        }
+        if (lx->interner != NULL && t.type == IDENTIFIER)
+        {
+            uint32_t symbol = internString(lx->interner, lx->srcBuf + t.start, t.length);
+            if (batch->symbol != NULL)
+            {
+                batch->symbol[n] = symbol;
+            }
+        }
+        lx->tokStart = t.start;
+        n++;
+    }
+    if (n == 0)
+    {
+        if (e->cursor.corrupt)
+        {
+            // The hash matched, so this is damage in memory rather than on disk
+            COUNT(failures);
+        }
+        // Leave the lexer as the scanner ends
+        lx->eofFlag = 1;
+        lx->currentChar = '\0';
+        lx->readPos = lx->srcLen;
+        lx->tokStart = lx->srcLen;
+        lx->tokLen = 0;
+    }
+    return n;
+}
+
+// --- Record ---
+
+static int startRecording(CacheEntry* e)
+{
+    e->stream = open_memstream(&e->bytes, &e->byteCount);
+    if (e->stream == NULL)
+    {
+        return 0;
+    }
+    initTokenWriter(&e->writer, e->stream, 0);
+    writeTokenHeader(&e->writer);
+    beginTokenSection(&e->writer, "");
+    return 1;
+}
+
+static size_t recordTokens(LexerState* lx, CacheEntry* e, TokenBatch* batch)
+{
+    // The writer needs lines and keywords; borrow arrays when the caller has none
+    TokenBatch full = *batch;
+    if ((batch->line == NULL || batch->keyword == NULL) && e->scratch < batch->capacity)
+    {
+        free(e->lines);
+        free(e->keywords);
+        e->lines = malloc(batch->capacity * sizeof(int));
+        e->keywords = malloc(batch->capacity * sizeof(KeywordId));
+        e->scratch = (e->lines != NULL && e->keywords != NULL) ? batch->capacity : 0;
+    }
+    if (full.line == NULL)
+    {
+        full.line = e->lines;
+    }
+    if (full.keyword == NULL)
+    {
+        full.keyword = e->keywords;
+    }
+    if (full.line == NULL || full.keyword == NULL)
+    {
+        e->writer.failed = 1; // Out of memory: lex on, store nothing
+        return lexerFillTokens(lx, batch);
+    }
+    size_t n = lexerFillTokens(lx, &full);
+    if (!e->writer.failed)
+    {
+        writeTokens(&e->writer, &full, n);
+    }
+    return n;
+}
+
+// Remove the least recently used entries until the directory is under its limit
+static void evictEntries()
+{
+    DIR* d = opendir(cacheDir);
+    if (d == NULL)
+    {
+        return;
+    }
+    typedef struct {
+        char name[64];
+        time_t used;
+        uint64_t size;
+    } Item;
+    Item* items = NULL;
+    size_t count = 0, cap = 0;
+    uint64_t total = 0;
+    time_t now = time(NULL);
+    struct dirent* de;
+    char path[4096];
+    while ((de = readdir(d)) != NULL)
+    {
+        size_t len = strlen(de->d_name);
+        int temp = strncmp(de->d_name, ".tmp-", 5) == 0;
+        if (len >= sizeof(items->name) || (!temp && (len < 4 || strcmp(de->d_name + len - 4, ".ltc") != 0)))
+        {
+            continue;
+        }
+        snprintf(path, sizeof(path), "%s/%s", cacheDir, de->d_name);
+        struct stat st;
+        if (stat(path, &st) != 0)
+        {
+            continue; // Removed by another process meanwhile
+        }
+        if (temp)
+        {
+            if (now - st.st_mtime > STALE_TEMP_SECONDS)
+            {
+                unlink(path);
+            }
+            continue;
+        }
+        if (count == cap)
+        {
+            cap = cap ? cap * 2 : 256;
+            Item* grown = realloc(items, cap * sizeof(Item));
+            if (grown == NULL)
+            {
+                break;
+            }
+            items = grown;
+        }
+        memcpy(items[count].name, de->d_name, len + 1);
+        items[count].used = st.st_mtime;
+        items[count].size = (uint64_t)st.st_size;
+        total += items[count].size;
+        count++;
+    }
+    closedir(d);
+
+    // Oldest first, down to 90% of the limit so that not every store evicts
+    while (total > cacheLimit && count > 0)
+    {
+        uint64_t target = cacheLimit / 10 * 9;
+        size_t oldest = 0;
+        for (size_t i = 1; i < count; i++)
+        {
+            if (items[i].used < items[oldest].used)
+            {
+                oldest = i;
+            }
+        }
+        snprintf(path, sizeof(path), "%s/%s", cacheDir, items[oldest].name);
+        if (unlink(path) == 0)
+        {
+            COUNT(evictions);
+        }
+        total -= items[oldest].size;
+        items[oldest] = items[--count];
+        if (total <= target)
+        {
+            break;
+        }
+    }
+    free(items);
+}
+
+// Write the finished recording as a new entry
+static void storeEntry(LexerState* lx, CacheEntry* e)
+{
+    endTokenSection(&e->writer);
+    finishTokenWriter(&e->writer, NULL);
+    if (fclose(e->stream) != 0)
+    {
+        e->writer.failed = 1;
+    }
+    e->stream = NULL;
+    if (e->writer.failed)
+    {
+        COUNT(failures);
+        return;
+    }
+
+    const DiagLog* log = &lx->diags;
+    size_t diagBytes = 0;
+    for (size_t i = 0; i < log->count; i++)
+    {
+        diagBytes += DIAG_RECORD + log->entries[i].textLength;
+    }
+    size_t size = ENTRY_HEADER + diagBytes + e->byteCount;
+    unsigned char* entry = malloc(size);
+    if (entry == NULL)
+    {
+        COUNT(failures);
+        return;
+    }
+    memcpy(entry, "LXTC", 4);
+    putLE(entry + 4, TOKCACHE_VERSION, 4);
+    putLE(entry + 8, e->key, 8);
+    putLE(entry + 16, lx->srcLen, 8);
+    putLE(entry + 32, 0, 4);
+    putLE(entry + 36, log->count, 4);
+    putLE(entry + 40, log->repeated, 8);
+    putLE(entry + 48, log->dropped, 8);
+    putLE(entry + 56, ENTRY_HEADER + diagBytes, 8);
+    unsigned char* p = entry + ENTRY_HEADER;
+    for (size_t i = 0; i < log->count; i++)
+    {
+        const DiagEntry* d = &log->entries[i];
+        putLE(p, (uint64_t)d->code, 4);
+        putLE(p + 4, (uint64_t)d->line, 4);
+        putLE(p + 8, (uint64_t)d->column, 4);
+        putLE(p + 12, d->textLength, 4);
+        putLE(p + 16, d->offset, 8);
+        putLE(p + 24, d->length, 8);
+        memcpy(p + DIAG_RECORD, log->text + d->text, d->textLength);
+        p += DIAG_RECORD + d->textLength;
+    }
+    memcpy(p, e->bytes, e->byteCount);
+    putLE(entry + 24, hashBytes(entry + 32, size - 32, 0), 8);
+
+    // Into a temporary file, then renamed over the final name in one step
+    char temp[4096];
+    snprintf(temp, sizeof(temp), "%s/.tmp-XXXXXX", cacheDir);
+    int fd = mkstemp(temp);
+    int ok = (fd >= 0);
+    if (ok)
+    {
+        fchmod(fd, 0644);
+        size_t done = 0;
+        while (ok && done < size)
+        {
+            ssize_t n = write(fd, entry + done, size - done);
+            ok = (n > 0 || (n < 0 && errno == EINTR));
+            done += (n > 0) ? (size_t)n : 0;
+        }
+        ok = (close(fd) == 0) && ok;
+        ok = ok && rename(temp, e->path) == 0;
+        if (!ok)
+        {
+            unlink(temp);
+        }
+    }
+    free(entry);
+    if (!ok)
+    {
+        COUNT(failures);
+        return;
+    }
+    COUNT(stores);
+    evictEntries();
+}
+
+// --- Hooks for lexer.c ---
+
+void openCacheEntry(LexerState* lx)
+{
+    if (cacheDir == NULL || !lx->srcMapped || lx->readPos != 1)
+    {
+        return; // Off, a streamed input, or tokens already taken
+    }
+    CacheEntry* e = calloc(1, sizeof(CacheEntry));
+    if (e == NULL)
+    {
+        return;
+    }
+    // Whatever changes the tokens or diagnostics of an input is in the key
+    uint64_t versions[6] = { LEXER_VERSION, TOKFILE_VERSION, TOKCACHE_VERSION, lx->diags.limit, (uint64_t)lx->keepDirectives, (uint64_t)lx->dialect };
+    e->key = hashBytes(lx->srcBuf, lx->srcLen, hashBytes(versions, sizeof(versions), 0));
+    snprintf(e->path, sizeof(e->path), "%s/%016llx.ltc", cacheDir, (unsigned long long)e->key);
+
+    if (openEntry(lx, e))
+    {
+        e->mode = CACHE_REPLAY;
+        COUNT(hits);
+    }
+    else
+    {
+        COUNT(misses);
+        e->mode = CACHE_RECORD;
+        if (!startRecording(e))
+        {
+            free(e);
+            return;
+        }
+    }
+    lx->cache = e;
+}
+
+size_t cacheTokens(LexerState* lx, TokenBatch* batch)
+{
+    CacheEntry* e = lx->cache;
+    return (e->mode == CACHE_REPLAY) ? replayTokens(lx, e, batch) : recordTokens(lx, e, batch);
+}
+
+void closeCacheEntry(LexerState* lx)
+{
+    CacheEntry* e = lx->cache;
+    if (e == NULL)
+    {
+        return;
+    }
+    if (e->mode == CACHE_RECORD && lx->eofFlag)
+    {
+        storeEntry(lx, e);
+    }
+    if (e->stream != NULL)
+    {
+        fclose(e->stream);
+    }
+    free(e->bytes);
+    free(e->lines);
+    free(e->keywords);
+    closeTokenFile(e->tokens);
+    if (e->map != NULL)
+    {
+        munmap((void*)e->map, e->mapSize);
+    }
+    free(e);
+    lx->cache = NULL;
+}
@@ -0,0 +1,43 @@
+#ifndef TOKCACHE_H
+#define TOKCACHE_H
+
+#include <stdint.h>
+#include "lexer.h"
+
+// Persistent token cache, shared between runs and between processes. An
+// entry holds the finished token stream (in the tokfile.h format) and the
+// diagnostics of one input, and is named after a hash of the input's bytes,
+// the lexer and format versions, the diagnostic limit and whether directives
+// are kept:
+//
+//   <dir>/<16 hex digits>.ltc
+//
+// A lexer with the cache on looks its input up before the first token. On a
+// hit it replays the entry (mapped, not read) instead of scanning; on a miss
+// it records what it hands out and stores it when closed, if the input was
+// lexed to the end. Only files that can be mapped are cached.
+//
+// Entries are written to a temporary file and renamed into place, so readers
+// in other processes see a whole entry or none. When the directory grows past
+// its size limit the least recently used entries (by mtime, which a hit
+// refreshes) are removed.
+
+#define TOKCACHE_VERSION 2                          // Of the entry layout
+#define TOKCACHE_DEFAULT_LIMIT ((uint64_t)256 << 20) // Bytes of entries per directory
+
+// Turn the cache on for every lexer opened from now on (NULL 'dir': off). The
+// directory is created if needed. Returns 0 if it cannot be used.
+int setTokenCache(const char* dir, uint64_t maxBytes);
+
+typedef struct {
+    uint64_t hits;
+    uint64_t misses;
+    uint64_t stores;    // Entries written
+    uint64_t evictions; // Entries removed to stay under the limit
+    uint64_t failures;  // Entries that could not be written, or were damaged
+} TokenCacheStats;
+
+// Counters of this process, over all lexers
+void getTokenCacheStats(TokenCacheStats* stats);
+
+#endif
@@ -0,0 +1,478 @@
+#include <fcntl.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "tokfile.h"
+
+#define HEADER_SIZE 8
+#define TRAILER_SIZE 12
+#define SECTION_END 0x0F
+#define LINE_ESCAPE 7      // Head bits 4-6: the line delta follows as a varint
+#define RECORD_MAX 48      // Longest encoded record
+#define WRITE_CHUNK 16384  // Records are encoded into a chunk, then written at once
+
+// --- Encoding ---
+static unsigned char* putVarint(unsigned char* p, uint64_t v)
+{
+    while (v >= 0x80)
+    {
+        *p++ = (unsigned char)(v | 0x80);
+        v >>= 7;
+    }
+    *p++ = (unsigned char)v;
+    return p;
+}
+
+// Zigzag: small negative and positive numbers both become small varints
+static unsigned char* putSigned(unsigned char* p, int64_t v)
+{
+    return putVarint(p, ((uint64_t)v << 1) ^ (uint64_t)(v >> 63));
+}
+
+static void putLE(unsigned char* p, uint64_t v, int bytes)
+{
+    for (int i = 0; i < bytes; i++)
+    {
+        p[i] = (unsigned char)(v >> (8 * i));
+    }
+}
+
+static void emit(TokenWriter* w, const void* bytes, size_t len)
+{
+    if (len > 0 && fwrite(bytes, 1, len, w->out) != len)
+    {
+        w->failed = 1;
+    }
+    w->written += len;
+}
+
+// --- Writer ---
+void initTokenWriter(TokenWriter* w, FILE* out, int flags)
+{
+    memset(w, 0, sizeof(*w));
+    w->out = out;
+    w->flags = flags;
+}
+
+void writeTokenHeader(TokenWriter* w)
+{
+    unsigned char header[HEADER_SIZE] = { 'L', 'X', 'T', 'K' };
+    putLE(header + 4, TOKFILE_VERSION, 2);
+    putLE(header + 6, (uint64_t)w->flags, 2);
+    emit(w, header, sizeof(header));
+}
+
+void beginTokenSection(TokenWriter* w, const char* name)
+{
+    unsigned char len[10];
+    size_t nameLen = strlen(name);
+    emit(w, len, (size_t)(putVarint(len, nameLen) - len));
+    emit(w, name, nameLen + 1);
+    w->prevEnd = 0;
+    w->prevLine = 1;
+}
+
+void writeTokens(TokenWriter* w, const TokenBatch* batch, size_t count)
+{
+    unsigned char chunk[WRITE_CHUNK];
+    unsigned char* p = chunk;
+    int symbols = (w->flags & TOKFILE_SYMBOLS) != 0;
+    for (size_t i = 0; i < count; i++)
+    {
+        if (p > chunk + WRITE_CHUNK - RECORD_MAX)
+        {
+            emit(w, chunk, (size_t)(p - chunk));
+            p = chunk;
+        }
+        TokenType type = batch->type[i];
+        int64_t lineDelta = (int64_t)batch->line[i] - w->prevLine;
+        if (lineDelta >= 0 && lineDelta < LINE_ESCAPE)
+        {
+            *p++ = (unsigned char)(type | (lineDelta << 4));
+        }
+        else
+        {
+            *p++ = (unsigned char)(type | (LINE_ESCAPE << 4));
+            p = putSigned(p, lineDelta);
+        }
+        p = putSigned(p, (int64_t)(batch->start[i] - w->prevEnd));
+        p = putVarint(p, batch->length[i]);
+        if (type == KEYWORD)
+        {
+            p = putVarint(p, (uint64_t)batch->keyword[i]);
+        }
+        else if (type == IDENTIFIER && symbols)
+        {
+            p = putVarint(p, batch->symbol[i]);
+        }
+        w->prevEnd = batch->start[i] + batch->length[i];
+        w->prevLine = batch->line[i];
+    }
+    emit(w, chunk, (size_t)(p - chunk));
+}
+
+void endTokenSection(TokenWriter* w)
+{
+    unsigned char end = SECTION_END;
+    emit(w, &end, 1);
+}
+
+// Length of the varint at p, which ends by 'end'
+static inline size_t varintLength(const unsigned char* p, const unsigned char* end)
+{
+    if (p < end && p[0] < 0x80)
+    {
+        return 1; // Most are
+    }
+    size_t n = 0;
+    while (p + n < end && (p[n] & 0x80))
+    {
+        n++;
+    }
+    return (p + n < end) ? n + 1 : n;
+}
+
+static uint64_t varintValue(const unsigned char* p, size_t n)
+{
+    uint64_t v = 0;
+    for (size_t i = 0; i < n && i < 10; i++)
+    {
+        v |= (uint64_t)(p[i] & 0x7F) << (7 * i);
+    }
+    return v;
+}
+
+void writeTokenBytes(TokenWriter* w, const void* bytes, size_t len, const uint32_t* symbolMap)
+{
+    if (symbolMap == NULL || !(w->flags & TOKFILE_SYMBOLS))
+    {
+        emit(w, bytes, len);
+        return;
+    }
+    // Only the symbol ids change: each goes into a chunk after the bytes
+    // since the one before, which are copied as they are
+    unsigned char chunk[WRITE_CHUNK];
+    unsigned char* out = chunk;
+    const unsigned char* p = bytes;
+    const unsigned char* end = p + len;
+    const unsigned char* copied = p; // Start of the bytes not in the chunk yet
+    int inSection = 0;
+    while (p < end)
+    {
+        if (!inSection)
+        {
+            size_t n = varintLength(p, end);
+            uint64_t nameLen = varintValue(p, n) + 1;
+            p += n;
+            p += (nameLen < (uint64_t)(end - p)) ? (size_t)nameLen : (size_t)(end - p);
+            inSection = 1;
+            continue;
+        }
+        unsigned head = *p++;
+        if (head == SECTION_END)
+        {
+            inSection = 0;
+            continue;
+        }
+        TokenType type = (TokenType)(head & 0x0F);
+        if (((head >> 4) & 7) == LINE_ESCAPE)
+        {
+            p += varintLength(p, end);
+        }
+        p += varintLength(p, end); // Gap
+        p += varintLength(p, end); // Length
+        size_t idLen = (type == KEYWORD || type == IDENTIFIER) ? varintLength(p, end) : 0;
+        if (type == IDENTIFIER)
+        {
+            size_t run = (size_t)(p - copied);
+            if (run + RECORD_MAX > (size_t)(chunk + WRITE_CHUNK - out))
+            {
+                emit(w, chunk, (size_t)(out - chunk));
+                out = chunk;
+                if (run + RECORD_MAX > WRITE_CHUNK)
+                {
+                    emit(w, copied, run); // A long section name
+                    run = 0;
+                }
+            }
+            memcpy(out, p - run, run);
+            out = putVarint(out + run, symbolMap[varintValue(p, idLen)]);
+            copied = p + idLen;
+        }
+        p += idLen;
+    }
+    emit(w, chunk, (size_t)(out - chunk));
+    emit(w, copied, (size_t)(end - copied));
+}
+
+int finishTokenWriter(TokenWriter* w, Interner* symbols)
+{
+    uint64_t tableOffset = 0;
+    if ((w->flags & TOKFILE_SYMBOLS) && symbols != NULL)
+    {
+        tableOffset = w->written;
+        uint32_t count = internerCount(symbols);
+        unsigned char word[8];
+        putLE(word, count, 4);
+        emit(w, word, 4);
+        uint64_t off = 0;
+        putLE(word, off, 8);
+        emit(w, word, 8);
+        for (uint32_t id = 1; id <= count; id++)
+        {
+            size_t len = 0;
+            internedString(symbols, id, &len);
+            off += len + 1;
+            putLE(word, off, 8);
+            emit(w, word, 8);
+        }
+        for (uint32_t id = 1; id <= count; id++)
+        {
+            size_t len = 0;
+            const char* name = internedString(symbols, id, &len);
+            emit(w, name, len + 1);
+        }
+    }
+    unsigned char trailer[TRAILER_SIZE] = { 0 };
+    putLE(trailer, tableOffset, 8);
+    memcpy(trailer + 8, "LXTE", 4);
+    emit(w, trailer, sizeof(trailer));
+    if (fflush(w->out) != 0)
+    {
+        w->failed = 1;
+    }
+    return !w->failed;
+}
+
+// --- Reader ---
+struct TokenFile {
+    const unsigned char* data;
+    size_t size;
+    int mapped;                    // 'data' is a mapping of our own
+    int flags;
+    const unsigned char* body;     // First section
+    const unsigned char* bodyEnd;  // End of the sections
+    uint32_t symbolCount;
+    const unsigned char* offsets;  // symbolCount + 1 u64 offsets into 'names'
+    const char* names;
+};
+
+static uint64_t getLE(const unsigned char* p, int bytes)
+{
+    uint64_t v = 0;
+    for (int i = bytes - 1; i >= 0; i--)
+    {
+        v = (v << 8) | p[i];
+    }
+    return v;
+}
+
+TokenFile* openTokenFile(const char* path)
+{
+    int fd = open(path, O_RDONLY);
+    if (fd < 0)
+    {
+        return NULL;
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size < HEADER_SIZE + TRAILER_SIZE)
+    {
+        close(fd);
+        return NULL;
+    }
+    size_t size = (size_t)st.st_size;
+    void* map = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED)
+    {
+        return NULL;
+    }
+    TokenFile* tf = readTokenFile(map, size);
+    if (tf == NULL)
+    {
+        munmap(map, size);
+        return NULL;
+    }
+    tf->mapped = 1;
+    return tf;
+}
+
+TokenFile* readTokenFile(const void* bytes, size_t size)
+{
+    if (size < HEADER_SIZE + TRAILER_SIZE)
+    {
+        return NULL;
+    }
+    const unsigned char* data = bytes;
+    const unsigned char* trailer = data + size - TRAILER_SIZE;
+    uint64_t tableOffset = getLE(trailer, 8);
+    TokenFile* tf = calloc(1, sizeof(TokenFile));
+    if (tf == NULL || memcmp(data, "LXTK", 4) != 0 || getLE(data + 4, 2) != TOKFILE_VERSION ||
+        memcmp(trailer + 8, "LXTE", 4) != 0 || tableOffset > size - TRAILER_SIZE)
+    {
+        free(tf);
+        return NULL;
+    }
+    tf->data = data;
+    tf->size = size;
+    tf->flags = (int)getLE(data + 6, 2);
+    tf->body = data + HEADER_SIZE;
+    tf->bodyEnd = trailer;
+    if (tableOffset != 0)
+    {
+        // Check that the offsets and the text they point to are in the file
+        const unsigned char* table = data + tableOffset;
+        size_t room = (size_t)(trailer - table);
+        uint64_t count = (room >= 4) ? getLE(table, 4) : 0;
+        if (tableOffset < HEADER_SIZE || room < 4 || (room - 4) / 8 < count + 1 ||
+            getLE(table + 4 + 8 * count, 8) > room - 4 - 8 * (count + 1))
+        {
+            free(tf);
+            return NULL;
+        }
+        tf->bodyEnd = table;
+        tf->symbolCount = (uint32_t)count;
+        tf->offsets = table + 4;
+        tf->names = (const char*)(tf->offsets + 8 * (count + 1));
+    }
+    return tf;
+}
+
+void closeTokenFile(TokenFile* tf)
+{
+    if (tf != NULL)
+    {
+        if (tf->mapped)
+        {
+            munmap((void*)tf->data, tf->size);
+        }
+        free(tf);
+    }
+}
+
+int tokenFileFlags(const TokenFile* tf)
+{
+    return tf->flags;
+}
+
+uint32_t tokenFileSymbolCount(const TokenFile* tf)
+{
+    return tf->symbolCount;
+}
+
+const char* tokenFileSymbol(const TokenFile* tf, uint32_t id, size_t* len)
+{
+    if (id == NO_SYMBOL || id > tf->symbolCount)
+    {
+        return NULL;
+    }
+    uint64_t from = getLE(tf->offsets + 8 * (id - 1), 8);
+    uint64_t to = getLE(tf->offsets + 8 * id, 8);
+    if (from >= to || to > getLE(tf->offsets + 8 * tf->symbolCount, 8) || tf->names[to - 1] != '\0')
+    {
+        return NULL; // Offsets out of order: a damaged table
+    }
+    if (len != NULL)
+    {
+        *len = (size_t)(to - from - 1);
+    }
+    return tf->names + from;
+}
+
+// Decoders stop at the end of the sections and mark the cursor corrupt
+static uint64_t getVarint(TokenCursor* c)
+{
+    uint64_t v = 0;
+    for (int shift = 0; shift < 64; shift += 7)
+    {
+        if (c->pos >= c->file->bodyEnd)
+        {
+            break;
+        }
+        unsigned char b = *c->pos++;
+        v |= (uint64_t)(b & 0x7F) << shift;
+        if (b < 0x80)
+        {
+            return v;
+        }
+    }
+    c->corrupt = 1;
+    return 0;
+}
+
+static int64_t getSigned(TokenCursor* c)
+{
+    uint64_t v = getVarint(c);
+    return (int64_t)(v >> 1) ^ -(int64_t)(v & 1);
+}
+
+void startTokenCursor(const TokenFile* tf, TokenCursor* c)
+{
+    memset(c, 0, sizeof(*c));
+    c->file = tf;
+    c->pos = tf->body;
+}
+
+int nextTokenSection(TokenCursor* c)
+{
+    FileToken skipped;
+    while (c->inSection && readFileToken(c, &skipped))
+    {
+    }
+    if (c->corrupt || c->pos >= c->file->bodyEnd)
+    {
+        return 0;
+    }
+    uint64_t nameLen = getVarint(c);
+    if (c->corrupt || nameLen >= (uint64_t)(c->file->bodyEnd - c->pos) || c->pos[nameLen] != '\0')
+    {
+        c->corrupt = 1;
+        return 0;
+    }
+    c->name = (const char*)c->pos;
+    c->pos += nameLen + 1;
+    c->prevEnd = 0;
+    c->prevLine = 1;
+    c->inSection = 1;
+    return 1;
+}
+
+int readFileToken(TokenCursor* c, FileToken* t)
+{
+    if (!c->inSection || c->corrupt)
+    {
+        return 0;
+    }
+    if (c->pos >= c->file->bodyEnd)
+    {
+        c->corrupt = 1;
+        return 0;
+    }
+    unsigned char head = *c->pos++;
+    if (head == SECTION_END)
+    {
+        c->inSection = 0;
+        return 0;
+    }
+    int lineDelta = head >> 4;
+    if (lineDelta == LINE_ESCAPE)
+    {
+        lineDelta = (int)getSigned(c);
+    }
+    t->type = (TokenType)(head & 0x0F);
+    t->line = c->prevLine + lineDelta;
+    t->start = c->prevEnd + (size_t)getSigned(c);
+    t->length = (size_t)getVarint(c);
+    t->keyword = (t->type == KEYWORD) ? (KeywordId)getVarint(c) : KW_NONE;
+    t->symbol = (t->type == IDENTIFIER && (c->file->flags & TOKFILE_SYMBOLS)) ? (uint32_t)getVarint(c) : NO_SYMBOL;
+    if (c->corrupt || (head & 0x80) || t->type > UNKNOWN)
+    {
+        c->corrupt = 1;
+        return 0;
+    }
+    c->prevEnd = t->start + t->length;
+    c->prevLine = t->line;
+    return 1;
+}
@@ -0,0 +1,93 @@
+#ifndef TOKFILE_H
+#define TOKFILE_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include "lexer.h"
+
+// Binary token stream (--emit=bin), so a later stage can read tokens
+// without re-parsing the text listing. All integers are little-endian.
+//
+//   header   "LXTK", u16 version, u16 flags
+//   sections one per source file:
+//              varint name length, name bytes, NUL
+//              records, then the byte 0x0F
+//   table    (TOKFILE_SYMBOLS only) u32 count, then count + 1 u64 offsets
+//              into the text that follows; name i is text[off[i - 1], off[i])
+//              minus its NUL terminator
+//   trailer  u64 offset of the table (0 if none), "LXTE"
+//
+// A record is a head byte, low nibble the TokenType and bits 4-6 the line
+// delta (7: a zigzag varint delta follows), then a zigzag varint gap from
+// the previous token's end, a varint length, the varint KeywordId of a
+// KEYWORD and, with TOKFILE_SYMBOLS, the varint symbol id of an IDENTIFIER.
+
+#define TOKFILE_VERSION 3 // 2: FLOATING_CONSTANT added before UNKNOWN; 3: DIRECTIVE
+#define TOKFILE_SYMBOLS 1 // Flag: identifiers carry symbol ids and the table is present
+
+// --- Writer: streams records to a FILE, which may be a pipe ---
+typedef struct {
+    FILE* out;
+    int flags;
+    uint64_t written; // Bytes written so far, for the trailer
+    size_t prevEnd;   // End of the previous token in this section
+    int prevLine;
+    int failed;       // A write failed
+} TokenWriter;
+
+void initTokenWriter(TokenWriter* w, FILE* out, int flags);
+void writeTokenHeader(TokenWriter* w);
+void beginTokenSection(TokenWriter* w, const char* name);
+// Append 'count' tokens from a batch filled by nextTokens(); the batch needs
+// 'keyword' and, with TOKFILE_SYMBOLS, 'symbol' as well as 'line'
+void writeTokens(TokenWriter* w, const TokenBatch* batch, size_t count);
+void endTokenSection(TokenWriter* w);
+// Copy sections that another writer encoded (e.g. into memory) through w.
+// With TOKFILE_SYMBOLS and a 'symbolMap', each symbol id becomes
+// symbolMap[id], for sections written with an interner of their own.
+void writeTokenBytes(TokenWriter* w, const void* bytes, size_t len, const uint32_t* symbolMap);
+// Write the string table of 'symbols' (with TOKFILE_SYMBOLS) and the trailer.
+// Returns 0 if any write failed.
+int finishTokenWriter(TokenWriter* w, Interner* symbols);
+
+// --- Reader: maps a token file and decodes it in place ---
+typedef struct TokenFile TokenFile;
+
+typedef struct {
+    TokenType type;
+    KeywordId keyword; // KW_NONE except for KEYWORD tokens
+    uint32_t symbol;   // NO_SYMBOL unless the file has TOKFILE_SYMBOLS
+    size_t start;      // Byte offset in the source file
+    size_t length;
+    int line;
+} FileToken;
+
+// Position in a token file. 'name' points into the mapping.
+typedef struct {
+    const TokenFile* file;
+    const unsigned char* pos;
+    const char* name;  // Source file of the current section (NUL-terminated)
+    size_t prevEnd;
+    int prevLine;
+    int inSection;
+    int corrupt;       // Set when decoding ran off the data
+} TokenCursor;
+
+// NULL if the file cannot be mapped or is not a token file of this version
+TokenFile* openTokenFile(const char* path);
+// The same for a token file already in memory, which must outlive the result
+TokenFile* readTokenFile(const void* data, size_t size);
+void closeTokenFile(TokenFile* tf);
+int tokenFileFlags(const TokenFile* tf);
+// Name of symbol 'id' straight from the mapping, or NULL for an unknown id
+const char* tokenFileSymbol(const TokenFile* tf, uint32_t id, size_t* len);
+uint32_t tokenFileSymbolCount(const TokenFile* tf);
+
+void startTokenCursor(const TokenFile* tf, TokenCursor* c);
+// Move to the next section; 0 at the end of the file
+int nextTokenSection(TokenCursor* c);
+// Decode the next token of the current section; 0 at its end
+int readFileToken(TokenCursor* c, FileToken* t);
+
+#endif
@@ -0,0 +1,618 @@
+/* Throughput benchmark for the lexer.
+
+   Generates reproducible synthetic C corpora (the same seed and size give
+   the same bytes), lexes each one through several APIs and skip-kernel
+   backends, and reports MB/s, tokens/s, ns/token and peak RSS. Every run
+   is also appended to a results file as one JSON object per line, so
+   results can be diffed or plotted to catch regressions.
+
+   Mixes weight four kinds of code: identifier-heavy declarations and
+   calls, comments, string and character literals, and numeric constants.
+   "mixed" blends all four; --weights I,C,L,N sets a custom blend.
+
+   APIs: "legacy" is initializeLexer() / getNextToken(), "token" is
+   createLexer() / nextToken(), "batch" is nextTokens() with 4096-entry
+   arrays and "peek" is peekToken() / consumeToken() on the lookahead ring.
+   Backends are the LEXER_SIMD kernel sets (scalar, sse2, avx2).
+
+       gcc -O2 tools/bench.c lexer.c lexer_simd.c keywords.c pool.c interner.c \
+           lexer_split.c lexer_incr.c lexer_stats.c lexer_dfa.c lexer_diag.c lexer_value.c \
+           tokfile.c tokcache.c lexer_lines.c lexer_lookahead.c lexer_utf8.c lexer_xid.c arena.c -o bench -pthread
+       ./bench --size 64 --mix all --api all --backend all --out bench.jsonl
+*/
+#define _GNU_SOURCE
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/resource.h>
+#include "../lexer.h"
+
+#define BATCH_SIZE 4096
+#define MAX_RUNS 8 // Entries in each of the --mix / --api / --backend lists
+
+// --- Reproducible random numbers (xorshift64*) ---
+static uint64_t rngState;
+
+static uint32_t rnd(uint32_t n)
+{
+    rngState ^= rngState >> 12;
+    rngState ^= rngState << 25;
+    rngState ^= rngState >> 27;
+    return (uint32_t)((rngState * 0x2545F4914F6CDD1DULL) >> 32) % n;
+}
+
+// --- Corpus generator ---
+typedef struct {
+    char* data;
+    size_t len, cap;
+} Text;
+
+static void add(Text* t, const char* s, size_t n)
+{
+    if (t->len + n > t->cap)
+    {
+        size_t cap = (t->cap > 0) ? t->cap * 2 : 1 << 20;
+        while (cap < t->len + n)
+        {
+            cap *= 2;
+        }
+        t->data = realloc(t->data, cap);
+        if (t->data == NULL)
+        {
+            fprintf(stderr, "bench: out of memory\n");
+            exit(EXIT_FAILURE);
+        }
+        t->cap = cap;
+    }
+    memcpy(t->data + t->len, s, n);
+    t->len += n;
+}
+
+static void addf(Text* t, const char* fmt, ...) __attribute__((format(printf, 2, 3)));
+static void addf(Text* t, const char* fmt, ...)
+{
+    char line[512];
+    va_list ap;
+    va_start(ap, fmt);
+    int n = vsnprintf(line, sizeof(line), fmt, ap);
+    va_end(ap);
+    add(t, line, (n < (int)sizeof(line)) ? (size_t)n : sizeof(line) - 1);
+}
+
+static const char* const words[] = {
+    "count", "buffer", "index", "node", "value", "result", "length", "state",
+    "next", "prev", "table", "entry", "offset", "cursor", "limit", "flags",
+};
+static const char* const types[] = { "int", "long", "char*", "size_t", "unsigned", "Node*" };
+static const char* const ops[] = { "+", "-", "*", "&", "|", "^", "<<", ">>" };
+static const char* const compares[] = { "<", "<=", ">", ">=", "==", "!=" };
+
+// An identifier such as "node_index3" or "tableCursor"
+static void addName(Text* t)
+{
+    const char* a = words[rnd(16)];
+    const char* b = words[rnd(16)];
+    switch (rnd(3))
+    {
+        case 0:
+            addf(t, "%s_%s%u", a, b, rnd(10));
+            break;
+        case 1:
+            addf(t, "%s%c%s", a, b[0] - 'a' + 'A', b + 1);
+            break;
+        default:
+            addf(t, "%s", a);
+            break;
+    }
+}
+
+static void identifierStatement(Text* t)
+{
+    add(t, "    ", 4);
+    switch (rnd(3))
+    {
+        case 0:
+            addf(t, "%s ", types[rnd(6)]);
+            addName(t);
+            add(t, " = ", 3);
+            addName(t);
+            addf(t, " %s ", ops[rnd(8)]);
+            addName(t);
+            add(t, ";\n", 2);
+            break;
+        case 1:
+            addName(t);
+            add(t, "(", 1);
+            addName(t);
+            add(t, ", ", 2);
+            addName(t);
+            add(t, "->", 2);
+            addName(t);
+            add(t, ");\n", 3);
+            break;
+        default:
+            add(t, "if (", 4);
+            addName(t);
+            addf(t, " %s ", compares[rnd(6)]);
+            addName(t);
+            add(t, ") { ", 4);
+            addName(t);
+            add(t, "++; }\n", 6);
+            break;
+    }
+}
+
+static void commentStatement(Text* t)
+{
+    if (rnd(2) == 0)
+    {
+        add(t, "    // ", 7);
+        for (uint32_t i = 3 + rnd(10); i > 0; i--)
+        {
+            addf(t, "%s ", words[rnd(16)]);
+        }
+        add(t, "\n", 1);
+        return;
+    }
+    add(t, "    /* ", 7);
+    for (uint32_t line = 1 + rnd(4); line > 0; line--)
+    {
+        for (uint32_t i = 4 + rnd(8); i > 0; i--)
+        {
+            addf(t, "%s ", words[rnd(16)]);
+        }
+        add(t, "\n     * ", 8);
+    }
+    add(t, "*/\n", 3);
+}
+
+static void literalStatement(Text* t)
+{
+    static const char* const escapes[] = { "\\n", "\\t", "\\\"", "\\\\", "%d", "%s" };
+    static const char* const chars[] = { "'a'", "'\\n'", "'\\''", "'\\\\'", "'0'", "'\\0'" };
+    if (rnd(4) == 0)
+    {
+        addf(t, "    c = %s;\n", chars[rnd(6)]);
+        return;
+    }
+    add(t, "    puts(\"", 10);
+    for (uint32_t i = 2 + rnd(8); i > 0; i--)
+    {
+        addf(t, "%s %s", words[rnd(16)], (rnd(3) == 0) ? escapes[rnd(6)] : "");
+    }
+    add(t, "\");\n", 4);
+}
+
+static void addNumber(Text* t)
+{
+    switch (rnd(4))
+    {
+        case 0:
+            addf(t, "%u", rnd(1000000));
+            break;
+        case 1:
+            addf(t, "0x%X", rnd(0x7FFFFFFF));
+            break;
+        case 2:
+            addf(t, "0%o", rnd(4096) + 1);
+            break;
+        default:
+        {
+            add(t, "0b1", 3);
+            for (uint32_t i = rnd(16); i > 0; i--)
+            {
+                add(t, rnd(2) ? "1" : "0", 1);
+            }
+            break;
+        }
+    }
+}
+
+static void numericStatement(Text* t)
+{
+    add(t, "    x = ", 8);
+    for (uint32_t i = 1 + rnd(4); i > 0; i--)
+    {
+        addNumber(t);
+        addf(t, " %s ", ops[rnd(8)]);
+    }
+    addNumber(t);
+    add(t, ";\n", 2);
+}
+
+typedef struct {
+    const char* name;
+    uint32_t weight[4]; // Identifier, comment, literal, numeric statements
+} Mix;
+
+static const Mix mixes[] = {
+    { "mixed",   { 4, 2, 2, 2 } },
+    { "ident",   { 12, 1, 1, 1 } },
+    { "comment", { 1, 12, 1, 1 } },
+    { "literal", { 1, 1, 12, 1 } },
+    { "numeric", { 1, 1, 1, 12 } },
+};
+#define NMIXES (sizeof(mixes) / sizeof(mixes[0]))
+
+// Whole functions of weighted random statements until 'size' bytes
+static void generateCorpus(Text* t, const Mix* mix, size_t size, uint64_t seed)
+{
+    rngState = seed * 0x9E3779B97F4A7C15ULL + 1;
+    uint32_t total = mix->weight[0] + mix->weight[1] + mix->weight[2] + mix->weight[3];
+    t->len = 0;
+    for (uint32_t fn = 0; t->len < size; fn++)
+    {
+        addf(t, "static long fn%u(long a, Node* node)\n{\n    long x = a;\n    char c = 0;\n", fn);
+        for (uint32_t i = 8 + rnd(24); i > 0; i--)
+        {
+            uint32_t pick = rnd(total);
+            int kind = 0;
+            while (pick >= mix->weight[kind])
+            {
+                pick -= mix->weight[kind++];
+            }
+            switch (kind)
+            {
+                case 0: identifierStatement(t); break;
+                case 1: commentStatement(t); break;
+                case 2: literalStatement(t); break;
+                default: numericStatement(t); break;
+            }
+        }
+        add(t, "    return x + c;\n}\n\n", 21);
+    }
+}
+
+// --- Measurement ---
+static double now()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+// Reset the peak RSS so each run reports its own (Linux 4.0+); returns 0
+// when that is not possible and the peak is the process-wide one
+static int resetPeakRss()
+{
+    FILE* f = fopen("/proc/self/clear_refs", "w");
+    if (f == NULL)
+    {
+        return 0;
+    }
+    int ok = fputs("5", f) >= 0;
+    return (fclose(f) == 0) && ok;
+}
+
+static long peakRssKb()
+{
+    FILE* f = fopen("/proc/self/status", "r");
+    char line[256];
+    long kb = -1;
+    while (f != NULL && fgets(line, sizeof(line), f) != NULL)
+    {
+        if (strncmp(line, "VmHWM:", 6) == 0)
+        {
+            kb = atol(line + 6);
+        }
+    }
+    if (f != NULL)
+    {
+        fclose(f);
+    }
+    if (kb < 0)
+    {
+        struct rusage ru;
+        getrusage(RUSAGE_SELF, &ru);
+        kb = ru.ru_maxrss;
+    }
+    return kb;
+}
+
+static size_t lexLegacy(const char* path)
+{
+    size_t tokens = 0;
+    initializeLexer(path);
+    for (;;)
+    {
+        Token t = getNextToken();
+        if (t.type == UNKNOWN && t.length == 0)
+        {
+            break;
+        }
+        tokens++;
+    }
+    closeLexer();
+    return tokens;
+}
+
+static size_t lexToken(const char* path)
+{
+    size_t tokens = 0;
+    LexerState* lx = createLexer(path);
+    if (lx == NULL)
+    {
+        return 0;
+    }
+    for (;;)
+    {
+        Token t = nextToken(lx);
+        if (t.type == UNKNOWN && t.length == 0)
+        {
+            break;
+        }
+        tokens++;
+    }
+    destroyLexer(lx);
+    return tokens;
+}
+
+static size_t lexBatch(const char* path)
+{
+    static TokenType type[BATCH_SIZE];
+    static size_t start[BATCH_SIZE];
+    static size_t length[BATCH_SIZE];
+    static int line[BATCH_SIZE];
+    TokenBatch batch = { .type = type, .start = start, .length = length, .line = line, .capacity = BATCH_SIZE };
+    size_t tokens = 0, count;
+    LexerState* lx = createLexer(path);
+    if (lx == NULL)
+    {
+        return 0;
+    }
+    while ((count = nextTokens(lx, &batch)) > 0)
+    {
+        tokens += count;
+    }
+    destroyLexer(lx);
+    return tokens;
+}
+
+static size_t lexPeek(const char* path)
+{
+    size_t tokens = 0;
+    LexerState* lx = createLexer(path);
+    if (lx == NULL)
+    {
+        return 0;
+    }
+    for (;;)
+    {
+        const Token* t = peekToken(lx, 0);
+        if (t == NULL)
+        {
+            fprintf(stderr, "bench: out of memory\n");
+            exit(EXIT_FAILURE);
+        }
+        if (t->type == UNKNOWN && t->length == 0)
+        {
+            break;
+        }
+        consumeToken(lx);
+        tokens++;
+    }
+    destroyLexer(lx);
+    return tokens;
+}
+
+typedef struct {
+    const char* name;
+    size_t (*run)(const char* path);
+} Api;
+
+static const Api apis[] = {
+    { "legacy", lexLegacy },
+    { "token", lexToken },
+    { "batch", lexBatch },
+    { "peek", lexPeek },
+};
+#define NAPIS (sizeof(apis) / sizeof(apis[0]))
+
+static const char* const backends[] = { "scalar", "sse2", "avx2" };
+#define NBACKENDS (sizeof(backends) / sizeof(backends[0]))
+
+// --- Command line ---
+// Split a comma-separated list into 'out'; "all" selects every one of 'names'
+static int parseList(char* arg, const char* const* names, size_t count, const char** out)
+{
+    int n = 0;
+    if (strcmp(arg, "all") == 0)
+    {
+        for (size_t i = 0; i < count && n < MAX_RUNS; i++)
+        {
+            out[n++] = names[i];
+        }
+        return n;
+    }
+    for (char* item = strtok(arg, ","); item != NULL && n < MAX_RUNS; item = strtok(NULL, ","))
+    {
+        size_t i = 0;
+        while (i < count && strcmp(item, names[i]) != 0)
+        {
+            i++;
+        }
+        if (i == count)
+        {
+            fprintf(stderr, "bench: unknown name '%s'\n", item);
+            exit(EXIT_FAILURE);
+        }
+        out[n++] = names[i];
+    }
+    return n;
+}
+
+static void usage(const char* prog)
+{
+    fprintf(stderr, "Usage: %s [--size MB] [--seed N] [--reps N] [--mix LIST] [--weights I,C,L,N]\n", prog);
+    fprintf(stderr, "          [--api LIST] [--backend LIST] [--out FILE] [--keep DIR]\n");
+    fprintf(stderr, "  --mix     mixed,ident,comment,literal,numeric or all (default: mixed)\n");
+    fprintf(stderr, "  --api     legacy,token,batch,peek or all (default: all)\n");
+    fprintf(stderr, "  --backend scalar,sse2,avx2 or all (default: the CPU's best)\n");
+    fprintf(stderr, "  --out     results file, one JSON object per run (default: bench_results.jsonl)\n");
+    fprintf(stderr, "  --keep    write the corpora to DIR and leave them there\n");
+}
+
+int main(int argc, char* argv[])
+{
+    double sizeMb = 16;
+    uint64_t seed = 1;
+    int reps = 3;
+    const char* outPath = "bench_results.jsonl";
+    const char* keepDir = NULL;
+    const char* mixNames[NMIXES];
+    for (size_t i = 0; i < NMIXES; i++)
+    {
+        mixNames[i] = mixes[i].name;
+    }
+    const char* apiNames[NAPIS];
+    for (size_t i = 0; i < NAPIS; i++)
+    {
+        apiNames[i] = apis[i].name;
+    }
+    const char* useMix[MAX_RUNS] = { "mixed" };
+    const char* useApi[MAX_RUNS] = { "legacy", "token", "batch", "peek" };
+    const char* useBackend[MAX_RUNS] = { NULL }; // NULL: leave LEXER_SIMD alone
+    int nMix = 1, nApi = 4, nBackend = 1;
+    Mix custom = { "custom", { 0, 0, 0, 0 } };
+
+    for (int i = 1; i < argc; i++)
+    {
+        const char* opt = argv[i];
+        char* val = (i + 1 < argc) ? argv[i + 1] : NULL;
+        if (val == NULL)
+        {
+            usage(argv[0]);
+            return 1;
+        }
+        i++;
+        if (strcmp(opt, "--size") == 0) sizeMb = atof(val);
+        else if (strcmp(opt, "--seed") == 0) seed = strtoull(val, NULL, 10);
+        else if (strcmp(opt, "--reps") == 0) reps = atoi(val);
+        else if (strcmp(opt, "--out") == 0) outPath = val;
+        else if (strcmp(opt, "--keep") == 0) keepDir = val;
+        else if (strcmp(opt, "--mix") == 0) nMix = parseList(val, mixNames, NMIXES, useMix);
+        else if (strcmp(opt, "--api") == 0) nApi = parseList(val, apiNames, NAPIS, useApi);
+        else if (strcmp(opt, "--backend") == 0) nBackend = parseList(val, backends, NBACKENDS, useBackend);
+        else if (strcmp(opt, "--weights") == 0 &&
+                 sscanf(val, "%u,%u,%u,%u", &custom.weight[0], &custom.weight[1], &custom.weight[2], &custom.weight[3]) == 4 &&
+                 custom.weight[0] + custom.weight[1] + custom.weight[2] + custom.weight[3] > 0)
+        {
+            useMix[0] = custom.name;
+            nMix = 1;
+        }
+        else
+        {
+            usage(argv[0]);
+            return 1;
+        }
+    }
+    if (sizeMb <= 0 || reps < 1)
+    {
+        usage(argv[0]);
+        return 1;
+    }
+
+    FILE* results = fopen(outPath, "a");
+    if (results == NULL)
+    {
+        fprintf(stderr, "bench: cannot open '%s'\n", outPath);
+        return 1;
+    }
+    setLexerBanners(0); // Keep the legacy API quiet
+
+    printf("%-8s %-7s %-7s %9s %10s %12s %9s %10s\n", "mix", "api", "backend", "MB", "MB/s", "tokens/s", "ns/token", "peak KB");
+    int status = 0;
+    for (int m = 0; m < nMix; m++)
+    {
+        const Mix* mix = &custom;
+        for (size_t i = 0; i < NMIXES; i++)
+        {
+            if (strcmp(useMix[m], mixes[i].name) == 0)
+            {
+                mix = &mixes[i];
+            }
+        }
+
+        // Generate the corpus into a file: every API lexes from a path
+        Text corpus = { 0 };
+        generateCorpus(&corpus, mix, (size_t)(sizeMb * 1024 * 1024), seed);
+        char path[4096];
+        if (keepDir != NULL)
+        {
+            snprintf(path, sizeof(path), "%s/bench_%s_%llu.c", keepDir, mix->name, (unsigned long long)seed);
+        }
+        else
+        {
+            snprintf(path, sizeof(path), "%s/lexer_bench_%d_%s.c", getenv("TMPDIR") ? getenv("TMPDIR") : "/tmp", (int)getpid(), mix->name);
+        }
+        FILE* f = fopen(path, "wb");
+        if (f == NULL || fwrite(corpus.data, 1, corpus.len, f) != corpus.len || fclose(f) != 0)
+        {
+            fprintf(stderr, "bench: cannot write '%s'\n", path);
+            return 1;
+        }
+        size_t bytes = corpus.len;
+        free(corpus.data);
+
+        size_t expected = 0;
+        for (int b = 0; b < nBackend; b++)
+        {
+            if (useBackend[b] != NULL)
+            {
+                setenv("LEXER_SIMD", useBackend[b], 1); // Read by every createLexer()
+            }
+            for (int a = 0; a < nApi; a++)
+            {
+                const Api* api = &apis[0];
+                for (size_t i = 0; i < NAPIS; i++)
+                {
+                    if (strcmp(useApi[a], apis[i].name) == 0)
+                    {
+                        api = &apis[i];
+                    }
+                }
+                // Best of 'reps' runs; the first run also warms the page cache
+                double best = 0;
+                size_t tokens = 0;
+                int ownPeak = resetPeakRss();
+                for (int r = 0; r < reps; r++)
+                {
+                    double start = now();
+                    tokens = api->run(path);
+                    double t = now() - start;
+                    best = (r == 0 || t < best) ? t : best;
+                }
+                long peak = peakRssKb();
+                if (expected == 0)
+                {
+                    expected = tokens;
+                }
+                else if (tokens != expected)
+                {
+                    fprintf(stderr, "bench: %s/%s produced %zu tokens, expected %zu\n", api->name, useBackend[b] ? useBackend[b] : "default", tokens, expected);
+                    status = 1;
+                }
+
+                const char* backend = useBackend[b] ? useBackend[b] : "default";
+                double mb = bytes / (1024.0 * 1024.0);
+                printf("%-8s %-7s %-7s %9.1f %10.1f %12.0f %9.2f %10ld\n", mix->name, api->name, backend,
+                       mb, mb / best, tokens / best, best * 1e9 / tokens, peak);
+                fprintf(results, "{\"mix\":\"%s\",\"api\":\"%s\",\"backend\":\"%s\",\"seed\":%llu,\"bytes\":%zu,"
+                        "\"tokens\":%zu,\"reps\":%d,\"seconds\":%.6f,\"mb_per_s\":%.2f,\"tokens_per_s\":%.0f,"
+                        "\"ns_per_token\":%.3f,\"peak_rss_kb\":%ld,\"peak_rss_scope\":\"%s\"}\n",
+                        mix->name, api->name, backend, (unsigned long long)seed, bytes, tokens, reps, best,
+                        mb / best, tokens / best, best * 1e9 / tokens, peak, ownPeak ? "run" : "process");
+            }
+        }
+        if (keepDir == NULL)
+        {
+            unlink(path);
+        }
+    }
+    fclose(results);
+    return status;
+}
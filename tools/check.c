@@ -0,0 +1,751 @@
+/* Differential checks for the lexer's library interfaces that the command
+   line does not exercise. Each check runs a fast path and a slow, plainly
+   right one on the same random input (reproducible from the seed) and
+   prints the first mismatches it finds:
+
+   incr     relexEdit() + applyTokenDelta() after random edits, against
+            lexText() of the edited text, in every dialect
+   integer  decodeIntegerConstant() on random constants of every base, with
+            and without suffixes and past 64 bits, against strtoull()
+   peek     peekToken() / consumeToken() / marks, against nextTokens()
+   tokfile  the --emit=bin writer and reader, round trip
+   includes translation units (--includes) of random files sharing random
+            headers, lexed in order on one thread against shuffled on four:
+            tokens and diagnostics, header ones included
+
+       gcc -O2 tools/check.c lexer.c lexer_simd.c keywords.c pool.c interner.c \
+           lexer_split.c lexer_incr.c lexer_stats.c lexer_dfa.c lexer_diag.c lexer_value.c \
+           tokfile.c tokcache.c lexer_lines.c lexer_lookahead.c lexer_utf8.c lexer_xid.c arena.c headers.c -o check -pthread
+       ./check [--seed N] [--rounds N] [incr|integer|peek|tokfile|includes]...
+
+   With no check named, all of them run. Exit status 1 on any mismatch.
+*/
+#define _GNU_SOURCE
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <unistd.h>
+#include "../headers.h"
+#include "../lexer.h"
+#include "../pool.h"
+#include "../tokfile.h"
+
+#define MAX_REPORTS 5 // Mismatches printed per check
+
+// --- Reproducible random numbers (xorshift64*) ---
+static uint64_t rngState;
+
+static uint32_t rnd(uint32_t n)
+{
+    rngState ^= rngState >> 12;
+    rngState ^= rngState << 25;
+    rngState ^= rngState >> 27;
+    return (uint32_t)((rngState * 0x2545F4914F6CDD1DULL) >> 32) % n;
+}
+
+static size_t mismatches;
+
+// Count a mismatch; nonzero if it is one of the first few, to be printed
+static int reportMismatch(void)
+{
+    return mismatches++ < MAX_REPORTS;
+}
+
+static void* checkedAlloc(void* p)
+{
+    if (p == NULL)
+    {
+        fprintf(stderr, "check: out of memory\n");
+        exit(EXIT_FAILURE);
+    }
+    return p;
+}
+
+static void need(int ok)
+{
+    checkedAlloc(ok ? "" : NULL);
+}
+
+// Text as "..." with C escapes, for reports
+static void printQuoted(const char* s, size_t n)
+{
+    putchar('"');
+    for (size_t i = 0; i < n; i++)
+    {
+        unsigned char c = (unsigned char)s[i];
+        if (c == '"' || c == '\\')
+        {
+            printf("\\%c", c);
+        }
+        else if (c >= 0x20 && c < 0x7F)
+        {
+            putchar(c);
+        }
+        else
+        {
+            printf("\\x%02x", c);
+        }
+    }
+    putchar('"');
+}
+
+// --- Random source text ---
+// Pieces chosen to sit next to each other in every way: the edge cases of
+// each scanner (numbers that stop short of an exponent, dots, comment and
+// literal delimiters, partial UTF-8) are single pieces.
+static const char* const pieces[] = {
+    " ", " ", "\n", "\t", "x", "id", "_a1", "int", "return", "bool", "0", "7", "12", "0x1F",
+    "0b10", "077", "09", "1.5", "1e", "1e+", "1e5", ".", "..", "...", "0x1.", "0x1.8p3", "p", "e",
+    "'", "1'000", "\"", "\"s\"", "'c'", "\\", "\\\n", "/", "*", "/*", "*/", "//", "#", "#define X 1\n",
+    "+", "=", "+=", "-", ">", "->", "<", "<=", ":", "::", "(", ")", "{", "}", ";", ",",
+    "\xc3", "\xa9", "\xc3\xa9", "\xff", "\xe2\x82", "\xe2\x82\xac", "\xf0\x9f\x98\x80", "R", "u8",
+    "L", "R\"(", ")\"", "R\"x(", ")x\"", "<=>", "->*", ".*",
+};
+#define NPIECES (sizeof(pieces) / sizeof(pieces[0]))
+
+static size_t randomText(char* buf, size_t max)
+{
+    size_t n = 0;
+    for (;;)
+    {
+        const char* p = pieces[rnd(NPIECES)];
+        size_t len = strlen(p);
+        if (n + len > max)
+        {
+            return n;
+        }
+        memcpy(buf + n, p, len);
+        n += len;
+    }
+}
+
+// --- incr ---
+static int sameTokens(const TokenList* a, const TokenList* b, size_t* at)
+{
+    size_t i = 0;
+    for (; i < a->count && i < b->count; i++)
+    {
+        if (a->type[i] != b->type[i] || a->start[i] != b->start[i] || a->length[i] != b->length[i] ||
+            a->line[i] != b->line[i] || a->keyword[i] != b->keyword[i])
+        {
+            break;
+        }
+    }
+    *at = i;
+    return i == a->count && i == b->count;
+}
+
+static void checkIncr(size_t rounds)
+{
+    enum { TEXT_MAX = 96, EDIT_MAX = 12 };
+    char text[TEXT_MAX + 2 * EDIT_MAX], next[sizeof(text)], insert[EDIT_MAX];
+    TokenList list = { 0 }, full = { 0 };
+    TokenDelta delta = { 0 };
+    size_t len = 0;
+    for (size_t r = 0; r < rounds; r++)
+    {
+        if (r % 50 == 0 || len > TEXT_MAX)
+        {
+            len = randomText(text, TEXT_MAX);
+            need(lexText(text, len, (LexerDialect)rnd(DIALECT_COUNT), &list));
+        }
+        // Replace a few bytes (deleted) by a piece or a few random pieces' bytes
+        size_t offset = rnd((uint32_t)len + 1);
+        size_t deleted = rnd(4);
+        if (deleted > len - offset)
+        {
+            deleted = len - offset;
+        }
+        size_t inserted = randomText(insert, 1 + rnd(EDIT_MAX));
+        memcpy(next, text, offset);
+        memcpy(next + offset, insert, inserted);
+        memcpy(next + offset + inserted, text + offset + deleted, len - offset - deleted);
+        size_t newLen = len - deleted + inserted;
+
+        need(relexEdit(&list, next, newLen, offset, deleted, inserted, &delta));
+        need(applyTokenDelta(&list, &delta));
+        need(lexText(next, newLen, list.dialect, &full));
+        size_t at;
+        if (!sameTokens(&list, &full, &at))
+        {
+            if (!reportMismatch())
+            {
+                need(lexText(next, newLen, list.dialect, &list));
+                memcpy(text, next, newLen);
+                len = newLen;
+                continue;
+            }
+            printf("incr: ");
+            printQuoted(text, len);
+            printf(" (dialect %d) with %zu bytes at %zu replaced by ", (int)list.dialect, deleted, offset);
+            printQuoted(insert, inserted);
+            printf(": token %zu is ", at);
+            if (at < list.count)
+            {
+                printf("%s %zu+%zu", getTokenTypeString(list.type[at]), list.start[at], list.length[at]);
+            }
+            else
+            {
+                printf("missing");
+            }
+            printf(" instead of ");
+            if (at < full.count)
+            {
+                printf("%s %zu+%zu\n", getTokenTypeString(full.type[at]), full.start[at], full.length[at]);
+            }
+            else
+            {
+                printf("missing\n");
+            }
+            need(lexText(next, newLen, list.dialect, &list)); // Go on from the right tokens
+        }
+        memcpy(text, next, newLen);
+        len = newLen;
+    }
+    freeTokenList(&list);
+    freeTokenList(&full);
+    freeTokenList(&delta.inserted);
+}
+
+// --- integer ---
+static void checkInteger(size_t rounds)
+{
+    static const char* const suffixes[] = { "", "u", "U", "l", "L", "ul", "lu", "LU", "ll", "LL", "ull", "LLu" };
+    static const int bases[] = { 2, 8, 10, 16 };
+    char text[200], digits[80], spelled[170];
+    for (size_t r = 0; r < rounds; r++)
+    {
+        int base = bases[rnd(4)];
+        // Lengths around the 64-bit limit of each base are the interesting ones
+        int limit = (base == 2) ? 70 : (base == 8) ? 24 : (base == 10) ? 22 : 18;
+        int count = 1 + (int)rnd((uint32_t)(rnd(2) ? limit : 8));
+        for (int i = 0; i < count; i++)
+        {
+            digits[i] = "0123456789abcdefABCDEF"[rnd((base == 16) ? 22 : (uint32_t)base)];
+        }
+        digits[count] = '\0';
+        if (base == 10 && digits[0] == '0' && count > 1)
+        {
+            digits[0] = '1'; // Else it would be octal
+        }
+        int bad = rnd(20) == 0; // A digit the base does not have
+        if (bad)
+        {
+            digits[rnd((uint32_t)count)] = (base == 16) ? 'g' : (char)('0' + base);
+        }
+        const char* prefix = (base == 16) ? (rnd(2) ? "0x" : "0X") : (base == 2) ? (rnd(2) ? "0b" : "0B") : (base == 8) ? "0" : "";
+        if (base == 8 && count == 1 && digits[0] == '0')
+        {
+            prefix = ""; // "00" is octal, but a lone "0" decimal
+        }
+        // Digit separators between some digits; a stray one (doubled or last)
+        // makes the constant ill-formed
+        size_t n = 0;
+        if (base == 8 && prefix[0] != '\0' && rnd(4) == 0)
+        {
+            spelled[n++] = '\''; // The octal prefix's 0 is a digit
+        }
+        int separated = rnd(4) == 0;
+        for (int i = 0; i < count; i++)
+        {
+            spelled[n++] = digits[i];
+            if (separated && i + 1 < count && rnd(3) == 0)
+            {
+                spelled[n++] = '\'';
+            }
+        }
+        int badSeparator = rnd(40) == 0;
+        if (badSeparator)
+        {
+            if (count > 1 && rnd(2))
+            {
+                char last = spelled[n - 1]; // As in 1''2
+                spelled[n - 1] = '\'';
+                spelled[n++] = '\'';
+                spelled[n++] = last;
+            }
+            else
+            {
+                spelled[n++] = '\''; // As in 12'
+            }
+        }
+        spelled[n] = '\0';
+        snprintf(text, sizeof(text), "%s%s%s", prefix, spelled, suffixes[rnd(sizeof(suffixes) / sizeof(suffixes[0]))]);
+
+        int expectBase = (strcmp(prefix, "") == 0) ? 10 : base;
+        errno = 0;
+        char* end;
+        unsigned long long want = strtoull(digits, &end, expectBase);
+        int wantOk = !bad && !badSeparator && *end == '\0';
+        int wantOverflow = (errno == ERANGE);
+
+        IntegerValue got;
+        int ok = decodeIntegerConstant(text, strlen(text), &got);
+        if (ok != wantOk)
+        {
+            if (reportMismatch())
+            {
+                printf("integer: %s %s, expected %s\n", text, ok ? "decoded" : "rejected", wantOk ? "a value" : "a rejection");
+            }
+        }
+        else if (ok && (got.base != expectBase || got.overflow != wantOverflow || (!wantOverflow && got.value != want)))
+        {
+            if (reportMismatch())
+            {
+                printf("integer: %s gave %llu (base %d%s), strtoull %llu%s\n", text, (unsigned long long)got.value, got.base,
+                       got.overflow ? ", overflow" : "", want, wantOverflow ? " (overflow)" : "");
+            }
+        }
+    }
+}
+
+// --- Lexing a random file ---
+typedef struct {
+    TokenType* type;
+    size_t* start;
+    size_t* length;
+    int* line;
+    KeywordId* keyword;
+    size_t count;
+} Tokens;
+
+// Write random text to a temporary file; its path goes in 'path'
+static void writeRandomFile(char* path, size_t size)
+{
+    char* text = checkedAlloc(malloc(size));
+    size = randomText(text, size);
+    strcpy(path, "/tmp/lexer_check_XXXXXX");
+    int fd = mkstemp(path);
+    if (fd < 0 || write(fd, text, size) != (ssize_t)size)
+    {
+        fprintf(stderr, "check: cannot write '%s'\n", path);
+        exit(EXIT_FAILURE);
+    }
+    close(fd);
+    free(text);
+}
+
+// A lexer whose diagnostics go nowhere
+static LexerState* openQuiet(const char* path)
+{
+    static FILE* devNull;
+    if (devNull == NULL)
+    {
+        devNull = checkedAlloc(fopen("/dev/null", "w"));
+    }
+    LexerState* lx = checkedAlloc(createLexer(path));
+    setLexerErrorStream(lx, devNull);
+    return lx;
+}
+
+// Every token of 'path', through nextTokens()
+static Tokens lexFileTokens(const char* path, size_t capacity)
+{
+    Tokens t = { 0 };
+    t.type = checkedAlloc(malloc(capacity * sizeof(TokenType)));
+    t.start = checkedAlloc(malloc(capacity * sizeof(size_t)));
+    t.length = checkedAlloc(malloc(capacity * sizeof(size_t)));
+    t.line = checkedAlloc(malloc(capacity * sizeof(int)));
+    t.keyword = checkedAlloc(malloc(capacity * sizeof(KeywordId)));
+    LexerState* lx = openQuiet(path);
+    for (;;)
+    {
+        TokenBatch batch = { t.type + t.count, t.start + t.count, t.length + t.count, t.line + t.count, NULL,
+                             t.keyword + t.count, NULL, capacity - t.count };
+        size_t n = nextTokens(lx, &batch);
+        if (n == 0)
+        {
+            break;
+        }
+        t.count += n;
+    }
+    destroyLexer(lx);
+    return t;
+}
+
+static void freeTokens(Tokens* t)
+{
+    free(t->type);
+    free(t->start);
+    free(t->length);
+    free(t->line);
+    free(t->keyword);
+}
+
+// --- peek ---
+static void checkPeek(size_t rounds)
+{
+    enum { FILE_SIZE = 1 << 16, MARKS = 8 };
+    for (size_t r = 0; r < rounds; r += 1000)
+    {
+        char path[64];
+        writeRandomFile(path, FILE_SIZE);
+        Tokens want = lexFileTokens(path, FILE_SIZE + 1);
+        LexerState* lx = openQuiet(path);
+        setLexerLookahead(lx, 64);
+        size_t at = 0;
+        size_t markId[MARKS], markAt[MARKS];
+        int marks = 0;
+        for (size_t op = 0; op < 1000 && at <= want.count; op++)
+        {
+            size_t k = rnd(16);
+            switch (rnd(8))
+            {
+                case 0:
+                    if (marks < MARKS)
+                    {
+                        markAt[marks] = at;
+                        markId[marks++] = markTokens(lx);
+                    }
+                    break;
+                case 1:
+                    if (marks > 0)
+                    {
+                        int m = (int)rnd((uint32_t)marks);
+                        rewindTokens(lx, markId[m]);
+                        at = markAt[m];
+                        marks = m;
+                    }
+                    break;
+                case 2:
+                    if (marks > 0)
+                    {
+                        marks = (int)rnd((uint32_t)marks);
+                        unmarkTokens(lx, markId[marks]);
+                    }
+                    break;
+                case 3:
+                case 4:
+                {
+                    const Token* t = peekToken(lx, k);
+                    size_t held = (marks > 0) ? at - markAt[0] : 0;
+                    if (t == NULL)
+                    {
+                        if (k + held < 64)
+                        {
+                            if (reportMismatch())
+                            {
+                                printf("peek: %s: peekToken(%zu) at token %zu returned NULL\n", path, k, at);
+                            }
+                        }
+                        break;
+                    }
+                    size_t i = at + k;
+                    int end = (i >= want.count);
+                    if (end ? (t->type != UNKNOWN || t->length != 0)
+                            : (t->type != want.type[i] || t->offset != want.start[i] || t->length != want.length[i] ||
+                               t->line != want.line[i] || t->keyword != want.keyword[i]))
+                    {
+                        if (reportMismatch())
+                        {
+                            printf("peek: %s: token %zu is %s %zu+%zu, expected %s\n", path, i, getTokenTypeString(t->type),
+                                   t->offset, t->length, end ? "the end" : getTokenTypeString(want.type[i]));
+                        }
+                    }
+                    break;
+                }
+                default:
+                    consumeToken(lx);
+                    at += (at < want.count);
+                    if (marks == 0 && at == want.count)
+                    {
+                        op = 1000;
+                    }
+                    break;
+            }
+        }
+        destroyLexer(lx);
+        freeTokens(&want);
+        unlink(path);
+    }
+}
+
+// --- tokfile ---
+static void checkTokfile(size_t rounds)
+{
+    enum { FILE_SIZE = 1 << 16 };
+    for (size_t r = 0; r < rounds; r += 1000)
+    {
+        char path[64];
+        writeRandomFile(path, FILE_SIZE);
+        Tokens want = lexFileTokens(path, FILE_SIZE + 1);
+
+        char* data = NULL;
+        size_t size = 0;
+        FILE* out = checkedAlloc(open_memstream(&data, &size));
+        TokenWriter w;
+        initTokenWriter(&w, out, 0);
+        writeTokenHeader(&w);
+        beginTokenSection(&w, path);
+        TokenBatch batch = { want.type, want.start, want.length, want.line, NULL, want.keyword, NULL, want.count };
+        writeTokens(&w, &batch, want.count);
+        endTokenSection(&w);
+        if (!finishTokenWriter(&w, NULL) || fclose(out) != 0)
+        {
+            if (reportMismatch())
+            {
+                printf("tokfile: %s: writing failed\n", path);
+            }
+        }
+
+        TokenFile* tf = readTokenFile(data, size);
+        TokenCursor c;
+        FileToken t;
+        size_t i = 0;
+        if (tf == NULL)
+        {
+            if (reportMismatch())
+            {
+                printf("tokfile: %s: the written file is not read back\n", path);
+            }
+        }
+        else
+        {
+            startTokenCursor(tf, &c);
+            if (!nextTokenSection(&c) || strcmp(c.name, path) != 0)
+            {
+                if (reportMismatch())
+                {
+                    printf("tokfile: %s: section missing or misnamed\n", path);
+                }
+            }
+            for (; readFileToken(&c, &t); i++)
+            {
+                if (i >= want.count || t.type != want.type[i] || t.start != want.start[i] || t.length != want.length[i] ||
+                    t.line != want.line[i] || t.keyword != want.keyword[i])
+                {
+                    if (reportMismatch())
+                    {
+                        printf("tokfile: %s: token %zu read back as %s %zu+%zu line %d\n", path, i,
+                               getTokenTypeString(t.type), t.start, t.length, t.line);
+                    }
+                    break;
+                }
+            }
+            if (i != want.count || c.corrupt || nextTokenSection(&c))
+            {
+                if (reportMismatch())
+                {
+                    printf("tokfile: %s: %zu of %zu tokens read back\n", path, i, want.count);
+                }
+            }
+            closeTokenFile(tf);
+        }
+        free(data);
+        freeTokens(&want);
+        unlink(path);
+    }
+}
+
+// --- includes ---
+enum { UNIT_FILES = 8, UNIT_HEADERS = 4 };
+
+typedef struct {
+    char (*paths)[96];
+    HeaderCache* cache;
+    char* out[UNIT_FILES];
+    size_t outLen[UNIT_FILES];
+} UnitRun;
+
+// Random text with a few #include "hN.h" lines in it, for N from 'first'
+// on: a header only includes later ones, so there are no include cycles
+static void writeUnitFile(const char* path, int first)
+{
+    char text[1024];
+    size_t n = 0;
+    for (int part = 0; part < 4; part++)
+    {
+        n += randomText(text + n, 200);
+        if (first < UNIT_HEADERS)
+        {
+            n += (size_t)sprintf(text + n, "\n#include \"h%u.h\"\n", first + (unsigned)rnd((uint32_t)(UNIT_HEADERS - first)));
+        }
+    }
+    FILE* f = fopen(path, "w");
+    if (f == NULL || fwrite(text, 1, n, f) != n || fclose(f) != 0)
+    {
+        fprintf(stderr, "check: cannot write '%s'\n", path);
+        exit(EXIT_FAILURE);
+    }
+}
+
+// The tokens of one translation unit and its diagnostics, as text
+static void lexUnitJob(size_t index, void* arg)
+{
+    UnitRun* run = arg;
+    FILE* out = checkedAlloc(open_memstream(&run->out[index], &run->outLen[index]));
+    LexerState* lx = checkedAlloc(createLexer(run->paths[index]));
+    setLexerErrorStream(lx, out);
+    TranslationUnit* tu = checkedAlloc(openTranslationUnit(run->cache, lx, run->paths[index], out));
+    enum { BATCH = 256 };
+    TokenType type[BATCH];
+    size_t start[BATCH], length[BATCH];
+    TokenBatch batch = { type, start, length, NULL, NULL, NULL, NULL, BATCH };
+    const char* file;
+    LexerState* source;
+    size_t n;
+    while ((n = nextUnitTokens(tu, &batch, &file, &source)) > 0)
+    {
+        for (size_t i = 0; i < n; i++)
+        {
+            fprintf(out, "%s %s %zu+%zu\n", file, getTokenTypeString(type[i]), start[i], length[i]);
+        }
+    }
+    closeTranslationUnit(tu);
+    destroyLexer(lx);
+    fclose(out);
+}
+
+// Everything the units of 'paths' print, in order, when they are lexed on
+// 'threads' threads in the order 'order', then the header cache's report
+static char* lexUnits(char (*paths)[96], const size_t* order, int threads, size_t* len)
+{
+    UnitRun run = { paths, checkedAlloc(createHeaderCache(NULL, -1, -1)), { NULL }, { 0 } };
+    parallelForStealing(order, UNIT_FILES, threads, lexUnitJob, &run);
+    char* all = NULL;
+    FILE* out = checkedAlloc(open_memstream(&all, len));
+    for (int i = 0; i < UNIT_FILES; i++)
+    {
+        fwrite(run.out[i], 1, run.outLen[i], out);
+        free(run.out[i]);
+    }
+    // destroyHeaderCache() reports on stderr
+    FILE* report = checkedAlloc(tmpfile());
+    fflush(stderr);
+    int saved = dup(STDERR_FILENO);
+    dup2(fileno(report), STDERR_FILENO);
+    destroyHeaderCache(run.cache);
+    fflush(stderr);
+    dup2(saved, STDERR_FILENO);
+    close(saved);
+    rewind(report);
+    for (int c; (c = getc(report)) != EOF;)
+    {
+        putc(c, out);
+    }
+    fclose(report);
+    fclose(out);
+    return all;
+}
+
+static void checkIncludes(size_t rounds)
+{
+    for (size_t r = 0; r < rounds; r += 1000)
+    {
+        char dir[] = "/tmp/lexer_check_XXXXXX";
+        char paths[UNIT_FILES + UNIT_HEADERS][96];
+        need(mkdtemp(dir) != NULL);
+        for (int i = 0; i < UNIT_FILES + UNIT_HEADERS; i++)
+        {
+            if (i < UNIT_FILES)
+            {
+                snprintf(paths[i], sizeof(paths[i]), "%s/f%d.c", dir, i);
+            }
+            else
+            {
+                snprintf(paths[i], sizeof(paths[i]), "%s/h%d.h", dir, i - UNIT_FILES);
+            }
+            writeUnitFile(paths[i], (i < UNIT_FILES) ? 0 : i - UNIT_FILES + 1);
+        }
+        size_t inOrder[UNIT_FILES], shuffled[UNIT_FILES];
+        for (size_t i = 0; i < UNIT_FILES; i++)
+        {
+            inOrder[i] = shuffled[i] = i;
+        }
+        for (size_t i = UNIT_FILES - 1; i > 0; i--)
+        {
+            size_t j = rnd((uint32_t)i + 1);
+            size_t t = shuffled[i];
+            shuffled[i] = shuffled[j];
+            shuffled[j] = t;
+        }
+
+        size_t wantLen, gotLen;
+        char* want = lexUnits(paths, inOrder, 1, &wantLen);
+        char* got = lexUnits(paths, shuffled, 4, &gotLen);
+        size_t at = 0;
+        while (at < wantLen && at < gotLen && want[at] == got[at])
+        {
+            at++;
+        }
+        if (at < wantLen || at < gotLen)
+        {
+            if (reportMismatch())
+            {
+                printf("includes: %s: on four threads the output differs at byte %zu: ", dir, at);
+                printQuoted(got + at, (gotLen - at < 60) ? gotLen - at : 60);
+                printf(" instead of ");
+                printQuoted(want + at, (wantLen - at < 60) ? wantLen - at : 60);
+                printf("\n");
+            }
+        }
+        free(want);
+        free(got);
+        for (int i = 0; i < UNIT_FILES + UNIT_HEADERS; i++)
+        {
+            unlink(paths[i]);
+        }
+        rmdir(dir);
+    }
+}
+
+static const struct {
+    const char* name;
+    void (*run)(size_t rounds);
+} checks[] = {
+    { "incr", checkIncr },
+    { "integer", checkInteger },
+    { "peek", checkPeek },
+    { "tokfile", checkTokfile },
+    { "includes", checkIncludes },
+};
+#define NCHECKS (sizeof(checks) / sizeof(checks[0]))
+
+int main(int argc, char* argv[])
+{
+    uint64_t seed = 1;
+    size_t rounds = 200000;
+    int wanted[NCHECKS] = { 0 };
+    int any = 0;
+    for (int i = 1; i < argc; i++)
+    {
+        if (strcmp(argv[i], "--seed") == 0 && i + 1 < argc)
+        {
+            seed = strtoull(argv[++i], NULL, 10);
+            continue;
+        }
+        if (strcmp(argv[i], "--rounds") == 0 && i + 1 < argc)
+        {
+            rounds = strtoull(argv[++i], NULL, 10);
+            continue;
+        }
+        size_t c = 0;
+        while (c < NCHECKS && strcmp(argv[i], checks[c].name) != 0)
+        {
+            c++;
+        }
+        if (c == NCHECKS)
+        {
+            fprintf(stderr, "Usage: %s [--seed N] [--rounds N] [incr|integer|peek|tokfile]...\n", argv[0]);
+            return 1;
+        }
+        wanted[c] = any = 1;
+    }
+
+    int failed = 0;
+    for (size_t c = 0; c < NCHECKS; c++)
+    {
+        if (any && !wanted[c])
+        {
+            continue;
+        }
+        rngState = seed * 0x9E3779B97F4A7C15ULL + c + 1;
+        mismatches = 0;
+        checks[c].run(rounds);
+        printf("%-8s %zu rounds, %zu mismatches\n", checks[c].name, rounds, mismatches);
+        failed |= (mismatches > 0);
+    }
+    return failed;
+}
@@ -0,0 +1,658 @@
+/* DFA generator for the lexer's operators and numbers.
+
+   Reads the token specification (tools/tokens.spec) and, for each dialect,
+   builds an NFA for every pattern of that dialect (Thompson's construction),
+   turns it into a DFA by subset construction over byte classes, minimizes it
+   and writes its tables to lexer_dfa.h / lexer_dfa.c. The lexer then
+   recognizes every operator, punctuator and numeric constant with one
+   table-walking loop and the longest match, the tables fixed at compile
+   time in each dialect's instance of the scanner.
+
+   Regenerate after editing the specification:
+       gcc tools/gen_dfa.c -o gen_dfa && ./gen_dfa tools/tokens.spec . && rm gen_dfa
+*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+#define MAX_NFA 4096
+#define MAX_DFA 256   // State ids are written as uint8_t
+#define MAX_KINDS 32
+#define MAX_LETS 32
+#define MAX_RULES 128
+
+// --- Specification ---
+typedef struct {
+    char name[32];
+    char type[32]; // TokenType it produces
+} Kind;
+
+static Kind kinds[MAX_KINDS];
+static int kindCount;
+
+static struct {
+    char name[32];
+    char* pattern;
+    unsigned dialects; // Mask of the dialects it is defined for
+} lets[MAX_LETS];
+static int letCount;
+
+// Patterns of every dialect, in specification order
+static struct {
+    char* pattern;
+    int kind;
+    unsigned dialects;
+    int line;
+} patterns[MAX_RULES];
+static int patternCount;
+
+// Dialects, in LexerDialect order (lexer.h): the tag that restricts a line
+// of the specification to it, and the suffix of its tables
+static const struct {
+    const char* tag;
+    const char* suffix;
+} dialects[] = {
+    { "@c89", "C89" },
+    { "@c11", "C11" },
+    { "@c23", "C23" },
+    { "@c++", "Cpp" },
+};
+#define NDIALECTS (int)(sizeof(dialects) / sizeof(dialects[0]))
+#define ALL_DIALECTS ((1u << NDIALECTS) - 1)
+
+static unsigned currentDialect; // Bit of the dialect being built
+
+static const char* specPath;
+static int specLine;
+
+static void fail(const char* msg, const char* detail)
+{
+    fprintf(stderr, "gen_dfa: %s:%d: %s%s%s\n", specPath, specLine, msg, detail ? ": " : "", detail ? detail : "");
+    exit(1);
+}
+
+// --- NFA (Thompson's construction) ---
+// A state either moves on a set of bytes to out1, or has up to two empty
+// moves (out1, out2). 'rule' is set on the final state of each pattern.
+typedef struct {
+    int out1, out2;
+    int hasSet;
+    unsigned char set[32];
+    int rule; // Rule index + 1, 0 if not accepting
+} NState;
+
+static NState nfa[MAX_NFA];
+static int nfaCount;
+static int ruleKind[MAX_RULES];
+static int ruleCount;
+
+typedef struct {
+    int start, end;
+} Frag;
+
+static int newState()
+{
+    if (nfaCount == MAX_NFA)
+    {
+        fail("NFA too large", NULL);
+    }
+    NState* s = &nfa[nfaCount];
+    memset(s, 0, sizeof(*s));
+    s->out1 = s->out2 = -1;
+    return nfaCount++;
+}
+
+static void addEmpty(int from, int to)
+{
+    if (nfa[from].out1 < 0) nfa[from].out1 = to;
+    else if (nfa[from].out2 < 0) nfa[from].out2 = to;
+    else fail("internal: state has three moves", NULL);
+}
+
+static Frag byteSet(const unsigned char* set)
+{
+    Frag f = { newState(), newState() };
+    nfa[f.start].hasSet = 1;
+    memcpy(nfa[f.start].set, set, 32);
+    nfa[f.start].out1 = f.end;
+    return f;
+}
+
+static Frag oneByte(unsigned char c)
+{
+    unsigned char set[32] = { 0 };
+    set[c >> 3] |= (unsigned char)(1 << (c & 7));
+    return byteSet(set);
+}
+
+static Frag concat(Frag a, Frag b)
+{
+    addEmpty(a.end, b.start);
+    return (Frag){ a.start, b.end };
+}
+
+static Frag empty()
+{
+    int s = newState();
+    return (Frag){ s, s };
+}
+
+// Recursive descent: alt := seq ('|' seq)*, seq := postfix*, postfix := atom [*+?]
+static Frag parseAlt(const char** p);
+
+static Frag parseAtom(const char** p)
+{
+    const char* s = *p;
+    if (*s == '(')
+    {
+        *p = s + 1;
+        Frag f = parseAlt(p);
+        if (**p != ')')
+        {
+            fail("missing ')'", s);
+        }
+        (*p)++;
+        return f;
+    }
+    if (*s == '"')
+    {
+        Frag f = empty();
+        for (s++; *s != '"'; s++)
+        {
+            if (*s == '\0')
+            {
+                fail("unterminated literal", *p);
+            }
+            f = concat(f, oneByte((unsigned char)*s));
+        }
+        *p = s + 1;
+        return f;
+    }
+    if (*s == '[')
+    {
+        unsigned char set[32] = { 0 };
+        for (s++; *s != ']'; s++)
+        {
+            if (*s == '\0')
+            {
+                fail("unterminated class", *p);
+            }
+            unsigned char lo = (unsigned char)*s, hi = lo;
+            if (s[1] == '-' && s[2] != ']' && s[2] != '\0')
+            {
+                hi = (unsigned char)s[2];
+                s += 2;
+            }
+            for (unsigned c = lo; c <= hi; c++)
+            {
+                set[c >> 3] |= (unsigned char)(1 << (c & 7));
+            }
+        }
+        *p = s + 1;
+        return byteSet(set);
+    }
+    if (*s == '{')
+    {
+        const char* close = strchr(s, '}');
+        if (close == NULL)
+        {
+            fail("missing '}'", s);
+        }
+        for (int i = 0; i < letCount; i++)
+        {
+            if ((lets[i].dialects & currentDialect) && strlen(lets[i].name) == (size_t)(close - s - 1) &&
+                strncmp(lets[i].name, s + 1, close - s - 1) == 0)
+            {
+                const char* q = lets[i].pattern;
+                Frag f = parseAlt(&q);
+                if (*q != '\0')
+                {
+                    fail("trailing text in fragment", lets[i].name);
+                }
+                *p = close + 1;
+                return f;
+            }
+        }
+        fail("unknown fragment", s);
+    }
+    if ((*s >= 'a' && *s <= 'z') || (*s >= 'A' && *s <= 'Z') || (*s >= '0' && *s <= '9') || *s == '_')
+    {
+        *p = s + 1;
+        return oneByte((unsigned char)*s);
+    }
+    fail("unexpected character (quote punctuation)", s);
+    return empty();
+}
+
+static Frag parseSeq(const char** p)
+{
+    Frag f = empty();
+    while (**p != '\0' && **p != '|' && **p != ')')
+    {
+        Frag a = parseAtom(p);
+        char op = **p;
+        if (op == '*' || op == '+' || op == '?')
+        {
+            (*p)++;
+            int e = newState();
+            addEmpty(a.end, e);
+            if (op != '?')
+            {
+                addEmpty(a.end, a.start); // Repeat
+            }
+            if (op != '+')
+            {
+                int s = newState(); // Skip
+                addEmpty(s, a.start);
+                addEmpty(s, e);
+                a.start = s;
+            }
+            a.end = e;
+        }
+        f = concat(f, a);
+    }
+    return f;
+}
+
+static Frag parseAlt(const char** p)
+{
+    Frag f = parseSeq(p);
+    while (**p == '|')
+    {
+        (*p)++;
+        Frag b = parseSeq(p);
+        int s = newState(), e = newState();
+        addEmpty(s, f.start);
+        addEmpty(s, b.start);
+        addEmpty(f.end, e);
+        addEmpty(b.end, e);
+        f = (Frag){ s, e };
+    }
+    return f;
+}
+
+// --- Subset construction ---
+#define SET_WORDS (MAX_NFA / 64)
+
+typedef struct {
+    uint64_t bits[SET_WORDS];
+} StateSet;
+
+static int byteClass[256];
+static int classCount;
+static int classByte[256]; // A representative byte of each class
+
+static StateSet dfaSets[MAX_DFA];
+static int dfaNext[MAX_DFA][256];
+static int dfaKind[MAX_DFA]; // 0: not accepting, else kind index + 1
+static int dfaCount;
+
+static void closure(StateSet* set)
+{
+    int stack[MAX_NFA], top = 0;
+    for (int i = 0; i < nfaCount; i++)
+    {
+        if (set->bits[i >> 6] >> (i & 63) & 1)
+        {
+            stack[top++] = i;
+        }
+    }
+    while (top > 0)
+    {
+        NState* s = &nfa[stack[--top]];
+        if (s->hasSet)
+        {
+            continue;
+        }
+        int outs[2] = { s->out1, s->out2 };
+        for (int k = 0; k < 2; k++)
+        {
+            int o = outs[k];
+            if (o >= 0 && !(set->bits[o >> 6] >> (o & 63) & 1))
+            {
+                set->bits[o >> 6] |= 1ULL << (o & 63);
+                stack[top++] = o;
+            }
+        }
+    }
+}
+
+static int addDfaState(const StateSet* set)
+{
+    for (int i = 0; i < dfaCount; i++)
+    {
+        if (memcmp(&dfaSets[i], set, sizeof(*set)) == 0)
+        {
+            return i;
+        }
+    }
+    if (dfaCount == MAX_DFA)
+    {
+        fail("DFA has more than 256 states", NULL);
+    }
+    dfaSets[dfaCount] = *set;
+    int best = 0;
+    for (int i = 0; i < nfaCount; i++)
+    {
+        if ((set->bits[i >> 6] >> (i & 63) & 1) && nfa[i].rule > 0 && (best == 0 || nfa[i].rule < best))
+        {
+            best = nfa[i].rule;
+        }
+    }
+    dfaKind[dfaCount] = best ? ruleKind[best - 1] + 1 : 0;
+    return dfaCount++;
+}
+
+// Split the 256 byte values into classes that every byte set treats alike
+static void computeClasses()
+{
+    memset(byteClass, 0, sizeof(byteClass));
+    classCount = 1;
+    for (int i = 0; i < nfaCount; i++)
+    {
+        if (!nfa[i].hasSet)
+        {
+            continue;
+        }
+        int remap[256][2];
+        memset(remap, -1, sizeof(remap));
+        int count = 0;
+        for (int b = 0; b < 256; b++)
+        {
+            int in = nfa[i].set[b >> 3] >> (b & 7) & 1;
+            if (remap[byteClass[b]][in] < 0)
+            {
+                remap[byteClass[b]][in] = count++;
+            }
+            byteClass[b] = remap[byteClass[b]][in];
+        }
+        classCount = count;
+    }
+    for (int b = 255; b >= 0; b--)
+    {
+        classByte[byteClass[b]] = b;
+    }
+}
+
+static void buildDfa(int start)
+{
+    StateSet set;
+    memset(&set, 0, sizeof(set));
+    addDfaState(&set); // 0: dead
+    set.bits[start >> 6] |= 1ULL << (start & 63);
+    closure(&set);
+    addDfaState(&set); // 1: start
+    for (int d = 1; d < dfaCount; d++)
+    {
+        for (int c = 0; c < classCount; c++)
+        {
+            int b = classByte[c];
+            StateSet next;
+            memset(&next, 0, sizeof(next));
+            for (int i = 0; i < nfaCount; i++)
+            {
+                if ((dfaSets[d].bits[i >> 6] >> (i & 63) & 1) && nfa[i].hasSet && (nfa[i].set[b >> 3] >> (b & 7) & 1))
+                {
+                    next.bits[nfa[i].out1 >> 6] |= 1ULL << (nfa[i].out1 & 63);
+                }
+            }
+            closure(&next);
+            dfaNext[d][c] = addDfaState(&next);
+        }
+    }
+}
+
+// --- Minimization (Moore): split groups until the moves agree ---
+static int group[MAX_DFA];
+
+static int minimize()
+{
+    int groups = 0;
+    // Start from the accepting kind; the dead state shares group 0 with every
+    // state that can no longer accept anything
+    for (int d = 0; d < dfaCount; d++)
+    {
+        group[d] = dfaKind[d];
+        if (group[d] + 1 > groups) groups = group[d] + 1;
+    }
+    for (;;)
+    {
+        int next[MAX_DFA];
+        int newGroups = 0;
+        for (int d = 0; d < dfaCount; d++)
+        {
+            next[d] = -1;
+            for (int e = 0; e < d; e++)
+            {
+                if (group[e] != group[d]) continue;
+                int same = 1;
+                for (int c = 0; c < classCount && same; c++)
+                {
+                    same = (group[dfaNext[d][c]] == group[dfaNext[e][c]]);
+                }
+                if (same)
+                {
+                    next[d] = next[e];
+                    break;
+                }
+            }
+            if (next[d] < 0) next[d] = newGroups++;
+        }
+        int changed = (newGroups != groups);
+        memcpy(group, next, sizeof(next));
+        groups = newGroups;
+        if (!changed) return groups;
+    }
+}
+
+// --- Output ---
+typedef struct {
+    int states, classes;
+} TableSize;
+
+// Build the DFA of the patterns of currentDialect and write its tables to c
+static TableSize buildDialect(FILE* c, const char* suffix)
+{
+    nfaCount = ruleCount = dfaCount = 0;
+    int start = newState();
+    for (int r = 0; r < patternCount; r++)
+    {
+        if (!(patterns[r].dialects & currentDialect))
+        {
+            continue;
+        }
+        specLine = patterns[r].line;
+        const char* p = patterns[r].pattern;
+        Frag f = parseAlt(&p);
+        if (*p != '\0') fail("unbalanced pattern", patterns[r].pattern);
+        if (f.start == f.end && !nfa[f.start].hasSet && nfa[f.start].out1 < 0) fail("empty pattern", patterns[r].pattern);
+        ruleKind[ruleCount] = patterns[r].kind;
+        nfa[f.end].rule = ++ruleCount;
+        // Chain the pattern onto the start state
+        if (nfa[start].out2 >= 0)
+        {
+            int s = newState();
+            nfa[s].out1 = nfa[start].out1;
+            nfa[s].out2 = nfa[start].out2;
+            nfa[start].out1 = s;
+            nfa[start].out2 = -1;
+        }
+        addEmpty(start, f.start);
+    }
+
+    computeClasses();
+    buildDfa(start);
+    int states = minimize();
+
+    // Renumber so that the dead state is 0 and the start state 1
+    int id[MAX_DFA], rep[MAX_DFA], used = 0;
+    for (int g = 0; g < states; g++) id[g] = -1;
+    int order[2] = { group[0], group[1] };
+    for (int i = 0; i < 2; i++)
+    {
+        if (id[order[i]] < 0) { id[order[i]] = used; rep[used++] = (i == 0) ? 0 : 1; }
+    }
+    for (int d = 0; d < dfaCount; d++)
+    {
+        if (id[group[d]] < 0) { id[group[d]] = used; rep[used++] = d; }
+    }
+    if (id[group[1]] == 0)
+    {
+        fprintf(stderr, "gen_dfa: the specification accepts nothing in %s\n", suffix);
+        exit(1);
+    }
+
+    fprintf(c, "\n// %s\n", suffix);
+    fprintf(c, "const uint8_t dfaByteClass%s[256] = {", suffix);
+    for (int b = 0; b < 256; b++) fprintf(c, "%s%2d", (b % 16) ? ", " : (b ? ",\n    " : "\n    "), byteClass[b]);
+    fprintf(c, "\n};\n\n");
+    fprintf(c, "const uint8_t dfaNext%s[DFA_STATES_%s][DFA_CLASSES_%s] = {\n", suffix, suffix, suffix);
+    for (int s = 0; s < used; s++)
+    {
+        fprintf(c, "    {");
+        for (int k = 0; k < classCount; k++) fprintf(c, "%s%3d", k ? "," : "", id[group[dfaNext[rep[s]][k]]]);
+        fprintf(c, " },\n");
+    }
+    fprintf(c, "};\n\n");
+    fprintf(c, "const uint8_t dfaAccept%s[DFA_STATES_%s] = {", suffix, suffix);
+    for (int s = 0; s < used; s++)
+    {
+        int k = dfaKind[rep[s]];
+        fprintf(c, "%s%s", (s % 4) ? ", " : (s ? ",\n    " : "\n    "), k ? "DFA_" : "DFA_NONE");
+        if (k) fprintf(c, "%s", kinds[k - 1].name);
+    }
+    fprintf(c, "\n};\n");
+    return (TableSize){ used, classCount };
+}
+
+// The dialect tags among words[0..*n), removed; all dialects if there are none
+static unsigned takeDialectTags(char** words, int* n)
+{
+    unsigned mask = 0;
+    int kept = 0;
+    for (int i = 0; i < *n; i++)
+    {
+        if (words[i][0] != '@')
+        {
+            words[kept++] = words[i];
+            continue;
+        }
+        int d = 0;
+        while (d < NDIALECTS && strcmp(words[i], dialects[d].tag) != 0) d++;
+        if (d == NDIALECTS) fail("unknown dialect", words[i]);
+        mask |= 1u << d;
+    }
+    *n = kept;
+    return mask ? mask : ALL_DIALECTS;
+}
+
+int main(int argc, char* argv[])
+{
+    specPath = (argc > 1) ? argv[1] : "tools/tokens.spec";
+    const char* dir = (argc > 2) ? argv[2] : ".";
+    FILE* spec = fopen(specPath, "r");
+    if (spec == NULL)
+    {
+        fprintf(stderr, "gen_dfa: cannot read '%s'\n", specPath);
+        return 1;
+    }
+
+    char line[1024];
+    while (fgets(line, sizeof(line), spec) != NULL)
+    {
+        specLine++;
+        char* words[64];
+        int n = 0;
+        for (char* w = strtok(line, " \t\r\n"); w != NULL && n < 64; w = strtok(NULL, " \t\r\n"))
+        {
+            if (w[0] == '#') break;
+            words[n++] = w;
+        }
+        unsigned mask = takeDialectTags(words, &n);
+        if (n == 0) continue;
+        if (strcmp(words[0], "let") == 0)
+        {
+            if (n != 3 || letCount == MAX_LETS) fail("expected: let NAME pattern", NULL);
+            for (int i = 0; i < letCount; i++)
+            {
+                if (strcmp(lets[i].name, words[1]) == 0 && (lets[i].dialects & mask)) fail("fragment defined twice for a dialect", words[1]);
+            }
+            snprintf(lets[letCount].name, sizeof(lets[letCount].name), "%s", words[1]);
+            lets[letCount].dialects = mask;
+            lets[letCount++].pattern = strdup(words[2]);
+            continue;
+        }
+        if (n < 3) fail("expected: KIND TYPE pattern...", NULL);
+        int k = 0;
+        while (k < kindCount && strcmp(kinds[k].name, words[0]) != 0) k++;
+        if (k == kindCount)
+        {
+            if (kindCount == MAX_KINDS) fail("too many kinds", NULL);
+            snprintf(kinds[k].name, sizeof(kinds[k].name), "%s", words[0]);
+            snprintf(kinds[k].type, sizeof(kinds[k].type), "%s", words[1]);
+            kindCount++;
+        }
+        else if (strcmp(kinds[k].type, words[1]) != 0)
+        {
+            fail("kind given two token types", words[0]);
+        }
+        for (int i = 2; i < n; i++)
+        {
+            if (patternCount == MAX_RULES) fail("too many patterns", NULL);
+            patterns[patternCount].pattern = strdup(words[i]);
+            patterns[patternCount].kind = k;
+            patterns[patternCount].dialects = mask;
+            patterns[patternCount++].line = specLine;
+        }
+    }
+    fclose(spec);
+
+    char path[1024];
+    snprintf(path, sizeof(path), "%s/lexer_dfa.h", dir);
+    FILE* h = fopen(path, "w");
+    snprintf(path, sizeof(path), "%s/lexer_dfa.c", dir);
+    FILE* c = fopen(path, "w");
+    if (h == NULL || c == NULL)
+    {
+        fprintf(stderr, "gen_dfa: cannot write to '%s'\n", dir);
+        return 1;
+    }
+
+    fprintf(c, "// Generated by tools/gen_dfa.c from tools/tokens.spec -- do not edit.\n");
+    fprintf(c, "#include \"lexer_dfa.h\"\n\n");
+    fprintf(c, "const TokenType dfaKindType[DFA_KIND_COUNT] = {\n    UNKNOWN,\n");
+    for (int k = 0; k < kindCount; k++) fprintf(c, "    %s, // DFA_%s\n", kinds[k].type, kinds[k].name);
+    fprintf(c, "};\n");
+    TableSize sizes[NDIALECTS];
+    for (int d = 0; d < NDIALECTS; d++)
+    {
+        currentDialect = 1u << d;
+        sizes[d] = buildDialect(c, dialects[d].suffix);
+    }
+
+    fprintf(h, "// Generated by tools/gen_dfa.c from tools/tokens.spec -- do not edit.\n");
+    fprintf(h, "#ifndef LEXER_DFA_H\n#define LEXER_DFA_H\n\n#include <stdint.h>\n#include \"lexer.h\"\n\n");
+    fprintf(h, "// Token kinds: what the longest match ending in an accepting state is\n");
+    fprintf(h, "typedef enum {\n    DFA_NONE = 0,\n");
+    for (int k = 0; k < kindCount; k++) fprintf(h, "    DFA_%s,\n", kinds[k].name);
+    fprintf(h, "    DFA_KIND_COUNT\n} DfaKind;\n\n");
+    fprintf(h, "#define DFA_DEAD 0    // No token can continue from here\n");
+    fprintf(h, "#define DFA_START 1\n\n");
+    fprintf(h, "extern const TokenType dfaKindType[DFA_KIND_COUNT];\n\n");
+    fprintf(h, "// One DFA per dialect: byte -> input class, state x class -> state, and the\n");
+    fprintf(h, "// DfaKind a state accepts (DFA_NONE if none)\n");
+    for (int d = 0; d < NDIALECTS; d++)
+    {
+        const char* x = dialects[d].suffix;
+        fprintf(h, "#define DFA_STATES_%s %d\n", x, sizes[d].states);
+        fprintf(h, "#define DFA_CLASSES_%s %d\n", x, sizes[d].classes);
+        fprintf(h, "extern const uint8_t dfaByteClass%s[256];\n", x);
+        fprintf(h, "extern const uint8_t dfaNext%s[DFA_STATES_%s][DFA_CLASSES_%s];\n", x, x, x);
+        fprintf(h, "extern const uint8_t dfaAccept%s[DFA_STATES_%s];\n%s", x, x, (d + 1 < NDIALECTS) ? "\n" : "");
+    }
+    fprintf(h, "\n#endif\n");
+    fclose(h);
+    fclose(c);
+    return 0;
+}
@@ -0,0 +1,315 @@
+/* Keyword table generator for the lexer.
+
+   Builds a minimal perfect hash over the keywords of each dialect and writes
+   keywords.h / keywords.c: one KeywordId per keyword of any dialect, and
+   one lookup function per dialect that only knows that dialect's keywords.
+   Each keyword is hashed only by its length and its first, middle and last
+   characters, so a lookup costs one hash, one table read and at most one
+   memcmp.
+
+   Regenerate after editing the list below:
+       gcc tools/gen_keywords.c -o gen_keywords && ./gen_keywords . && rm gen_keywords
+*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+// Dialects, in LexerDialect order (lexer.h); each gets a lookupKeyword<name>()
+static const char* const dialectNames[] = { "C89", "C11", "C23", "Cpp" };
+#define NDIALECTS (sizeof(dialectNames) / sizeof(dialectNames[0]))
+#define DEFAULT_DIALECT 2 // lookupKeyword() looks up C23's keywords
+
+#define C89 (1u << 0)
+#define C11 (1u << 1)
+#define C23 (1u << 2)
+#define CPP (1u << 3)
+
+// Keyword list, in KeywordId order, by the dialects that have them. The id
+// is the upper-cased spelling with a KW_ prefix, so "_Bool" becomes KW__BOOL
+// and "bool" becomes KW_BOOL. New keywords go at the end: ids are written
+// to token files.
+typedef struct {
+    unsigned dialects;
+    const char* words[64]; // Up to a NULL
+} KeywordGroup;
+
+static const KeywordGroup keywordGroups[] = {
+    // C89
+    { C89 | C11 | C23 | CPP,
+      { "auto", "break", "case", "char", "const", "continue", "default", "do",
+        "double", "else", "enum", "extern", "float", "for", "goto", "if",
+        "int", "long", "register", "return", "short", "signed", "sizeof", "static",
+        "struct", "switch", "typedef", "union", "unsigned", "void", "volatile", "while", NULL } },
+    // C99
+    { C11 | C23 | CPP, { "inline", NULL } },
+    { C11 | C23, { "restrict", "_Bool", "_Complex", "_Imaginary", NULL } },
+    // C11
+    { C11 | C23, { "_Alignas", "_Alignof", "_Atomic", "_Generic", "_Noreturn", "_Static_assert", "_Thread_local", NULL } },
+    // C23
+    { C23 | CPP,
+      { "alignas", "alignof", "bool", "constexpr", "false", "nullptr", "static_assert",
+        "thread_local", "true", NULL } },
+    { C23, { "typeof", "typeof_unqual", "_BitInt", "_Decimal32", "_Decimal64", "_Decimal128", NULL } },
+    // C++ (C++20), the alternative spellings of operators included
+    { CPP,
+      { "and", "and_eq", "asm", "bitand", "bitor", "catch", "char8_t", "char16_t",
+        "char32_t", "class", "compl", "concept", "consteval", "constinit", "const_cast", "co_await",
+        "co_return", "co_yield", "decltype", "delete", "dynamic_cast", "explicit", "export", "friend",
+        "mutable", "namespace", "new", "noexcept", "not", "not_eq", "operator", "or",
+        "or_eq", "private", "protected", "public", "reinterpret_cast", "requires", "static_cast", "template",
+        "this", "throw", "try", "typeid", "typename", "using", "virtual", "wchar_t",
+        "xor", "xor_eq", NULL } },
+};
+
+#define MAX_KEYWORDS 256 // Ids are written as uint8_t
+#define NGROUPS (sizeof(keywordGroups) / sizeof(keywordGroups[0]))
+
+static const char* keywordList[MAX_KEYWORDS];
+static unsigned keywordDialects[MAX_KEYWORDS];
+static size_t keywordCount;
+
+// The hash signature: length, first, last and middle character
+static uint32_t signature(const char* s, size_t len)
+{
+    return (uint32_t)len | ((uint32_t)(unsigned char)s[0] << 8) | ((uint32_t)(unsigned char)s[len - 1] << 16) |
+           ((uint32_t)(unsigned char)s[len / 2] << 24);
+}
+
+// Same mixing function as emitted into keywords.c
+static uint32_t mix(uint32_t x)
+{
+    x ^= x >> 15;
+    x *= 0x2c1b3c6dU;
+    x ^= x >> 12;
+    x *= 0x297a2d39U;
+    x ^= x >> 15;
+    return x;
+}
+
+static void keywordEnumName(const char* kw, char* out)
+{
+    strcpy(out, "KW_");
+    out += 3;
+    for (const char* p = kw; *p; p++)
+    {
+        *out++ = (*p >= 'a' && *p <= 'z') ? (char)(*p - 'a' + 'A') : *p;
+    }
+    *out = '\0';
+}
+
+// The perfect hash of one dialect: 'count' keywords, which own the slots of
+// slotOwner[0..count) after buildHash()
+typedef struct {
+    size_t keys[MAX_KEYWORDS]; // Indexes into keywordList
+    size_t count;
+    uint32_t sig[MAX_KEYWORDS];
+    int buckets;               // A power of two
+    uint16_t disp[MAX_KEYWORDS];
+    int slotOwner[MAX_KEYWORDS];
+    size_t maxLen;
+} DialectHash;
+
+static int buildHash(DialectHash* t, unsigned dialect, const char* name)
+{
+    int bucketOf[MAX_KEYWORDS];
+    t->count = 0;
+    t->maxLen = 0;
+    for (size_t k = 0; k < keywordCount; k++)
+    {
+        if (!(keywordDialects[k] & dialect))
+        {
+            continue;
+        }
+        size_t i = t->count++;
+        size_t len = strlen(keywordList[k]);
+        t->keys[i] = k;
+        t->sig[i] = signature(keywordList[k], len);
+        t->slotOwner[i] = -1;
+        if (len > t->maxLen) t->maxLen = len;
+        for (size_t j = 0; j < i; j++)
+        {
+            if (t->sig[i] == t->sig[j])
+            {
+                fprintf(stderr, "gen_keywords: %s: '%s' and '%s' share length, first, middle and last character\n", name, keywordList[k], keywordList[t->keys[j]]);
+                return 0;
+            }
+        }
+    }
+    t->buckets = 8;
+    while ((size_t)t->buckets * 2 < t->count) t->buckets *= 2;
+    for (size_t i = 0; i < t->count; i++) bucketOf[i] = (int)(mix(t->sig[i]) & (uint32_t)(t->buckets - 1));
+
+    // Hash-and-displace: place the fullest buckets first, giving each one
+    // the smallest displacement that sends all its keys to free slots.
+    int order[MAX_KEYWORDS];
+    int size[MAX_KEYWORDS] = {0};
+    for (size_t i = 0; i < t->count; i++) size[bucketOf[i]]++;
+    for (int b = 0; b < t->buckets; b++) order[b] = b;
+    for (int a = 0; a < t->buckets; a++)
+        for (int b = a + 1; b < t->buckets; b++)
+            if (size[order[b]] > size[order[a]]) { int x = order[a]; order[a] = order[b]; order[b] = x; }
+
+    memset(t->disp, 0, sizeof(t->disp));
+    for (int o = 0; o < t->buckets; o++)
+    {
+        int b = order[o];
+        if (size[b] == 0) break;
+        uint32_t d;
+        for (d = 1; d < 65536; d++)
+        {
+            int slots[MAX_KEYWORDS];
+            int n = 0, ok = 1;
+            for (size_t i = 0; i < t->count && ok; i++)
+            {
+                if (bucketOf[i] != b) continue;
+                int s = (int)(mix(t->sig[i] ^ (d * 0x9e3779b9U)) % t->count);
+                if (t->slotOwner[s] >= 0) ok = 0;
+                for (int k = 0; k < n; k++) if (slots[k] == s) ok = 0;
+                slots[n++] = s;
+            }
+            if (!ok) continue;
+            n = 0;
+            for (size_t i = 0; i < t->count; i++)
+                if (bucketOf[i] == b) t->slotOwner[slots[n++]] = (int)i;
+            break;
+        }
+        if (d == 65536)
+        {
+            fprintf(stderr, "gen_keywords: %s: no displacement found for bucket %d\n", name, b);
+            return 0;
+        }
+        t->disp[b] = (uint16_t)d;
+    }
+    return 1;
+}
+
+int main(int argc, char* argv[])
+{
+    const char* dir = (argc > 1) ? argv[1] : ".";
+    for (size_t g = 0; g < NGROUPS; g++)
+    {
+        for (const char* const* w = keywordGroups[g].words; *w != NULL; w++)
+        {
+            if (keywordCount == MAX_KEYWORDS || strlen(*w) < 2)
+            {
+                fprintf(stderr, "gen_keywords: too many keywords, or '%s' is shorter than 2\n", *w);
+                return 1;
+            }
+            keywordList[keywordCount] = *w;
+            keywordDialects[keywordCount++] = keywordGroups[g].dialects;
+        }
+    }
+    static DialectHash hashes[NDIALECTS];
+    for (size_t d = 0; d < NDIALECTS; d++)
+    {
+        if (!buildHash(&hashes[d], 1u << d, dialectNames[d]))
+        {
+            return 1;
+        }
+    }
+
+    char path[1024], name[64];
+    snprintf(path, sizeof(path), "%s/keywords.h", dir);
+    FILE* h = fopen(path, "w");
+    snprintf(path, sizeof(path), "%s/keywords.c", dir);
+    FILE* c = fopen(path, "w");
+    if (h == NULL || c == NULL)
+    {
+        fprintf(stderr, "gen_keywords: cannot write to '%s'\n", dir);
+        return 1;
+    }
+
+    fprintf(h, "// Generated by tools/gen_keywords.c -- do not edit.\n");
+    fprintf(h, "#ifndef KEYWORDS_H\n#define KEYWORDS_H\n\n#include <stddef.h>\n\n");
+    fprintf(h, "// The keywords of every dialect\n");
+    fprintf(h, "typedef enum {\n    KW_NONE = 0,\n");
+    for (size_t i = 0; i < keywordCount; i++)
+    {
+        keywordEnumName(keywordList[i], name);
+        fprintf(h, "    %s,\n", name);
+    }
+    fprintf(h, "    KW_COUNT\n} KeywordId;\n\n");
+    fprintf(h, "#define KEYWORD_COUNT %zu\n\n", keywordCount);
+    fprintf(h, "// Keyword id of str[0..len) in one dialect (see LexerDialect in lexer.h), or\n");
+    fprintf(h, "// KW_NONE if it is not one of that dialect's keywords\n");
+    for (size_t d = 0; d < NDIALECTS; d++)
+    {
+        fprintf(h, "KeywordId lookupKeyword%s(const char* str, size_t len);\n", dialectNames[d]);
+    }
+    fprintf(h, "// The same in the default dialect, %s\n", dialectNames[DEFAULT_DIALECT]);
+    fprintf(h, "KeywordId lookupKeyword(const char* str, size_t len);\n");
+    fprintf(h, "// Spelling of a keyword id (\"\" for KW_NONE)\n");
+    fprintf(h, "const char* getKeywordString(KeywordId id);\n\n#endif\n");
+
+    fprintf(c, "// Generated by tools/gen_keywords.c -- do not edit.\n");
+    fprintf(c, "#include <stdint.h>\n#include <string.h>\n#include \"keywords.h\"\n\n");
+    fprintf(c, "static const char* const keywordNames[KW_COUNT] = {\n    \"\",\n");
+    for (size_t i = 0; i < keywordCount; i++) fprintf(c, "    \"%s\",\n", keywordList[i]);
+    fprintf(c, "};\n\n");
+    fprintf(c, "// Slot -> keyword: signature for the cheap check, then the id\n");
+    fprintf(c, "typedef struct {\n    uint32_t sig;\n    uint8_t id;\n} KeywordSlot;\n\n");
+    fprintf(c,
+        "static uint32_t keywordMix(uint32_t x)\n"
+        "{\n"
+        "    x ^= x >> 15;\n"
+        "    x *= 0x2c1b3c6dU;\n"
+        "    x ^= x >> 12;\n"
+        "    x *= 0x297a2d39U;\n"
+        "    x ^= x >> 15;\n"
+        "    return x;\n"
+        "}\n\n"
+        "// Look str[0..len) up in one dialect's tables: a displacement per bucket,\n"
+        "// then 'slotCount' slots\n"
+        "static inline KeywordId findKeyword(const uint16_t* disp, uint32_t bucketMask, const KeywordSlot* slots,\n"
+        "                                    uint32_t slotCount, size_t maxLen, const char* str, size_t len)\n"
+        "{\n"
+        "    if (len < 2 || len > maxLen)\n"
+        "    {\n"
+        "        return KW_NONE;\n"
+        "    }\n"
+        "    uint32_t sig = (uint32_t)len | ((uint32_t)(unsigned char)str[0] << 8) | ((uint32_t)(unsigned char)str[len - 1] << 16) |\n"
+        "                   ((uint32_t)(unsigned char)str[len / 2] << 24);\n"
+        "    uint32_t d = disp[keywordMix(sig) & bucketMask];\n"
+        "    uint32_t slot = keywordMix(sig ^ (d * 0x9e3779b9U)) %% slotCount;\n"
+        "    if (slots[slot].sig != sig)\n"
+        "    {\n"
+        "        return KW_NONE;\n"
+        "    }\n"
+        "    KeywordId id = (KeywordId)slots[slot].id;\n"
+        "    return memcmp(str, keywordNames[id], len) == 0 ? id : KW_NONE;\n"
+        "}\n");
+    for (size_t d = 0; d < NDIALECTS; d++)
+    {
+        const DialectHash* t = &hashes[d];
+        const char* dn = dialectNames[d];
+        fprintf(c, "\n// %s: %zu keywords\n", dn, t->count);
+        fprintf(c, "static const uint16_t keywordDisp%s[%d] = {", dn, t->buckets);
+        for (int b = 0; b < t->buckets; b++) fprintf(c, "%s%u", (b == 0) ? "\n    " : (b % 8) ? ", " : ",\n    ", t->disp[b]);
+        fprintf(c, "\n};\n\n");
+        fprintf(c, "static const KeywordSlot keywordSlots%s[%zu] = {\n", dn, t->count);
+        for (size_t s = 0; s < t->count; s++)
+        {
+            size_t i = (size_t)t->slotOwner[s];
+            keywordEnumName(keywordList[t->keys[i]], name);
+            fprintf(c, "    { 0x%08xu, %s },\n", t->sig[i], name);
+        }
+        fprintf(c, "};\n\n");
+        fprintf(c, "KeywordId lookupKeyword%s(const char* str, size_t len)\n{\n", dn);
+        fprintf(c, "    return findKeyword(keywordDisp%s, %d, keywordSlots%s, %zu, %zu, str, len);\n}\n", dn, t->buckets - 1, dn, t->count, t->maxLen);
+    }
+    fprintf(c,
+        "\nKeywordId lookupKeyword(const char* str, size_t len)\n"
+        "{\n"
+        "    return lookupKeyword%s(str, len);\n"
+        "}\n\n"
+        "const char* getKeywordString(KeywordId id)\n"
+        "{\n"
+        "    return ((unsigned)id < KW_COUNT) ? keywordNames[id] : \"\";\n"
+        "}\n",
+        dialectNames[DEFAULT_DIALECT]);
+
+    fclose(h);
+    fclose(c);
+    return 0;
+}
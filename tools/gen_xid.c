@@ -0,0 +1,194 @@
+/* Identifier character table generator for the lexer.
+
+   Reads DerivedCoreProperties.txt from the Unicode Character Database and
+   writes lexer_xid.h / lexer_xid.c: the XID_Start and XID_Continue code
+   points past ASCII as sorted ranges. C23 identifiers (UAX #31) start with
+   '_' or an XID_Start character and go on with XID_Continue characters;
+   the lexer handles ASCII with its class table and looks up the rest here.
+
+   Regenerate for a new Unicode version:
+       gcc tools/gen_xid.c -o gen_xid && ./gen_xid DerivedCoreProperties.txt . && rm gen_xid
+*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+#define CODE_POINTS 0x110000
+#define MAX_RANGES 4096
+
+typedef struct {
+    const char* name;
+    uint8_t* has; // One byte per code point
+    uint32_t ranges[MAX_RANGES][2];
+    int count;
+} Property;
+
+static Property properties[] = {
+    { "XID_Start", NULL, { { 0 } }, 0 },
+    { "XID_Continue", NULL, { { 0 } }, 0 },
+};
+#define NPROPERTIES (sizeof(properties) / sizeof(properties[0]))
+
+static char version[64] = "unknown";
+
+// "0041..005A    ; XID_Start # ..." or "00AA          ; XID_Start # ..."
+static void readProperties(FILE* in)
+{
+    char line[1024];
+    while (fgets(line, sizeof(line), in) != NULL)
+    {
+        const char* v = strstr(line, "DerivedCoreProperties-");
+        if (line[0] == '#' && v != NULL && strcmp(version, "unknown") == 0)
+        {
+            v += strlen("DerivedCoreProperties-");
+            size_t n = strcspn(v, "t \r\n");
+            n = (n > 0 && v[n - 1] == '.') ? n - 1 : n; // Drop the '.' of ".txt"
+            snprintf(version, sizeof(version), "%.*s", (int)n, v);
+            continue;
+        }
+        char* hash = strchr(line, '#');
+        if (hash != NULL)
+        {
+            *hash = '\0';
+        }
+        char* semi = strchr(line, ';');
+        if (semi == NULL)
+        {
+            continue;
+        }
+        char name[64];
+        if (sscanf(semi + 1, " %63s", name) != 1)
+        {
+            continue;
+        }
+        char* rest;
+        unsigned long first = strtoul(line, &rest, 16);
+        unsigned long last = first;
+        if (rest[0] == '.' && rest[1] == '.')
+        {
+            last = strtoul(rest + 2, NULL, 16);
+        }
+        if (last >= CODE_POINTS || first > last)
+        {
+            fprintf(stderr, "gen_xid: bad range in line: %s\n", line);
+            exit(EXIT_FAILURE);
+        }
+        for (size_t i = 0; i < NPROPERTIES; i++)
+        {
+            if (strcmp(name, properties[i].name) == 0)
+            {
+                memset(properties[i].has + first, 1, last - first + 1);
+            }
+        }
+    }
+}
+
+// Collect the runs of code points from 0x80 on
+static void buildRanges(Property* p)
+{
+    for (uint32_t c = 0x80; c < CODE_POINTS; c++)
+    {
+        if (!p->has[c])
+        {
+            continue;
+        }
+        if (p->count > 0 && p->ranges[p->count - 1][1] == c - 1)
+        {
+            p->ranges[p->count - 1][1] = c;
+            continue;
+        }
+        if (p->count == MAX_RANGES)
+        {
+            fprintf(stderr, "gen_xid: more than %d ranges of %s\n", MAX_RANGES, p->name);
+            exit(EXIT_FAILURE);
+        }
+        p->ranges[p->count][0] = p->ranges[p->count][1] = c;
+        p->count++;
+    }
+}
+
+static FILE* openOutput(const char* dir, const char* name)
+{
+    char path[4096];
+    snprintf(path, sizeof(path), "%s/%s", dir, name);
+    FILE* f = fopen(path, "w");
+    if (f == NULL)
+    {
+        perror(path);
+        exit(EXIT_FAILURE);
+    }
+    return f;
+}
+
+static void writeHeader(const char* dir)
+{
+    FILE* f = openOutput(dir, "lexer_xid.h");
+    fprintf(f, "// Generated by tools/gen_xid.c from DerivedCoreProperties.txt -- do not edit.\n");
+    fprintf(f, "#ifndef LEXER_XID_H\n#define LEXER_XID_H\n\n#include <stdint.h>\n\n");
+    fprintf(f, "// Unicode %s identifier characters past ASCII, as sorted inclusive\n", version);
+    fprintf(f, "// ranges of code points\n");
+    for (size_t i = 0; i < NPROPERTIES; i++)
+    {
+        fprintf(f, "#define XID_%s_RANGES %d\n", (i == 0) ? "START" : "CONTINUE", properties[i].count);
+    }
+    fprintf(f, "\nextern const uint32_t xidStartRanges[XID_START_RANGES][2];\n");
+    fprintf(f, "extern const uint32_t xidContinueRanges[XID_CONTINUE_RANGES][2];\n\n#endif\n");
+    fclose(f);
+}
+
+static void writeSource(const char* dir)
+{
+    FILE* f = openOutput(dir, "lexer_xid.c");
+    fprintf(f, "// Generated by tools/gen_xid.c from DerivedCoreProperties.txt -- do not edit.\n");
+    fprintf(f, "#include \"lexer_xid.h\"\n");
+    for (size_t i = 0; i < NPROPERTIES; i++)
+    {
+        Property* p = &properties[i];
+        fprintf(f, "\nconst uint32_t xid%sRanges[XID_%s_RANGES][2] = {\n", (i == 0) ? "Start" : "Continue", (i == 0) ? "START" : "CONTINUE");
+        for (int r = 0; r < p->count; r++)
+        {
+            fprintf(f, "%s{ 0x%05X, 0x%05X },", (r % 4 == 0) ? "    " : " ", p->ranges[r][0], p->ranges[r][1]);
+            if (r % 4 == 3 || r == p->count - 1)
+            {
+                fprintf(f, "\n");
+            }
+        }
+        fprintf(f, "};\n");
+    }
+    fclose(f);
+}
+
+int main(int argc, char** argv)
+{
+    if (argc != 3)
+    {
+        fprintf(stderr, "usage: %s DerivedCoreProperties.txt OUTDIR\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+    FILE* in = fopen(argv[1], "r");
+    if (in == NULL)
+    {
+        perror(argv[1]);
+        return EXIT_FAILURE;
+    }
+    for (size_t i = 0; i < NPROPERTIES; i++)
+    {
+        properties[i].has = calloc(CODE_POINTS, 1);
+        if (properties[i].has == NULL)
+        {
+            fprintf(stderr, "gen_xid: out of memory\n");
+            return EXIT_FAILURE;
+        }
+    }
+    readProperties(in);
+    fclose(in);
+    for (size_t i = 0; i < NPROPERTIES; i++)
+    {
+        buildRanges(&properties[i]);
+    }
+    writeHeader(argv[2]);
+    writeSource(argv[2]);
+    printf("Unicode %s: %d XID_Start and %d XID_Continue ranges\n", version, properties[0].count, properties[1].count);
+    return EXIT_SUCCESS;
+}
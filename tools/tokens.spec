@@ -0,0 +1,52 @@
+# Operators, punctuation and numbers: the token specification that
+# tools/gen_dfa.c compiles into the lexer's DFA (lexer_dfa.h / lexer_dfa.c).
+#
+#   let NAME pattern         a named fragment, used as {NAME}
+#   KIND TYPE pattern...     patterns of token kind DFA_KIND, of TokenType TYPE
+#
+# A line may end in dialect tags (@c89 @c11 @c23 @c++) to hold only in those
+# dialects; a line without tags holds in all of them. Each dialect gets its
+# own DFA, and a fragment may be defined once per dialect.
+#
+# Patterns: "literal" text, [a-z] byte classes, ( | ) groups, * + ? and
+# {NAME}; other letters and digits stand for themselves. No spaces inside a
+# pattern. The lexer takes the longest match; between matches of the same
+# length the earlier line wins. Kinds whose TYPE is INVALID_NUMBER are
+# ill-formed numbers, reported by the lexer.
+
+# Digit separators (1'000'000) came with C23 and C++14
+let SEP     ""                    @c89 @c11
+let SEP     "'"?                  @c23 @c++
+let DIGITS  [0-9]({SEP}[0-9])*
+let HEX     [0-9a-fA-F]
+let HEXDIGITS {HEX}({SEP}{HEX})*
+let ISUFFIX ([uU][lL]?|[lL][uU]?)  @c89
+let ISUFFIX ([uU]([lL]|"ll"|"LL")?|([lL]|"ll"|"LL")[uU]?)  @c11 @c23 @c++
+let EXP     [eE][+-]?{DIGITS}
+let FSUFFIX [fFlL]
+
+# Punctuation: the full C operator set (digraphs excepted); '#' starts a
+# preprocessor line before the DFA is reached. C23 took "::" for attribute
+# names from C++.
+OPERATOR OPERATOR  "." "->" "++" "--" "&" "*" "+" "-" "~" "!" "/" "%"
+OPERATOR OPERATOR  "<<" ">>" "<" ">" "<=" ">=" "==" "!=" "^" "|" "&&" "||"
+OPERATOR OPERATOR  "?" ":" "=" "*=" "/=" "%=" "+=" "-=" "<<=" ">>=" "&=" "^=" "|=" "..."
+OPERATOR OPERATOR  "::"                     @c23 @c++
+OPERATOR OPERATOR  ".*" "->*" "<=>"         @c++
+SYMBOL   SYMBOL    "(" ")" "[" "]" "{" "}" ";" ","
+
+# Integer constants. A lone 0 counts as decimal.
+DECIMAL  INTEGRAL_CONSTANT  (0|[1-9]({SEP}[0-9])*){ISUFFIX}?
+OCTAL    INTEGRAL_CONSTANT  0({SEP}[0-7])+{ISUFFIX}?
+HEX      INTEGRAL_CONSTANT  0[xX]{HEXDIGITS}{ISUFFIX}?
+BINARY   INTEGRAL_CONSTANT  0[bB][01]({SEP}[01])*{ISUFFIX}?   @c23 @c++
+
+# Floating constants, decimal and hexadecimal (C99 on)
+FLOAT    FLOATING_CONSTANT  ({DIGITS}"."{DIGITS}?|"."{DIGITS}){EXP}?{FSUFFIX}? {DIGITS}{EXP}{FSUFFIX}?
+HEXFLOAT FLOATING_CONSTANT  0[xX]({HEXDIGITS}"."?{HEXDIGITS}?|"."{HEXDIGITS})[pP][+-]?{DIGITS}{FSUFFIX}?  @c11 @c23 @c++
+
+# Ill-formed numbers: a prefix without digits, an octal constant up to its
+# first 8 or 9
+HEX_EMPTY    INVALID_NUMBER  0[xX]
+BINARY_EMPTY INVALID_NUMBER  0[bB]                      @c23 @c++
+OCTAL_DIGIT  INVALID_NUMBER  0({SEP}[0-7])*{SEP}[89]